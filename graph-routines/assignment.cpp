@@ -0,0 +1,184 @@
+/**assignment.cpp
+ *
+ * Minimum cost assignment of a dense cost matrix by the Hungarian method
+ * with potentials.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "assignment.hpp"
+
+// Hungarian method on an n x m matrix with n <= m; returns the column
+// of every row
+std::vector<int> Assignment::solve(const std::vector<double> &cost, int n, int m)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    // Potentials u of rows and v of columns keep reduced costs
+    // cost - u - v non-negative. Column 0 is a virtual column whose row
+    // is the one being inserted; rows and columns are 1-based here.
+    std::vector<double> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+    std::vector<int> p(m + 1, 0), way(m + 1, 0);
+    std::vector<char> used(m + 1);
+
+    for (int i = 1; i <= n; i++)
+    {
+        // Dijkstra over columns on reduced costs until a free column is
+        // reached, then flip the alternating path back to column 0
+        p[0] = i;
+        int j0 = 0;
+        std::fill(minv.begin(), minv.end(), INF);
+        std::fill(used.begin(), used.end(), 0);
+        do
+        {
+            used[j0] = 1;
+            int i0 = p[j0], j1 = 0;
+            double delta = INF;
+            const double *costRow = cost.data() + static_cast<size_t>(i0 - 1) * m;
+            for (int j = 1; j <= m; j++)
+            {
+                if (used[j])
+                    continue;
+                double reduced = costRow[j - 1] - u[i0] - v[j];
+                if (reduced < minv[j])
+                {
+                    minv[j] = reduced;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta)
+                {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= m; j++)
+            {
+                if (used[j])
+                {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                    minv[j] -= delta;
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+
+        do
+        {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    std::vector<int> match(n, -1);
+    for (int j = 1; j <= m; j++)
+        if (p[j] != 0)
+            match[p[j] - 1] = j - 1;
+    return match;
+}
+
+/*!
+ * @function Assignment
+ * @abstract Construct Assignment-type object based on a cost matrix
+ *           and find an optimal assignment.
+ * @param cost cost[i][j] is the cost of assigning row i to column j
+ * @param maximize find the assignment of maximum total instead
+ * @exception throws std::invalid_argument if the rows have different
+ *            lengths or some cost is not finite
+ */
+Assignment::Assignment(const std::vector<std::vector<double>> &cost, bool maximize)
+    : rows(cost.size()), cols(cost.empty() ? 0 : cost[0].size()), total(0)
+{
+    for (const std::vector<double> &line : cost)
+    {
+        if (static_cast<int>(line.size()) != cols)
+            throw std::invalid_argument("Assignment: rows of the cost matrix differ in length");
+        for (double c : line)
+            if (!std::isfinite(c))
+                throw std::invalid_argument("Assignment: cost " + std::to_string(c) + " is not finite");
+    }
+    rowToCol.assign(rows, -1);
+    colToRow.assign(cols, -1);
+    if (rows == 0 || cols == 0)
+        return;
+
+    // Solve with the shorter side as rows
+    bool transpose = rows > cols;
+    int n = transpose ? cols : rows, m = transpose ? rows : cols;
+    std::vector<double> flat(static_cast<size_t>(n) * m);
+    double sign = maximize ? -1 : 1;
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            flat[transpose ? static_cast<size_t>(j) * m + i : static_cast<size_t>(i) * m + j] = sign * cost[i][j];
+
+    std::vector<int> match = solve(flat, n, m);
+    for (int k = 0; k < n; k++)
+    {
+        int i = transpose ? match[k] : k, j = transpose ? k : match[k];
+        rowToCol[i] = j;
+        colToRow[j] = i;
+        total += cost[i][j];
+    }
+}
+
+/*!
+ * @function Assignment
+ * @abstract Copy constructor for Assignment-type object.
+ * @param other another Assignment-type object
+ */
+Assignment::Assignment(const Assignment &other)
+    : rows(other.rows), cols(other.cols), rowToCol(other.rowToCol), colToRow(other.colToRow),
+      total(other.total) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for Assignment-type object.
+ * @param other another Assignment-type object
+ */
+Assignment &Assignment::operator=(const Assignment &other)
+{
+    Assignment newCopy(other);
+    std::swap(this->rows, newCopy.rows);
+    std::swap(this->cols, newCopy.cols);
+    std::swap(this->rowToCol, newCopy.rowToCol);
+    std::swap(this->colToRow, newCopy.colToRow);
+    std::swap(this->total, newCopy.total);
+    return *this;
+}
+
+// Return the total cost of the assignment
+double Assignment::cost() const { return total; }
+
+/*!
+ * @function column
+ * @abstract Returns the column assigned to row i
+ * @param i the queried row
+ * @return the column, -1 if the row is unassigned
+ * @exception throws std::out_of_range if i is not a row
+ */
+int Assignment::column(int i) const
+{
+    if (i < 0 || i >= rows)
+        throw std::out_of_range("Assignment: row " + std::to_string(i) + " does not exist");
+    return rowToCol[i];
+}
+
+/*!
+ * @function row
+ * @abstract Returns the row assigned to column j
+ * @param j the queried column
+ * @return the row, -1 if the column is unassigned
+ * @exception throws std::out_of_range if j is not a column
+ */
+int Assignment::row(int j) const
+{
+    if (j < 0 || j >= cols)
+        throw std::out_of_range("Assignment: column " + std::to_string(j) + " does not exist");
+    return colToRow[j];
+}
@@ -0,0 +1,81 @@
+/**assignment.hpp
+ *
+ * The assignment problem asks for a matching of rows to columns of a cost
+ * matrix that covers every row (or every column, if there are fewer) and
+ * has minimum total cost. It is the weighted matching problem of a
+ * complete bipartite graph, and suits dense instances where most pairs
+ * of workers and jobs are possible.
+ *
+ * This routine runs the Hungarian method in its shortest augmenting path
+ * form with row and column potentials, adding one row at a time in
+ * O(n^2 m) time for n rows and m >= n columns. The matrix is copied into
+ * one contiguous row-major array, transposed if it has more rows than
+ * columns.
+ */
+
+#ifndef ASSIGNMENT
+#define ASSIGNMENT
+
+#include <vector>
+
+class Assignment
+{
+private:
+    int rows, cols;
+    std::vector<int> rowToCol;
+    std::vector<int> colToRow;
+    double total;
+
+    // Hungarian method on an n x m matrix with n <= m; returns the column
+    // of every row
+    static std::vector<int> solve(const std::vector<double> &cost, int n, int m);
+
+public:
+    /*!
+     * @function Assignment
+     * @abstract Construct Assignment-type object based on a cost matrix
+     *           and find an optimal assignment.
+     * @param cost cost[i][j] is the cost of assigning row i to column j
+     * @param maximize find the assignment of maximum total instead
+     * @exception throws std::invalid_argument if the rows have different
+     *            lengths or some cost is not finite
+     */
+    Assignment(const std::vector<std::vector<double>> &cost, bool maximize = false);
+
+    /*!
+     * @function Assignment
+     * @abstract Copy constructor for Assignment-type object.
+     * @param other another Assignment-type object
+     */
+    Assignment(const Assignment &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for Assignment-type object.
+     * @param other another Assignment-type object
+     */
+    Assignment &operator=(const Assignment &other);
+
+    // Return the total cost of the assignment
+    double cost() const;
+
+    /*!
+     * @function column
+     * @abstract Returns the column assigned to row i
+     * @param i the queried row
+     * @return the column, -1 if the row is unassigned
+     * @exception throws std::out_of_range if i is not a row
+     */
+    int column(int i) const;
+
+    /*!
+     * @function row
+     * @abstract Returns the row assigned to column j
+     * @param j the queried column
+     * @return the row, -1 if the column is unassigned
+     * @exception throws std::out_of_range if j is not a column
+     */
+    int row(int j) const;
+};
+
+#endif /*ASSIGNMENT*/
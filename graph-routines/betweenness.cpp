@@ -0,0 +1,275 @@
+/**betweenness.cpp
+ *
+ * The betweenness centrality of a vertex v is the sum, over all ordered
+ * pairs of other vertices (s, t), of the fraction of shortest s-t paths
+ * that pass through v. On an undirected Graph every unordered pair is
+ * counted once.
+ *
+ * This routine runs Brandes' algorithm with sources distributed across
+ * threads, optionally on a uniform sample of sources.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "betweenness.hpp"
+#include "utils/parallel.hpp"
+
+static const double UNREACHED = std::numeric_limits<double>::infinity();
+
+// Per-thread search state and partial scores
+struct Betweenness::Workspace
+{
+    std::vector<double> dist;
+    std::vector<double> sigma;
+    std::vector<double> delta;
+    std::vector<double> score;
+    std::vector<int> order;
+    std::vector<std::pair<double, int>> heap;
+
+    Workspace(int V) : dist(V, UNREACHED), sigma(V, 0), delta(V, 0), score(V, 0) {}
+};
+
+// Single-source search and dependency accumulation into ws
+void Betweenness::accumulate(int s, bool weighted, Workspace &ws) const
+{
+    std::vector<double> &dist = ws.dist;
+    std::vector<double> &sigma = ws.sigma;
+    std::vector<double> &delta = ws.delta;
+    std::vector<int> &order = ws.order;
+    order.clear();
+    dist[s] = 0;
+    sigma[s] = 1;
+
+    // Settle vertices in nondecreasing distance; order doubles as the BFS queue
+    if (!weighted)
+    {
+        order.push_back(s);
+        for (size_t head = 0; head < order.size(); head++)
+        {
+            int v = order[head];
+            for (size_t e = g.begin(v); e < g.end(v); e++)
+            {
+                int w = g.target(e);
+                if (dist[w] == UNREACHED)
+                {
+                    dist[w] = dist[v] + 1;
+                    order.push_back(w);
+                }
+                if (dist[w] == dist[v] + 1)
+                    sigma[w] += sigma[v];
+            }
+        }
+    }
+    else
+    {
+        // Lazy-deletion binary heap; stale entries have a larger distance
+        std::vector<std::pair<double, int>> &heap = ws.heap;
+        std::greater<std::pair<double, int>> later;
+        heap.assign(1, {0.0, s});
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            double d = heap.back().first;
+            int v = heap.back().second;
+            heap.pop_back();
+            if (d > dist[v])
+                continue;
+            order.push_back(v);
+            for (size_t e = g.begin(v); e < g.end(v); e++)
+            {
+                int w = g.target(e);
+                double alt = dist[v] + g.weight(e);
+                if (alt < dist[w])
+                {
+                    dist[w] = alt;
+                    sigma[w] = sigma[v];
+                    heap.push_back({alt, w});
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+                else if (alt == dist[w])
+                    sigma[w] += sigma[v];
+            }
+        }
+    }
+
+    // Backward sweep: an edge v -> w is on a shortest path exactly when
+    // it realizes dist[w], recomputed the same way as during the search
+    for (size_t i = order.size(); i-- > 0;)
+    {
+        int v = order[i];
+        for (size_t e = g.begin(v); e < g.end(v); e++)
+        {
+            int w = g.target(e);
+            double length = weighted ? g.weight(e) : 1;
+            if (dist[w] == dist[v] + length)
+                delta[v] += sigma[v] / sigma[w] * (1 + delta[w]);
+        }
+        if (v != s)
+            ws.score[v] += delta[v];
+    }
+
+    // Reset only what this search touched
+    for (int v : order)
+    {
+        dist[v] = UNREACHED;
+        sigma[v] = 0;
+        delta[v] = 0;
+    }
+}
+
+// Compute betweenness from the given sources, scaled by scale
+void Betweenness::brandes(const std::vector<int> &sources, bool weighted, double scale, int numThreads)
+{
+    int V = g.V();
+    numThreads = std::max(1, std::min<int>(numThreads, sources.size()));
+    std::vector<Workspace> workspaces(numThreads, Workspace(V));
+
+    parallelFor(0, sources.size(), [&](size_t i, int t)
+                { accumulate(sources[i], weighted, workspaces[t]); },
+                numThreads, 1);
+
+    scores.assign(V, 0);
+    parallelFor(0, V, [&](size_t v, int)
+                {
+                    double sum = 0;
+                    for (const Workspace &ws : workspaces)
+                        sum += ws.score[v];
+                    scores[v] = sum * scale; },
+                numThreads);
+}
+
+/*!
+ * @function Betweenness
+ * @abstract Construct Betweenness-type object based on a directed graph.
+ * @param target directed graph used as input
+ * @param weighted use edge weights as lengths instead of hop counts
+ * @param samples number of sampled sources, 0 or at least V computes
+ *                exact scores from every source
+ * @param seed seed for choosing the sampled sources
+ * @param useParallel search from multiple sources at once
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if weighted and some edge
+ *            weight is not positive
+ */
+Betweenness::Betweenness(const DiGraph &target, bool weighted, int samples, unsigned int seed,
+                         bool useParallel, int numThreads)
+    : g(target), pairFactor(1)
+{
+    int V = g.V();
+    if (weighted)
+        for (double w : g.getWeights())
+            if (!(w > 0))
+                throw std::invalid_argument("Betweenness: edge weight " + std::to_string(w) + " is not positive");
+
+    // Partial Fisher-Yates shuffle picks distinct sources uniformly
+    std::vector<int> sources(V);
+    std::iota(sources.begin(), sources.end(), 0);
+    sampleCount = samples <= 0 || samples >= V ? V : samples;
+    if (sampleCount < V)
+    {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < sampleCount; i++)
+            std::swap(sources[i], sources[std::uniform_int_distribution<int>(i, V - 1)(rng)]);
+        sources.resize(sampleCount);
+    }
+
+    double scale = sampleCount == 0 ? 1 : static_cast<double>(V) / sampleCount;
+    brandes(sources, weighted, scale, useParallel ? resolveThreads(numThreads) : 1);
+}
+
+/*!
+ * @function Betweenness
+ * @abstract Construct Betweenness-type object based on an undirected
+ *           graph, counting each unordered pair of endpoints once.
+ *           Parameters are the same as for directed graphs.
+ */
+Betweenness::Betweenness(const Graph &target, bool weighted, int samples, unsigned int seed,
+                         bool useParallel, int numThreads)
+    : Betweenness(static_cast<const DiGraph &>(target), weighted, samples, seed, useParallel, numThreads)
+{
+    // Both directions of every pair were counted
+    pairFactor = 0.5;
+    for (double &score : scores)
+        score *= pairFactor;
+}
+
+/*!
+ * @function Betweenness
+ * @abstract Copy constructor for Betweenness-type object.
+ * @param other another Betweenness-type object
+ */
+Betweenness::Betweenness(const Betweenness &other)
+    : g(other.g), scores(other.scores), sampleCount(other.sampleCount), pairFactor(other.pairFactor) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for Betweenness-type object.
+ * @param other another Betweenness-type object
+ */
+Betweenness &Betweenness::operator=(const Betweenness &other)
+{
+    Betweenness newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->scores, newCopy.scores);
+    std::swap(this->sampleCount, newCopy.sampleCount);
+    std::swap(this->pairFactor, newCopy.pairFactor);
+    return *this;
+}
+
+/*!
+ * @function centrality
+ * @abstract Returns the (estimated) betweenness centrality of v
+ * @param v the queried vertex
+ * @return betweenness of v
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+double Betweenness::centrality(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Betweenness: vertex " + std::to_string(v) + " is not in graph");
+    return scores[g.index(v)];
+}
+
+/*!
+ * @function centralities
+ * @abstract Returns all scores ordered as in DiGraph::getVertices()
+ * @return betweenness of every vertex
+ */
+const std::vector<double> &Betweenness::centralities() const { return scores; }
+
+// Return number of sources searched
+int Betweenness::samples() const { return sampleCount; }
+
+// Check if every vertex was used as a source
+bool Betweenness::isExact() const { return sampleCount == static_cast<int>(g.V()); }
+
+/*!
+ * @function errorBound
+ * @abstract Returns an absolute error that all sampled estimates stay
+ *           within at the same time with probability 1 - delta
+ * @param delta allowed failure probability in (0, 1)
+ * @return error bound, 0 for exact scores
+ * @exception throws std::invalid_argument if delta is not in (0, 1)
+ */
+double Betweenness::errorBound(double delta) const
+{
+    if (!(delta > 0 && delta < 1))
+        throw std::invalid_argument("Betweenness: delta " + std::to_string(delta) + " is not in (0, 1)");
+    if (isExact())
+        return 0;
+
+    // Each sampled dependency lies in [0, V - 2]; Hoeffding with a union
+    // bound over all V vertices
+    double V = g.V();
+    double epsilon = std::sqrt(std::log(2 * V / delta) / (2 * sampleCount));
+    return epsilon * V * (V - 2) * pairFactor;
+}
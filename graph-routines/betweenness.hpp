@@ -0,0 +1,119 @@
+/**betweenness.hpp
+ *
+ * The betweenness centrality of a vertex v is the sum, over all ordered
+ * pairs of other vertices (s, t), of the fraction of shortest s-t paths
+ * that pass through v. On an undirected Graph every unordered pair is
+ * counted once.
+ *
+ * This routine runs Brandes' algorithm: one BFS (or Dijkstra search for
+ * weighted graphs) per source followed by a backward sweep that
+ * accumulates pair dependencies, for O(VE) time on unweighted graphs.
+ * Sources are distributed across threads, each thread accumulating into
+ * its own score array that is summed at the end.
+ *
+ * In the sampled mode only k uniformly chosen sources are searched and
+ * the result is scaled by V / k, which is an unbiased estimate. By
+ * Hoeffding's inequality all estimates are simultaneously within
+ * errorBound(delta) of the exact scores with probability 1 - delta.
+ */
+
+#ifndef BETWEENNESS
+#define BETWEENNESS
+
+#include <vector>
+#include "graph/digraph.hpp"
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class Betweenness
+{
+private:
+    // Per-thread search state and partial scores
+    struct Workspace;
+
+    CompactDiGraph g;
+    std::vector<double> scores;
+    int sampleCount;
+    double pairFactor;
+
+    // Compute betweenness from the given sources, scaled by scale
+    void brandes(const std::vector<int> &sources, bool weighted, double scale, int numThreads);
+
+    // Single-source search and dependency accumulation into ws
+    void accumulate(int s, bool weighted, Workspace &ws) const;
+
+public:
+    /*!
+     * @function Betweenness
+     * @abstract Construct Betweenness-type object based on a directed graph.
+     * @param target directed graph used as input
+     * @param weighted use edge weights as lengths instead of hop counts
+     * @param samples number of sampled sources, 0 or at least V computes
+     *                exact scores from every source
+     * @param seed seed for choosing the sampled sources
+     * @param useParallel search from multiple sources at once
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if weighted and some edge
+     *            weight is not positive
+     */
+    Betweenness(const DiGraph &target, bool weighted = false, int samples = 0, unsigned int seed = 0,
+                bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function Betweenness
+     * @abstract Construct Betweenness-type object based on an undirected
+     *           graph, counting each unordered pair of endpoints once.
+     *           Parameters are the same as for directed graphs.
+     */
+    Betweenness(const Graph &target, bool weighted = false, int samples = 0, unsigned int seed = 0,
+                bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function Betweenness
+     * @abstract Copy constructor for Betweenness-type object.
+     * @param other another Betweenness-type object
+     */
+    Betweenness(const Betweenness &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for Betweenness-type object.
+     * @param other another Betweenness-type object
+     */
+    Betweenness &operator=(const Betweenness &other);
+
+    /*!
+     * @function centrality
+     * @abstract Returns the (estimated) betweenness centrality of v
+     * @param v the queried vertex
+     * @return betweenness of v
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    double centrality(int v) const;
+
+    /*!
+     * @function centralities
+     * @abstract Returns all scores ordered as in DiGraph::getVertices()
+     * @return betweenness of every vertex
+     */
+    const std::vector<double> &centralities() const;
+
+    // Return number of sources searched
+    int samples() const;
+
+    // Check if every vertex was used as a source
+    bool isExact() const;
+
+    /*!
+     * @function errorBound
+     * @abstract Returns an absolute error that all sampled estimates stay
+     *           within at the same time with probability 1 - delta
+     * @param delta allowed failure probability in (0, 1)
+     * @return error bound, 0 for exact scores
+     * @exception throws std::invalid_argument if delta is not in (0, 1)
+     */
+    double errorBound(double delta = 0.05) const;
+};
+
+#endif /*BETWEENNESS*/
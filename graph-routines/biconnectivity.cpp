@@ -0,0 +1,225 @@
+/**biconnectivity.cpp
+ *
+ * Articulation points, bridges, blocks and the block-cut tree of an
+ * undirected graph by an iterative low-link depth-first search.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "biconnectivity.hpp"
+
+// Iterative low-link DFS over every component
+void Biconnectivity::lowLink()
+{
+    int V = g.V();
+    std::vector<int> disc(V, -1), low(V), parent(V, -1), stack, stamp(V, -1);
+    // parentEdge[v] is the position of the tree edge parent[v] -> v
+    std::vector<size_t> cur(V), parentEdge(V);
+    std::vector<std::pair<int, int>> edgeStack;
+    int time = 0;
+    blockStart.assign(1, 0);
+
+    // Pop the edges of the block closed by tree edge (p, u)
+    auto closeBlock = [&](int p, int u)
+    {
+        int b = blockStart.size() - 1;
+        std::pair<int, int> top;
+        do
+        {
+            top = edgeStack.back();
+            edgeStack.pop_back();
+            for (int x : {top.first, top.second})
+            {
+                if (stamp[x] != b)
+                {
+                    stamp[x] = b;
+                    blockMembers.push_back(x);
+                }
+            }
+        } while (top.first != p || top.second != u);
+        blockStart.push_back(blockMembers.size());
+    };
+
+    for (int root = 0; root < V; root++)
+    {
+        if (disc[root] != -1)
+            continue;
+        disc[root] = low[root] = time++;
+        cur[root] = g.begin(root);
+        stack.assign(1, root);
+        int rootChildren = 0;
+
+        while (!stack.empty())
+        {
+            int u = stack.back();
+            if (cur[u] < g.end(u))
+            {
+                size_t e = cur[u]++;
+                int v = g.target(e);
+                if (v == u)
+                    continue;
+                if (disc[v] == -1)
+                {
+                    // Tree edge
+                    parent[v] = u;
+                    parentEdge[v] = e;
+                    disc[v] = low[v] = time++;
+                    cur[v] = g.begin(v);
+                    edgeStack.push_back({u, v});
+                    stack.push_back(v);
+                    rootChildren += u == root;
+                }
+                else if (v != parent[u] && disc[v] < disc[u])
+                {
+                    // Back edge to an ancestor
+                    low[u] = std::min(low[u], disc[v]);
+                    edgeStack.push_back({u, v});
+                }
+                continue;
+            }
+
+            // u is finished; report to its parent
+            stack.pop_back();
+            int p = parent[u];
+            if (p == -1)
+                continue;
+            low[p] = std::min(low[p], low[u]);
+            if (low[u] >= disc[p])
+            {
+                if (p != root)
+                    isCut[p] = 1;
+                closeBlock(p, u);
+            }
+            if (low[u] > disc[p])
+                bridgeEdges.emplace_back(g.id(p), g.id(u), g.weight(parentEdge[u]));
+        }
+
+        if (rootChildren >= 2)
+            isCut[root] = 1;
+        if (rootChildren == 0)
+        {
+            blockMembers.push_back(root);
+            blockStart.push_back(blockMembers.size());
+        }
+    }
+
+    for (int v = 0; v < V; v++)
+        if (isCut[v])
+            cutVertices.push_back(g.id(v));
+}
+
+/*!
+ * @function Biconnectivity
+ * @abstract Construct Biconnectivity-type object based on an
+ *           undirected graph. Self-loops are ignored.
+ * @param target undirected graph used as input
+ */
+Biconnectivity::Biconnectivity(const Graph &target)
+    : g(target), isCut(g.V(), 0)
+{
+    lowLink();
+}
+
+/*!
+ * @function Biconnectivity
+ * @abstract Copy constructor for Biconnectivity-type object.
+ * @param other another Biconnectivity-type object
+ */
+Biconnectivity::Biconnectivity(const Biconnectivity &other)
+    : g(other.g), isCut(other.isCut), cutVertices(other.cutVertices), bridgeEdges(other.bridgeEdges),
+      blockStart(other.blockStart), blockMembers(other.blockMembers) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for Biconnectivity-type object.
+ * @param other another Biconnectivity-type object
+ */
+Biconnectivity &Biconnectivity::operator=(const Biconnectivity &other)
+{
+    Biconnectivity newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->isCut, newCopy.isCut);
+    std::swap(this->cutVertices, newCopy.cutVertices);
+    std::swap(this->bridgeEdges, newCopy.bridgeEdges);
+    std::swap(this->blockStart, newCopy.blockStart);
+    std::swap(this->blockMembers, newCopy.blockMembers);
+    return *this;
+}
+
+/*!
+ * @function isArticulationPoint
+ * @abstract Checks if removing v disconnects its component
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+bool Biconnectivity::isArticulationPoint(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Biconnectivity: vertex " + std::to_string(v) + " is not in graph");
+    return isCut[g.index(v)];
+}
+
+/*!
+ * @function articulationPoints
+ * @abstract Returns all articulation points ordered as in
+ *           Graph::getVertices()
+ * @return articulation points
+ */
+const std::vector<int> &Biconnectivity::articulationPoints() const { return cutVertices; }
+
+/*!
+ * @function bridges
+ * @abstract Returns all bridges, each once from the vertex discovered
+ *           first by the search
+ * @return bridges with their weights
+ */
+const std::vector<Edge> &Biconnectivity::bridges() const { return bridgeEdges; }
+
+// Return number of blocks; an isolated vertex forms a block of its own
+int Biconnectivity::blockCount() const { return blockStart.size() - 1; }
+
+/*!
+ * @function block
+ * @abstract Returns the vertices of a block
+ * @param b the block, in [0, blockCount())
+ * @return vertices of the block in no particular order
+ * @exception throws std::out_of_range if b is not a block
+ */
+std::vector<int> Biconnectivity::block(int b) const
+{
+    if (b < 0 || b >= blockCount())
+        throw std::out_of_range("Biconnectivity: block " + std::to_string(b) + " does not exist");
+    std::vector<int> members;
+    members.reserve(blockStart[b + 1] - blockStart[b]);
+    for (size_t i = blockStart[b]; i < blockStart[b + 1]; i++)
+        members.push_back(g.id(blockMembers[i]));
+    return members;
+}
+
+/*!
+ * @function blockCutTree
+ * @abstract Returns the block-cut forest, with one vertex per block
+ *           and one per articulation point. Block b is vertex b, and
+ *           the k-th vertex of articulationPoints() is vertex
+ *           blockCount() + k.
+ * @return forest joining every block to its articulation points
+ */
+Graph Biconnectivity::blockCutTree() const
+{
+    int B = blockCount();
+    std::vector<int> cutNode(g.V(), -1);
+    int k = 0;
+    for (int v = 0; v < static_cast<int>(g.V()); v++)
+        if (isCut[v])
+            cutNode[v] = B + k++;
+
+    Graph tree(B + k);
+    for (int b = 0; b < B; b++)
+        for (size_t i = blockStart[b]; i < blockStart[b + 1]; i++)
+            if (cutNode[blockMembers[i]] != -1)
+                tree.insertEdge(b, cutNode[blockMembers[i]]);
+    return tree;
+}
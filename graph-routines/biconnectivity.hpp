@@ -0,0 +1,110 @@
+/**biconnectivity.hpp
+ *
+ * An articulation point of an undirected graph is a vertex whose removal
+ * disconnects its component, and a bridge is an edge whose removal does.
+ * The blocks (biconnected components) are the maximal subgraphs without
+ * articulation points; they share only articulation points, and every
+ * edge belongs to exactly one block. Joining each block to the
+ * articulation points it contains gives the block-cut tree.
+ *
+ * This routine finds all of them in one depth-first search that tracks
+ * for every vertex the earliest discovery time reachable through its
+ * subtree and one back edge (low-link). The search runs over dense arrays
+ * with an explicit stack of vertices and per-vertex current-edge
+ * positions, so deep graphs cannot overflow the call stack; edges are
+ * kept on a second stack and popped as a block once it is closed.
+ */
+
+#ifndef BICONNECTIVITY
+#define BICONNECTIVITY
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class Biconnectivity
+{
+private:
+    CompactDiGraph g;
+    std::vector<char> isCut;
+    std::vector<int> cutVertices;
+    std::vector<Edge> bridgeEdges;
+    // Vertices of block b are blockMembers[blockStart[b]] to
+    // blockMembers[blockStart[b + 1] - 1]
+    std::vector<size_t> blockStart;
+    std::vector<int> blockMembers;
+
+    // Iterative low-link DFS over every component
+    void lowLink();
+
+public:
+    /*!
+     * @function Biconnectivity
+     * @abstract Construct Biconnectivity-type object based on an
+     *           undirected graph. Self-loops are ignored.
+     * @param target undirected graph used as input
+     */
+    Biconnectivity(const Graph &target);
+
+    /*!
+     * @function Biconnectivity
+     * @abstract Copy constructor for Biconnectivity-type object.
+     * @param other another Biconnectivity-type object
+     */
+    Biconnectivity(const Biconnectivity &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for Biconnectivity-type object.
+     * @param other another Biconnectivity-type object
+     */
+    Biconnectivity &operator=(const Biconnectivity &other);
+
+    /*!
+     * @function isArticulationPoint
+     * @abstract Checks if removing v disconnects its component
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    bool isArticulationPoint(int v) const;
+
+    /*!
+     * @function articulationPoints
+     * @abstract Returns all articulation points ordered as in
+     *           Graph::getVertices()
+     * @return articulation points
+     */
+    const std::vector<int> &articulationPoints() const;
+
+    /*!
+     * @function bridges
+     * @abstract Returns all bridges, each once from the vertex discovered
+     *           first by the search
+     * @return bridges with their weights
+     */
+    const std::vector<Edge> &bridges() const;
+
+    // Return number of blocks; an isolated vertex forms a block of its own
+    int blockCount() const;
+
+    /*!
+     * @function block
+     * @abstract Returns the vertices of a block
+     * @param b the block, in [0, blockCount())
+     * @return vertices of the block in no particular order
+     * @exception throws std::out_of_range if b is not a block
+     */
+    std::vector<int> block(int b) const;
+
+    /*!
+     * @function blockCutTree
+     * @abstract Returns the block-cut forest, with one vertex per block
+     *           and one per articulation point. Block b is vertex b, and
+     *           the k-th vertex of articulationPoints() is vertex
+     *           blockCount() + k.
+     * @return forest joining every block to its articulation points
+     */
+    Graph blockCutTree() const;
+};
+
+#endif /*BICONNECTIVITY*/
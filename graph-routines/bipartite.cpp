@@ -3,80 +3,147 @@
  * A bipartite graph is a graph where all vertices can be divided into two disjoint sets
  * such that no two graph vertices within the same set are adjacent.
  *
- * This routine returns the two partitions as iterable data types.
+ * This routine 2-colors the graph by breadth-first search over a dense
+ * color array indexed by CompactDiGraph positions, and returns the two
+ * partitions as vectors built once at construction. The parallel mode
+ * expands each BFS level with multiple threads. A graph is bipartite
+ * exactly when it has no odd cycle, and one such cycle is returned as a
+ * witness when the check fails.
  */
 
 #include <string>
-#include <deque>
-#include <set>
-#include <unordered_map>
+#include <atomic>
 #include <stdexcept>
 #include <algorithm>
 #include <utility>
 
 #include "bipartite.hpp"
-#include "graph/graph.hpp"
-#include "graph/digraph.hpp"
+#include "utils/parallel.hpp"
 
-// BFS to check if the graph is bipartite starting from one source
-bool Bipartite::bfsFromSrc(const Graph &g, int src)
+// Color states; a vertex is discovered exactly when its color is non-zero
+static const unsigned char UNCOLORED = 0;
+static const unsigned char PART1 = 1;
+static const unsigned char PART2 = 2;
+
+static unsigned char opposite(unsigned char c) { return c ^ (PART1 | PART2); }
+
+// Queue-based BFS coloring of every component; returns a conflicting edge or {-1, -1}
+std::pair<int, int> Bipartite::bfsColor()
 {
-    std::deque<std::pair<int, bool>> queue;
-    queue.push_back({src, false});
-    while (!queue.empty())
+    int V = g.V();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
+
+    // Every vertex is enqueued once, so one array serves all components
+    std::vector<int> queue(V);
+    size_t head = 0, tail = 0;
+    for (int src = 0; src < V; src++)
     {
-        std::pair<int, bool> curPair = queue.front();
-        queue.pop_front();
-        int cur = curPair.first;
-        bool setId = curPair.second;
-
-        // Bipartite condition check
-        bool inSet1 = idMap.find(cur) != idMap.end() && !idMap.find(cur)->second;
-        bool inSet2 = idMap.find(cur) != idMap.end() && idMap.find(cur)->second;
-        if (inSet1 || inSet2)
-        {
-            if (!setId && inSet2)
-                return false;
-            else if (setId && inSet1)
-                return false;
-            else
-                continue;
-        }
-        idMap[cur] = setId;
+        if (color[src] != UNCOLORED)
+            continue;
+        color[src] = PART1;
+        queue[tail++] = src;
 
-        // Process neighbors
-        for (Edge e : g.adj(cur))
+        while (head < tail)
         {
-            int next = e.getTo();
-            bool nextSetId = !setId;
-            if (idMap.find(next) == idMap.end())
-                queue.push_back({next, nextSetId});
+            int u = queue[head++];
+            unsigned char next = opposite(color[u]);
+            for (size_t e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int w = targets[e];
+                if (color[w] == UNCOLORED)
+                {
+                    color[w] = next;
+                    parent[w] = u;
+                    queue[tail++] = w;
+                }
+                else if (color[w] != next)
+                    return {u, w};
+            }
         }
     }
-
-    return true;
+    return {-1, -1};
 }
 
-// Iterate through all vertices to check if the graph is bipartite
-bool Bipartite::bipartiteCheck(const Graph &g)
+// Level-synchronous BFS coloring with atomic color claims
+std::pair<int, int> Bipartite::parallelBfsColor(int numThreads)
 {
-    idMap.clear();
-    idMap.reserve(g.V());
+    int V = g.V();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
+
+    std::vector<std::atomic<unsigned char>> shared(V);
+    parallelFor(0, V, [&](size_t v, int)
+                { shared[v].store(UNCOLORED, std::memory_order_relaxed); },
+                numThreads);
+
+    std::atomic<int> conflictU(-1);
+    int conflictW = -1;
+    std::vector<std::vector<int>> local(numThreads);
+    std::vector<int> frontier, nextFrontier;
 
-    // Check each vertex in case the graph is disconnected
-    for (const Node &node : g.getVertices())
+    for (int src = 0; src < V && conflictU.load() == -1; src++)
     {
-        int cur = node.getId();
-        // Perform BFS from this vertex if it hasn't been visited
-        if (idMap.find(cur) == idMap.end())
+        if (shared[src].load(std::memory_order_relaxed) != UNCOLORED)
+            continue;
+        shared[src].store(PART1, std::memory_order_relaxed);
+        frontier.assign(1, src);
+
+        // All vertices of one level share a color, so an edge inside the
+        // current level is the only way to see a same-colored neighbor
+        while (!frontier.empty() && conflictU.load() == -1)
         {
-            if (!bfsFromSrc(g, cur))
-                return false;
+            parallelFor(0, frontier.size(), [&](size_t i, int t)
+                        {
+                            int u = frontier[i];
+                            unsigned char next = opposite(shared[u].load(std::memory_order_relaxed));
+                            for (size_t e = offsets[u]; e < offsets[u + 1]; e++)
+                            {
+                                int w = targets[e];
+                                unsigned char seen = UNCOLORED;
+                                if (shared[w].compare_exchange_strong(seen, next, std::memory_order_relaxed))
+                                {
+                                    parent[w] = u;
+                                    local[t].push_back(w);
+                                }
+                                else if (seen != next)
+                                {
+                                    int none = -1;
+                                    if (conflictU.compare_exchange_strong(none, u))
+                                        conflictW = w;
+                                    return;
+                                }
+                            } },
+                        numThreads, 256);
+            gather(local, nextFrontier);
+            std::swap(frontier, nextFrontier);
         }
     }
-    if (idMap.size() != g.V())
-        throw std::logic_error("Bipartite check: partition size and graph size are inconsistent");
-    return true;
+
+    for (int v = 0; v < V; v++)
+        color[v] = shared[v].load(std::memory_order_relaxed);
+    return {conflictU.load(), conflictW};
+}
+
+// Close the odd cycle through the BFS tree paths of the endpoints of edge (u, w)
+void Bipartite::buildOddCycle(int u, int w)
+{
+    // Both endpoints lie on the same BFS level, so their tree paths
+    // reach the lowest common ancestor after the same number of steps
+    std::vector<int> left = {u}, right = {w};
+    while (left.back() != right.back())
+    {
+        left.push_back(parent[left.back()]);
+        right.push_back(parent[right.back()]);
+    }
+    right.pop_back();
+
+    cycle.clear();
+    for (int x : left)
+        cycle.push_back(g.id(x));
+    for (auto it = right.rbegin(); it != right.rend(); ++it)
+        cycle.push_back(g.id(*it));
+    cycle.push_back(g.id(u));
 }
 
 /*!
@@ -84,16 +151,29 @@ bool Bipartite::bipartiteCheck(const Graph &g)
  * @abstract Construct Bipartite-type object based on an
  * undirected graph.
  * @param target undirected graph used as input
+ * @param useParallel expand each BFS level with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
  */
-Bipartite::Bipartite(const Graph &target)
+Bipartite::Bipartite(const Graph &target, bool useParallel, int numThreads)
+    : g(target), color(g.V(), UNCOLORED), parent(g.V(), -1)
 {
-    this->g = Graph(target); // Copy
+    std::pair<int, int> conflict = useParallel ? parallelBfsColor(resolveThreads(numThreads))
+                                               : bfsColor();
+    _isBipartite = conflict.first == -1;
+    if (!_isBipartite)
+    {
+        buildOddCycle(conflict.first, conflict.second);
+        return;
+    }
 
-    // Trivially bipartite
-    if (g.V() == 0 || g.V() == 1)
-        this->_isBipartite = true;
-    else
-        this->_isBipartite = bipartiteCheck(g);
+    for (int v = 0; v < static_cast<int>(g.V()); v++)
+    {
+        if (color[v] == PART1)
+            part1.push_back(g.id(v));
+        else
+            part2.push_back(g.id(v));
+    }
 }
 
 /*!
@@ -102,11 +182,8 @@ Bipartite::Bipartite(const Graph &target)
  * @param other another Bipartite-type object
  */
 Bipartite::Bipartite(const Bipartite &other)
-{
-    this->g = DiGraph(other.g);
-    this->idMap = std::unordered_map<int, bool>(other.idMap);
-    this->_isBipartite = other._isBipartite;
-}
+    : g(other.g), color(other.color), parent(other.parent), part1(other.part1),
+      part2(other.part2), cycle(other.cycle), _isBipartite(other._isBipartite) {}
 
 /*!
  * @function operator=
@@ -117,7 +194,11 @@ Bipartite &Bipartite::operator=(const Bipartite &other)
 {
     Bipartite newCopy(other);
     std::swap(this->g, newCopy.g);
-    std::swap(this->idMap, newCopy.idMap);
+    std::swap(this->color, newCopy.color);
+    std::swap(this->parent, newCopy.parent);
+    std::swap(this->part1, newCopy.part1);
+    std::swap(this->part2, newCopy.part2);
+    std::swap(this->cycle, newCopy.cycle);
     std::swap(this->_isBipartite, newCopy._isBipartite);
     return *this;
 }
@@ -128,7 +209,7 @@ Bipartite &Bipartite::operator=(const Bipartite &other)
  * based on a bipartite graph.
  * @return true if the graph is bipartite or empty, false otherwise
  */
-bool Bipartite::isBipartite()
+bool Bipartite::isBipartite() const
 {
     return _isBipartite;
 }
@@ -141,7 +222,7 @@ bool Bipartite::isBipartite()
  * @return true if v and w are in the same set, false otherwise or if the graph is not bipartite.
  * @exception throws std::out_of_range if graph does not contain v or w
  */
-bool Bipartite::sameSet(int v, int w)
+bool Bipartite::sameSet(int v, int w) const
 {
     if (!g.contains(v))
         throw std::out_of_range("Invalid bipartite query: invalid vertex " + std::to_string(v));
@@ -150,49 +231,42 @@ bool Bipartite::sameSet(int v, int w)
     if (!_isBipartite)
         return false;
 
-    return idMap.find(v)->second == idMap.find(w)->second;
+    return color[g.index(v)] == color[g.index(w)];
 }
 
 /*!
  * @function getPart1
- * @abstract Returns the first set of vertices if the graph is bipartite.
- *           Returns empty std::set<int> if graph is not bipartite.
+ * @abstract Returns the first set of vertices if the graph is bipartite,
+ *           ordered as in Graph::getVertices(). The first vertex of
+ *           every connected component is placed in this set.
  * @return the first set of vertices. Empty if graph is not bipartite.
  * @exception throws std::out_of_range if graph is empty
  */
-std::set<int> Bipartite::getPart1()
+const std::vector<int> &Bipartite::getPart1() const
 {
     if (g.V() == 0)
         throw std::out_of_range("Invalid bipartite query: graph is empty");
-
-    std::set<int> part1Set;
-    if (!_isBipartite)
-        return part1Set;
-
-    for (auto p : idMap)
-        if (!p.second)
-            part1Set.insert(p.first);
-    return part1Set;
+    return part1;
 }
 
 /*!
  * @function getPart2
- * @abstract Returns the second (other) set of vertices if the graph is bipartite.
- *           Returns empty std::set<int> if graph is not bipartite.
+ * @abstract Returns the second (other) set of vertices if the graph is
+ *           bipartite, ordered as in Graph::getVertices().
  * @return the second set of vertices. Empty if graph is not bipartite.
  * @exception throws std::out_of_range if graph is empty
  */
-std::set<int> Bipartite::getPart2()
+const std::vector<int> &Bipartite::getPart2() const
 {
     if (g.V() == 0)
         throw std::out_of_range("Invalid bipartite query: graph is empty");
+    return part2;
+}
 
-    std::set<int> part2Set;
-    if (!_isBipartite)
-        return part2Set;
-
-    for (auto p : idMap)
-        if (p.second)
-            part2Set.insert(p.first);
-    return part2Set;
-}
\ No newline at end of file
+/*!
+ * @function oddCycle
+ * @abstract Returns an odd cycle proving that the graph is not bipartite
+ * @return vertices v, ..., v of an odd cycle, the first vertex repeated
+ *         at the end. Empty if the graph is bipartite.
+ */
+const std::vector<int> &Bipartite::oddCycle() const { return cycle; }
@@ -3,29 +3,42 @@
  * A bipartite graph is a graph where all vertices can be divided into two disjoint sets
  * such that no two graph vertices within the same set are adjacent.
  *
- * This routine returns the two partitions as iterable data types.
+ * This routine 2-colors the graph by breadth-first search over a dense
+ * color array indexed by CompactDiGraph positions, and returns the two
+ * partitions as vectors built once at construction. The parallel mode
+ * expands each BFS level with multiple threads. A graph is bipartite
+ * exactly when it has no odd cycle, and one such cycle is returned as a
+ * witness when the check fails.
  */
 
 #ifndef BIPARTITE
 #define BIPARTITE
 
-#include <set>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "graph/graph.hpp"
 #include "graph/digraph.hpp"
+#include "graph/compact-digraph.hpp"
 
 class Bipartite
 {
 private:
-    Graph g;
-    std::unordered_map<int, bool> idMap;
+    CompactDiGraph g;
+    std::vector<unsigned char> color;
+    std::vector<int> parent;
+    std::vector<int> part1;
+    std::vector<int> part2;
+    std::vector<int> cycle;
     bool _isBipartite;
 
-    // BFS to check if the graph is bipartite starting from one source
-    bool bfsFromSrc(const Graph &g, int src);
+    // Queue-based BFS coloring of every component; returns a conflicting edge or {-1, -1}
+    std::pair<int, int> bfsColor();
 
-    // Iterate through all vertices to check if the graph is bipartite
-    bool bipartiteCheck(const Graph &g);
+    // Level-synchronous BFS coloring with atomic color claims
+    std::pair<int, int> parallelBfsColor(int numThreads);
+
+    // Close the odd cycle through the BFS tree paths of the endpoints of edge (u, w)
+    void buildOddCycle(int u, int w);
 
 public:
     /*!
@@ -33,8 +46,11 @@ public:
      * @abstract Construct Bipartite-type object based on an
      * undirected graph.
      * @param target undirected graph used as input
+     * @param useParallel expand each BFS level with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
      */
-    Bipartite(const Graph &target);
+    Bipartite(const Graph &target, bool useParallel = false, int numThreads = 0);
 
     /*!
      * @function Bipartite
@@ -56,7 +72,7 @@ public:
      * based on a bipartite graph.
      * @return true if the graph is bipartite, false otherwise
      */
-    bool isBipartite();
+    bool isBipartite() const;
 
     /*!
      * @function sameSet
@@ -66,25 +82,34 @@ public:
      * @return true if v and w are in the same set, false otherwise or if the graph is not bipartite.
      * @exception throws std::out_of_range if graph does not contain v or w
      */
-    bool sameSet(int v, int w);
+    bool sameSet(int v, int w) const;
 
     /*!
      * @function getPart1
-     * @abstract Returns the first set of vertices if the graph is bipartite.
-     *           Returns empty std::set<int> if graph is not bipartite.
+     * @abstract Returns the first set of vertices if the graph is bipartite,
+     *           ordered as in Graph::getVertices(). The first vertex of
+     *           every connected component is placed in this set.
      * @return the first set of vertices. Empty if graph is not bipartite.
      * @exception throws std::out_of_range if graph is empty
      */
-    std::set<int> getPart1();
+    const std::vector<int> &getPart1() const;
 
     /*!
      * @function getPart2
-     * @abstract Returns the second (other) set of vertices if the graph is bipartite.
-     *           Returns empty std::set<int> if graph is not bipartite.
+     * @abstract Returns the second (other) set of vertices if the graph is
+     *           bipartite, ordered as in Graph::getVertices().
      * @return the second set of vertices. Empty if graph is not bipartite.
      * @exception throws std::out_of_range if graph is empty
      */
-    std::set<int> getPart2();
+    const std::vector<int> &getPart2() const;
+
+    /*!
+     * @function oddCycle
+     * @abstract Returns an odd cycle proving that the graph is not bipartite
+     * @return vertices v, ..., v of an odd cycle, the first vertex repeated
+     *         at the end. Empty if the graph is bipartite.
+     */
+    const std::vector<int> &oddCycle() const;
 };
 
-#endif /*BIPARTITE*/
\ No newline at end of file
+#endif /*BIPARTITE*/
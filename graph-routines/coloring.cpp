@@ -0,0 +1,222 @@
+/**coloring.cpp
+ *
+ * Greedy vertex coloring of an undirected graph in natural, largest-first
+ * or smallest-last order, sequential or speculative in parallel.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "coloring.hpp"
+#include "utils/parallel.hpp"
+
+// Vertex positions in the order they are colored
+std::vector<int> GraphColoring::order(Ordering ordering) const
+{
+    int V = g.V();
+    std::vector<int> sequence(V);
+    std::iota(sequence.begin(), sequence.end(), 0);
+    if (ordering == Ordering::Natural)
+        return sequence;
+
+    std::vector<int> deg(V);
+    if (ordering == Ordering::LargestFirst)
+    {
+        for (int v = 0; v < V; v++)
+            deg[v] = g.simpleDegree(v);
+        std::stable_sort(sequence.begin(), sequence.end(), [&deg](int a, int b)
+                         { return deg[a] > deg[b]; });
+        return sequence;
+    }
+
+    // Smallest-last: color in reverse order of minimum degree peeling
+    sequence = g.peelOrder(deg);
+    std::reverse(sequence.begin(), sequence.end());
+    return sequence;
+}
+
+// Largest number of edges at a vertex, which bounds every first-fit color
+static size_t maxRowLength(const CompactDiGraph &g)
+{
+    size_t longest = 0;
+    for (int v = 0; v < static_cast<int>(g.V()); v++)
+        longest = std::max(longest, g.end(v) - g.begin(v));
+    return longest;
+}
+
+// First-fit coloring in the given order
+void GraphColoring::greedy(const std::vector<int> &sequence)
+{
+    // forbidden[c] == v marks color c as taken by a neighbor of v
+    std::vector<int> forbidden(maxRowLength(g) + 1, -1);
+    for (int v : sequence)
+    {
+        for (size_t e = g.begin(v); e < g.end(v); e++)
+        {
+            int c = colorOf[g.target(e)];
+            if (c >= 0)
+                forbidden[c] = v;
+        }
+        int c = 0;
+        while (forbidden[c] == v)
+            c++;
+        colorOf[v] = c;
+    }
+    roundCount = 1;
+}
+
+// Speculative coloring with conflict resolution in rounds
+void GraphColoring::speculative(const std::vector<int> &sequence, int numThreads)
+{
+    int V = g.V();
+    std::vector<int> rank(V);
+    for (int i = 0; i < V; i++)
+        rank[sequence[i]] = i;
+
+    std::vector<std::atomic<int>> shared(V);
+    for (int v = 0; v < V; v++)
+        shared[v].store(-1, std::memory_order_relaxed);
+    size_t palette = maxRowLength(g) + 1;
+    std::vector<std::vector<int>> forbidden(numThreads);
+    std::vector<std::vector<int>> local(numThreads);
+
+    std::vector<int> work(sequence);
+    roundCount = 0;
+    while (!work.empty())
+    {
+        roundCount++;
+        // Pick colors from whatever neighbor colors are visible right now
+        parallelFor(0, work.size(), [&](size_t i, int t)
+                    {
+                        int v = work[i];
+                        std::vector<int> &taken = forbidden[t];
+                        if (taken.empty())
+                            taken.assign(palette, -1);
+                        for (size_t e = g.begin(v); e < g.end(v); e++)
+                        {
+                            int w = g.target(e);
+                            int c = w == v ? -1 : shared[w].load(std::memory_order_relaxed);
+                            if (c >= 0)
+                                taken[c] = v;
+                        }
+                        int c = 0;
+                        while (taken[c] == v)
+                            c++;
+                        shared[v].store(c, std::memory_order_relaxed); },
+                    numThreads, 256);
+
+        // Of two adjacent vertices with the same color, the one later in
+        // the ordering is recolored
+        parallelFor(0, work.size(), [&](size_t i, int t)
+                    {
+                        int v = work[i];
+                        int c = shared[v].load(std::memory_order_relaxed);
+                        for (size_t e = g.begin(v); e < g.end(v); e++)
+                        {
+                            int w = g.target(e);
+                            if (w != v && rank[w] < rank[v] && shared[w].load(std::memory_order_relaxed) == c)
+                            {
+                                local[t].push_back(v);
+                                break;
+                            }
+                        } },
+                    numThreads, 256);
+        gather(local, work);
+        std::sort(work.begin(), work.end(), [&rank](int a, int b)
+                  { return rank[a] < rank[b]; });
+    }
+
+    for (int v = 0; v < V; v++)
+        colorOf[v] = shared[v].load(std::memory_order_relaxed);
+}
+
+/*!
+ * @function GraphColoring
+ * @abstract Construct GraphColoring-type object based on an
+ *           undirected graph and color its vertices. Self-loops are
+ *           ignored.
+ * @param target undirected graph used as input
+ * @param ordering order in which vertices are colored
+ * @param useParallel color speculatively with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+GraphColoring::GraphColoring(const Graph &target, Ordering ordering, bool useParallel, int numThreads)
+    : g(target), colorOf(g.V(), -1), colorCount(0), roundCount(0)
+{
+    std::vector<int> sequence = order(ordering);
+    if (useParallel)
+        speculative(sequence, resolveThreads(numThreads));
+    else
+        greedy(sequence);
+    for (int c : colorOf)
+        colorCount = std::max(colorCount, c + 1);
+}
+
+/*!
+ * @function GraphColoring
+ * @abstract Copy constructor for GraphColoring-type object.
+ * @param other another GraphColoring-type object
+ */
+GraphColoring::GraphColoring(const GraphColoring &other)
+    : g(other.g), colorOf(other.colorOf), colorCount(other.colorCount), roundCount(other.roundCount) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for GraphColoring-type object.
+ * @param other another GraphColoring-type object
+ */
+GraphColoring &GraphColoring::operator=(const GraphColoring &other)
+{
+    GraphColoring newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->colorOf, newCopy.colorOf);
+    std::swap(this->colorCount, newCopy.colorCount);
+    std::swap(this->roundCount, newCopy.roundCount);
+    return *this;
+}
+
+/*!
+ * @function color
+ * @abstract Returns the color of v
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int GraphColoring::color(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Graph coloring: vertex " + std::to_string(v) + " is not in graph");
+    return colorOf[g.index(v)];
+}
+
+/*!
+ * @function colors
+ * @abstract Returns the color of every vertex ordered as in
+ *           Graph::getVertices()
+ * @return colors in [0, count())
+ */
+const std::vector<int> &GraphColoring::colors() const { return colorOf; }
+
+// Return number of colors used
+int GraphColoring::count() const { return colorCount; }
+
+// Return number of speculative rounds, 1 for the sequential mode
+int GraphColoring::rounds() const { return roundCount; }
+
+/*!
+ * @function colorClasses
+ * @abstract Returns the vertices of every color
+ * @return one independent set per color, each ordered as in
+ *         Graph::getVertices()
+ */
+std::vector<std::vector<int>> GraphColoring::colorClasses() const
+{
+    std::vector<std::vector<int>> classes(colorCount);
+    for (int v = 0; v < static_cast<int>(g.V()); v++)
+        classes[colorOf[v]].push_back(g.id(v));
+    return classes;
+}
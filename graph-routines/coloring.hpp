@@ -0,0 +1,112 @@
+/**coloring.hpp
+ *
+ * A proper vertex coloring assigns colors to the vertices of an
+ * undirected graph so that adjacent vertices differ. Every color class is
+ * an independent set, so the vertices of one class can be updated in
+ * parallel without conflicts.
+ *
+ * Greedy coloring visits the vertices in some order and gives each the
+ * smallest color unused by its colored neighbors. Largest-first visits
+ * vertices by decreasing degree. Smallest-last repeatedly removes a
+ * vertex of minimum remaining degree and colors in reverse removal order,
+ * which uses at most degeneracy + 1 colors.
+ *
+ * The parallel mode follows Gebremedhin and Manne: all uncolored vertices
+ * pick colors speculatively at the same time, then every vertex that
+ * shares its color with a neighbor earlier in the ordering is collected
+ * and recolored in the next round, until no conflict is left.
+ */
+
+#ifndef COLORING
+#define COLORING
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class GraphColoring
+{
+public:
+    enum class Ordering
+    {
+        Natural,
+        LargestFirst,
+        SmallestLast
+    };
+
+private:
+    CompactDiGraph g;
+    std::vector<int> colorOf;
+    int colorCount;
+    int roundCount;
+
+    // Vertex positions in the order they are colored
+    std::vector<int> order(Ordering ordering) const;
+
+    // First-fit coloring in the given order
+    void greedy(const std::vector<int> &sequence);
+
+    // Speculative coloring with conflict resolution in rounds
+    void speculative(const std::vector<int> &sequence, int numThreads);
+
+public:
+    /*!
+     * @function GraphColoring
+     * @abstract Construct GraphColoring-type object based on an
+     *           undirected graph and color its vertices. Self-loops are
+     *           ignored.
+     * @param target undirected graph used as input
+     * @param ordering order in which vertices are colored
+     * @param useParallel color speculatively with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    GraphColoring(const Graph &target, Ordering ordering = Ordering::SmallestLast,
+                  bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function GraphColoring
+     * @abstract Copy constructor for GraphColoring-type object.
+     * @param other another GraphColoring-type object
+     */
+    GraphColoring(const GraphColoring &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for GraphColoring-type object.
+     * @param other another GraphColoring-type object
+     */
+    GraphColoring &operator=(const GraphColoring &other);
+
+    /*!
+     * @function color
+     * @abstract Returns the color of v
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int color(int v) const;
+
+    /*!
+     * @function colors
+     * @abstract Returns the color of every vertex ordered as in
+     *           Graph::getVertices()
+     * @return colors in [0, count())
+     */
+    const std::vector<int> &colors() const;
+
+    // Return number of colors used
+    int count() const;
+
+    // Return number of speculative rounds, 1 for the sequential mode
+    int rounds() const;
+
+    /*!
+     * @function colorClasses
+     * @abstract Returns the vertices of every color
+     * @return one independent set per color, each ordered as in
+     *         Graph::getVertices()
+     */
+    std::vector<std::vector<int>> colorClasses() const;
+};
+
+#endif /*COLORING*/
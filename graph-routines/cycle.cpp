@@ -1,124 +1,122 @@
-/**cycle.hpp
+/**cycle.cpp
  *
  * A cycle in a directed graph is a non-empty path in which only the
  * start and last vertices are the same. In particular, empty graphs
  * are not cyclic.
  *
- * This function checks if there exists a cycle in the directed graph.
+ * These functions check if there exists a cycle in the directed graph
+ * and can return one such cycle as a witness.
  *
  * For undirected graph, each edge is treated as bidirectional edges
- * in a directed graph setting.
+ * in a directed graph setting, but an edge is never walked straight
+ * back, so a cycle needs at least three distinct vertices unless it
+ * is a self-loop.
  */
-#include <stack>
-#include <queue>
-#include <unordered_map>
+#include <vector>
 #include "cycle.hpp"
+#include "graph/compact-digraph.hpp"
 #include "graph/digraph.hpp"
 
-/*!
- *@function isCyclic
- * @abstract Checks whether the directed graph is cyclic.
- * @param target the target DiGraph
- * @return True if the graph is cyclic, false otherwise.
+// Vertex states of the depth-first search
+static const char UNVISITED = 0;
+static const char ON_STACK = 1;
+static const char DONE = 2;
+
+/**
+ * Iterative DFS shared by the directed and undirected searches. The DFS
+ * stack always holds the current tree path, so a back edge to a vertex
+ * on the stack closes a cycle made of the stack suffix from that vertex.
+ * Apart from the snapshot, all storage is three arrays sized once.
  */
-bool isCyclic(const DiGraph &target)
+static std::vector<int> dfsCycle(const CompactDiGraph &g, bool undirected)
 {
-    std::unordered_map<int, int> inDegree;
-    for (const Node &node : target.getVertices())
-    {
-        inDegree[node.getId()] = 0;
-    }
+    int V = g.V();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
 
-    for (const Node &node : target.getVertices())
-    {
-        int v = node.getId();
-        for (const Edge &e : target.adj(v))
-        {
-            int neighbor = e.getTo();
-            inDegree[neighbor]++;
-        }
-    }
+    std::vector<char> state(V, UNVISITED);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    std::vector<int> stack;
+    stack.reserve(V);
 
-    std::stack<int> stk;
-    for (const Node &node : target.getVertices())
+    for (int src = 0; src < V; src++)
     {
-        int v = node.getId();
-        if (inDegree[v] == 0)
-            stk.push(v);
-    }
-
-    int visitedCount = 0;
-    while (!stk.empty())
-    {
-        int node = stk.top();
-        stk.pop();
-        visitedCount++;
+        if (state[src] != UNVISITED)
+            continue;
 
-        for (const Edge &e : target.adj(node))
+        state[src] = ON_STACK;
+        stack.push_back(src);
+        while (!stack.empty())
         {
-            int neighbor = e.getTo();
-            inDegree[neighbor]--;
-            if (inDegree[neighbor] == 0)
-                stk.push(neighbor);
-        }
-    }
-
-    return visitedCount != target.V();
-}
+            int v = stack.back();
+            if (cursor[v] == offsets[v + 1])
+            {
+                state[v] = DONE;
+                stack.pop_back();
+                continue;
+            }
 
-// Cycle check helper for undirected graphs
-bool bfsCycleCheck(int start, const Graph &target, std::unordered_map<int, bool> &visited)
-{
-    std::queue<std::pair<int, int>> q; // Pair of (current node, parent node)
-    visited[start] = true;
-    q.push({start, -1}); // Start node has no parent
+            int w = targets[cursor[v]++];
+            // Do not walk an undirected edge straight back to the parent
+            if (undirected && stack.size() > 1 && w == stack[stack.size() - 2])
+                continue;
 
-    while (!q.empty())
-    {
-        int node = q.front().first;
-        int parent = q.front().second;
-        q.pop();
-
-        // Traverse all adjacent vertices
-        for (const Edge &e : target.adj(node))
-        {
-            int neighbor = e.getTo();
-            if (!visited[neighbor])
+            if (state[w] == UNVISITED)
             {
-                visited[neighbor] = true;
-                q.push({neighbor, node});
+                state[w] = ON_STACK;
+                stack.push_back(w);
             }
-            // If an adjacent vertex is visited and isn't the parent, we have a cycle
-            else if (neighbor != parent)
+            else if (state[w] == ON_STACK)
             {
-                return true;
+                // Back edge v -> w: the cycle is the stack from w up to v
+                size_t start = stack.size() - 1;
+                while (stack[start] != w)
+                    start--;
+
+                std::vector<int> cycle;
+                cycle.reserve(stack.size() - start + 1);
+                for (size_t i = start; i < stack.size(); i++)
+                    cycle.push_back(g.id(stack[i]));
+                cycle.push_back(g.id(w));
+                return cycle;
             }
         }
     }
-    return false;
+    return std::vector<int>();
 }
 
+/*!
+ *@function isCyclic
+ * @abstract Checks whether the directed graph is cyclic.
+ * @param target the target DiGraph
+ * @return True if the graph is cyclic, false otherwise.
+ */
+bool isCyclic(const DiGraph &target) { return !findCycle(target).empty(); }
+
 /*!
  *@function isCyclic
  * @abstract Checks whether the undirected graph is cyclic.
  * @param target the target Graph
  * @return True if the graph is cyclic, false otherwise.
  */
-bool isCyclic(const Graph &target)
-{
-    std::unordered_map<int, bool> visited;
-    for (const Node &node : target.getVertices())
-        visited[node.getId()] = false;
+bool isCyclic(const Graph &target) { return !findCycle(target).empty(); }
 
-    // Check all components of the graph (important for disconnected graphs)
-    for (const Node &node : target.getVertices())
-    {
-        int v = node.getId();
-        if (!visited[v])
-        {
-            if (bfsCycleCheck(v, target, visited))
-                return true;
-        }
-    }
-    return false;
-}
\ No newline at end of file
+/*!
+ * @function findCycle
+ * @abstract Finds a directed cycle with an iterative depth-first search
+ *           over dense index arrays.
+ * @param target the target DiGraph
+ * @return vertices v0, v1, ..., v0 of a cycle, where each consecutive
+ *         pair is an edge. Empty if the graph is acyclic.
+ */
+std::vector<int> findCycle(const DiGraph &target) { return dfsCycle(CompactDiGraph(target), false); }
+
+/*!
+ * @function findCycle
+ * @abstract Finds a cycle in the undirected graph with an iterative
+ *           depth-first search over dense index arrays.
+ * @param target the target Graph
+ * @return vertices v0, v1, ..., v0 of a cycle, where each consecutive
+ *         pair is an edge. Empty if the graph is acyclic.
+ */
+std::vector<int> findCycle(const Graph &target) { return dfsCycle(CompactDiGraph(target), true); }
@@ -4,11 +4,19 @@
  * start and last vertices are the same. In particular, empty graphs
  * are not cyclic.
  *
- * This function checks if there exists a cycle in the directed graph.
+ * These functions check if there exists a cycle in the directed graph
+ * and can return one such cycle as a witness.
  *
  * For undirected graph, each edge is treated as bidirectional edges
- * in a directed graph setting.
+ * in a directed graph setting, but an edge is never walked straight
+ * back, so a cycle needs at least three distinct vertices unless it
+ * is a self-loop.
  */
+
+#ifndef CYCLE
+#define CYCLE
+
+#include <vector>
 #include "graph/graph.hpp"
 #include "graph/digraph.hpp"
 
@@ -26,4 +34,26 @@ bool isCyclic(const DiGraph &target);
  * @param target the target Graph
  * @return True if the graph is cyclic, false otherwise.
  */
-bool isCyclic(const Graph &target);
\ No newline at end of file
+bool isCyclic(const Graph &target);
+
+/*!
+ * @function findCycle
+ * @abstract Finds a directed cycle with an iterative depth-first search
+ *           over dense index arrays.
+ * @param target the target DiGraph
+ * @return vertices v0, v1, ..., v0 of a cycle, where each consecutive
+ *         pair is an edge. Empty if the graph is acyclic.
+ */
+std::vector<int> findCycle(const DiGraph &target);
+
+/*!
+ * @function findCycle
+ * @abstract Finds a cycle in the undirected graph with an iterative
+ *           depth-first search over dense index arrays.
+ * @param target the target Graph
+ * @return vertices v0, v1, ..., v0 of a cycle, where each consecutive
+ *         pair is an edge. Empty if the graph is acyclic.
+ */
+std::vector<int> findCycle(const Graph &target);
+
+#endif /*CYCLE*/
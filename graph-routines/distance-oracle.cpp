@@ -0,0 +1,422 @@
+/**distance-oracle.cpp
+ *
+ * Pruned landmark labeling with degree-ordered hubs, batched parallel
+ * construction and a memory-mappable label image.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "distance-oracle.hpp"
+#include "graph/compact-digraph.hpp"
+#include "utils/parallel.hpp"
+
+static const double UNREACHED = std::numeric_limits<double>::infinity();
+static const char MAGIC[4] = {'V', 'V', 'D', 'O'};
+static const uint32_t VERSION = 1;
+
+// Start of the label image. It continues with the out- and in-offsets,
+// out- and in-distances, vertex ids and out- and in-hub ranks, with the
+// 8-byte sections first so that every section is aligned
+struct ImageHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t V;
+    uint64_t outCount;
+    uint64_t inCount;
+};
+
+// Bytes of an image with the given counts
+static size_t imageBytes(uint64_t V, uint64_t outCount, uint64_t inCount)
+{
+    return sizeof(ImageHeader) + 2 * (V + 1) * sizeof(uint64_t) + (outCount + inCount) * sizeof(double) +
+           (V + outCount + inCount) * sizeof(int32_t);
+}
+
+// One label entry during construction
+struct LabelEntry
+{
+    int hub;
+    double dist;
+};
+
+// Per-thread search state
+struct SearchSpace
+{
+    std::vector<double> dist;
+    // hubDist[x] is the distance between the searching hub and hub x
+    std::vector<double> hubDist;
+    std::vector<int> touched;
+    std::vector<std::pair<double, int>> heap;
+
+    SearchSpace(int V) : dist(V, UNREACHED), hubDist(V, UNREACHED) {}
+};
+
+// Pruned search from hub h over g. hubSide holds the labels on the side of
+// h and reachedSide those on the side of the reached vertices; every vertex
+// whose distance is not answered by them is appended to found.
+static void prunedSearch(const CompactDiGraph &g, int h, bool weighted,
+                         const std::vector<std::vector<LabelEntry>> &hubSide,
+                         const std::vector<std::vector<LabelEntry>> &reachedSide,
+                         SearchSpace &ws, std::vector<std::pair<int, double>> &found)
+{
+    for (const LabelEntry &entry : hubSide[h])
+        ws.hubDist[entry.hub] = entry.dist;
+
+    // Returns true if w is reached at d and not yet covered
+    auto settle = [&](int w, double d)
+    {
+        for (const LabelEntry &entry : reachedSide[w])
+            if (ws.hubDist[entry.hub] + entry.dist <= d)
+                return false;
+        found.push_back({w, d});
+        return true;
+    };
+
+    ws.dist[h] = 0;
+    ws.touched.assign(1, h);
+    if (!weighted)
+    {
+        // touched doubles as the BFS queue
+        for (size_t head = 0; head < ws.touched.size(); head++)
+        {
+            int v = ws.touched[head];
+            if (!settle(v, ws.dist[v]))
+                continue;
+            for (size_t e = g.begin(v); e < g.end(v); e++)
+            {
+                int w = g.target(e);
+                if (ws.dist[w] == UNREACHED)
+                {
+                    ws.dist[w] = ws.dist[v] + 1;
+                    ws.touched.push_back(w);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Lazy-deletion binary heap; stale entries have a larger distance
+        std::greater<std::pair<double, int>> later;
+        ws.heap.assign(1, {0.0, h});
+        while (!ws.heap.empty())
+        {
+            std::pop_heap(ws.heap.begin(), ws.heap.end(), later);
+            double d = ws.heap.back().first;
+            int v = ws.heap.back().second;
+            ws.heap.pop_back();
+            if (d > ws.dist[v] || !settle(v, d))
+                continue;
+            for (size_t e = g.begin(v); e < g.end(v); e++)
+            {
+                int w = g.target(e);
+                double alt = d + g.weight(e);
+                if (alt < ws.dist[w])
+                {
+                    if (ws.dist[w] == UNREACHED)
+                        ws.touched.push_back(w);
+                    ws.dist[w] = alt;
+                    ws.heap.push_back({alt, w});
+                    std::push_heap(ws.heap.begin(), ws.heap.end(), later);
+                }
+            }
+        }
+    }
+
+    for (int v : ws.touched)
+        ws.dist[v] = UNREACHED;
+    for (const LabelEntry &entry : hubSide[h])
+        ws.hubDist[entry.hub] = UNREACHED;
+}
+
+// Empty oracle filled by load()
+DistanceOracle::DistanceOracle()
+    : imageSize(0), outStart(nullptr), inStart(nullptr), outDist(nullptr), inDist(nullptr),
+      outHub(nullptr), inHub(nullptr) {}
+
+// Point the views into the image and index the vertex ids
+void DistanceOracle::attach()
+{
+    ImageHeader header;
+    if (imageSize < sizeof(header))
+        throw std::invalid_argument("Distance oracle: file does not hold a label image");
+    std::memcpy(&header, image.get(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::invalid_argument("Distance oracle: file does not hold a label image");
+    if (header.version != VERSION)
+        throw std::invalid_argument("Distance oracle: unsupported version " + std::to_string(header.version));
+    uint64_t V = header.V, outCount = header.outCount, inCount = header.inCount;
+    uint64_t limit = std::numeric_limits<int32_t>::max();
+    if (V > limit || outCount > imageSize || inCount > imageSize || imageBytes(V, outCount, inCount) != imageSize)
+        throw std::invalid_argument("Distance oracle: label image has the wrong size");
+
+    const char *p = image.get() + sizeof(header);
+    outStart = reinterpret_cast<const uint64_t *>(p);
+    inStart = outStart + V + 1;
+    outDist = reinterpret_cast<const double *>(inStart + V + 1);
+    inDist = outDist + outCount;
+    const int32_t *idArray = reinterpret_cast<const int32_t *>(inDist + inCount);
+    outHub = idArray + V;
+    inHub = outHub + outCount;
+
+    // Hub ranks are only compared, so the offsets are all a query needs
+    // to stay in bounds
+    for (const uint64_t *start : {outStart, inStart})
+    {
+        uint64_t count = start == outStart ? outCount : inCount;
+        if (start[0] != 0 || start[V] != count)
+            throw std::invalid_argument("Distance oracle: corrupt label offsets");
+        for (uint64_t v = 0; v < V; v++)
+            if (start[v] > start[v + 1])
+                throw std::invalid_argument("Distance oracle: corrupt label offsets");
+    }
+
+    ids.assign(idArray, idArray + V);
+    idToIndex.clear();
+    bool identity = true;
+    for (uint64_t v = 0; v < V; v++)
+        identity = identity && ids[v] == static_cast<int>(v);
+    if (!identity)
+        for (uint64_t v = 0; v < V; v++)
+            if (!idToIndex.emplace(ids[v], v).second)
+                throw std::invalid_argument("Distance oracle: duplicate vertex " + std::to_string(ids[v]));
+}
+
+// Position of v in DiGraph::getVertices(), or -1 if v is missing
+int DistanceOracle::indexOf(int v) const
+{
+    if (idToIndex.empty())
+        return v >= 0 && v < static_cast<int>(ids.size()) ? v : -1;
+    auto it = idToIndex.find(v);
+    return it == idToIndex.end() ? -1 : it->second;
+}
+
+/*!
+ * @function DistanceOracle
+ * @abstract Construct DistanceOracle-type object based on a directed
+ *           graph and compute its labels.
+ * @param target directed graph used as input
+ * @param weighted use edge weights as lengths instead of hop counts
+ * @param useParallel search hubs with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if weighted and some edge
+ *            weight is negative
+ */
+DistanceOracle::DistanceOracle(const DiGraph &target, bool weighted, bool useParallel, int numThreads)
+    : DistanceOracle()
+{
+    CompactDiGraph g(target), rev = g.reverse();
+    int V = g.V();
+    if (weighted)
+        for (double w : g.getWeights())
+            if (!(w >= 0))
+                throw std::invalid_argument("Distance oracle: edge weight " + std::to_string(w) + " is negative");
+
+    // Hubs by decreasing total degree
+    std::vector<int> order(V);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                     { return g.end(a) - g.begin(a) + rev.end(a) - rev.begin(a) >
+                              g.end(b) - g.begin(b) + rev.end(b) - rev.begin(b); });
+
+    std::vector<std::vector<LabelEntry>> outLabel(V), inLabel(V);
+    int threads = useParallel ? resolveThreads(numThreads) : 1;
+    std::vector<SearchSpace> spaces(threads, SearchSpace(V));
+    std::vector<std::vector<std::pair<int, double>>> foundIn, foundOut;
+    for (int first = 0; first < V;)
+    {
+        // Early hubs prune the most, so they go in small batches
+        int batch = threads == 1 ? 1 : first < 64 * threads ? threads : 16 * threads;
+        batch = std::min(batch, V - first);
+        foundIn.resize(batch);
+        foundOut.resize(batch);
+        parallelFor(0, batch, [&](size_t i, int t)
+                    {
+                        int h = order[first + i];
+                        foundIn[i].clear();
+                        foundOut[i].clear();
+                        prunedSearch(g, h, weighted, outLabel, inLabel, spaces[t], foundIn[i]);
+                        prunedSearch(rev, h, weighted, inLabel, outLabel, spaces[t], foundOut[i]);
+                    },
+                    threads, 1);
+
+        // Append in rank order so that every label stays sorted by hub
+        for (int i = 0; i < batch; i++)
+        {
+            for (const std::pair<int, double> &f : foundIn[i])
+                inLabel[f.first].push_back({first + i, f.second});
+            for (const std::pair<int, double> &f : foundOut[i])
+                outLabel[f.first].push_back({first + i, f.second});
+        }
+        first += batch;
+    }
+
+    // Pack the labels into one image
+    ImageHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.V = V;
+    header.outCount = header.inCount = 0;
+    for (int v = 0; v < V; v++)
+    {
+        header.outCount += outLabel[v].size();
+        header.inCount += inLabel[v].size();
+    }
+    imageSize = imageBytes(V, header.outCount, header.inCount);
+    char *buffer = new char[imageSize];
+    image = std::shared_ptr<const char>(buffer, std::default_delete<const char[]>());
+    std::memcpy(buffer, &header, sizeof(header));
+
+    uint64_t *starts = reinterpret_cast<uint64_t *>(buffer + sizeof(header));
+    double *dists = reinterpret_cast<double *>(starts + 2 * (V + 1));
+    int32_t *ranks = reinterpret_cast<int32_t *>(dists + header.outCount + header.inCount);
+    for (int v = 0; v < V; v++)
+        ranks[v] = g.id(v);
+    ranks += V;
+    for (std::vector<std::vector<LabelEntry>> *labels : {&outLabel, &inLabel})
+    {
+        uint64_t pos = 0;
+        for (int v = 0; v < V; v++)
+        {
+            *starts++ = pos;
+            for (const LabelEntry &entry : (*labels)[v])
+            {
+                *dists++ = entry.dist;
+                *ranks++ = entry.hub;
+            }
+            pos += (*labels)[v].size();
+            std::vector<LabelEntry>().swap((*labels)[v]);
+        }
+        *starts++ = pos;
+    }
+    attach();
+}
+
+/*!
+ * @function DistanceOracle
+ * @abstract Copy constructor for DistanceOracle-type object. The
+ *           immutable label image is shared.
+ * @param other another DistanceOracle-type object
+ */
+DistanceOracle::DistanceOracle(const DistanceOracle &other)
+    : image(other.image), imageSize(other.imageSize), ids(other.ids), idToIndex(other.idToIndex),
+      outStart(other.outStart), inStart(other.inStart), outDist(other.outDist), inDist(other.inDist),
+      outHub(other.outHub), inHub(other.inHub) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for DistanceOracle-type object.
+ * @param other another DistanceOracle-type object
+ */
+DistanceOracle &DistanceOracle::operator=(const DistanceOracle &other)
+{
+    DistanceOracle newCopy(other);
+    std::swap(this->image, newCopy.image);
+    std::swap(this->imageSize, newCopy.imageSize);
+    std::swap(this->ids, newCopy.ids);
+    std::swap(this->idToIndex, newCopy.idToIndex);
+    std::swap(this->outStart, newCopy.outStart);
+    std::swap(this->inStart, newCopy.inStart);
+    std::swap(this->outDist, newCopy.outDist);
+    std::swap(this->inDist, newCopy.inDist);
+    std::swap(this->outHub, newCopy.outHub);
+    std::swap(this->inHub, newCopy.inHub);
+    return *this;
+}
+
+/*!
+ * @function distance
+ * @abstract Returns the length of a shortest path from u to v
+ * @param u the start vertex
+ * @param v the end vertex
+ * @return the distance, infinity if v is unreachable from u
+ * @exception throws std::out_of_range if u or v is not in the graph
+ */
+double DistanceOracle::distance(int u, int v) const
+{
+    int iu = indexOf(u), iv = indexOf(v);
+    if (iu == -1 || iv == -1)
+        throw std::out_of_range("Distance oracle: vertex " + std::to_string(iu == -1 ? u : v) + " is not in graph");
+
+    // Merge the two rank-sorted labels
+    uint64_t i = outStart[iu], iEnd = outStart[iu + 1];
+    uint64_t j = inStart[iv], jEnd = inStart[iv + 1];
+    double best = UNREACHED;
+    while (i < iEnd && j < jEnd)
+    {
+        if (outHub[i] < inHub[j])
+            i++;
+        else if (outHub[i] > inHub[j])
+            j++;
+        else
+            best = std::min(best, outDist[i++] + inDist[j++]);
+    }
+    return best;
+}
+
+// Return total number of label entries over all vertices
+size_t DistanceOracle::labelSize() const
+{
+    return ids.empty() ? 0 : outStart[ids.size()] + inStart[ids.size()];
+}
+
+/*!
+ * @function save
+ * @abstract Write the label image to a file
+ * @param path the file to create or overwrite
+ * @exception throws std::invalid_argument if the file cannot be
+ *            written
+ */
+void DistanceOracle::save(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(image.get(), imageSize);
+    if (!out)
+        throw std::invalid_argument("Distance oracle: cannot write " + path);
+}
+
+/*!
+ * @function load
+ * @abstract Map a file written by save() into memory
+ * @param path the file to map
+ * @return the oracle reading its labels from the mapping
+ * @exception throws std::invalid_argument if the file cannot be
+ *            mapped or does not hold a valid label image
+ */
+DistanceOracle DistanceOracle::load(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::invalid_argument("Distance oracle: cannot open " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ImageHeader)))
+    {
+        close(fd);
+        throw std::invalid_argument("Distance oracle: " + path + " does not hold a label image");
+    }
+    size_t size = info.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        throw std::invalid_argument("Distance oracle: cannot map " + path);
+
+    DistanceOracle oracle;
+    oracle.image = std::shared_ptr<const char>(static_cast<const char *>(mapped), [size](const char *p)
+                                               { munmap(const_cast<char *>(p), size); });
+    oracle.imageSize = size;
+    oracle.attach();
+    return oracle;
+}
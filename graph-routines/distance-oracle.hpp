@@ -0,0 +1,121 @@
+/**distance-oracle.hpp
+ *
+ * Exact shortest-path distance oracle based on pruned landmark labeling
+ * (Akiba, Iwata and Yoshida). Every vertex v keeps an out-label of hubs h
+ * with the distance from v to h and an in-label of hubs with the
+ * distance from h to v, chosen so that some shortest u-v path passes
+ * through a hub shared by the out-label of u and the in-label of v. A
+ * query merges those two lists, both sorted by hub rank, and takes the
+ * smallest sum.
+ *
+ * Vertices become hubs in order of decreasing total degree. Each hub runs
+ * a forward and a backward BFS (Dijkstra search when weighted) that stops
+ * at every vertex whose distance is already answered by the labels of
+ * earlier hubs, so late hubs only touch small neighbourhoods. In the
+ * parallel mode consecutive hubs are searched at the same time against
+ * the labels of all earlier batches; this only adds redundant entries.
+ *
+ * The labels are stored in one contiguous image: CSR offsets, then hub
+ * distances, then vertex ids and hub ranks. save() writes the image
+ * unchanged and load() maps the file into memory, so a saved oracle is
+ * ready after reading its offsets and pages in on demand.
+ */
+
+#ifndef DISTANCE_ORACLE
+#define DISTANCE_ORACLE
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "graph/digraph.hpp"
+
+class DistanceOracle
+{
+private:
+    // Label image, either allocated by the constructor or a mapped file
+    std::shared_ptr<const char> image;
+    size_t imageSize;
+    std::vector<int> ids;
+    // Empty when every vertex id equals its position
+    std::unordered_map<int, int> idToIndex;
+    // Views into the image; out-label of v is entries outStart[v] to
+    // outStart[v + 1] - 1 of outHub and outDist, likewise for in-labels
+    const uint64_t *outStart, *inStart;
+    const double *outDist, *inDist;
+    const int32_t *outHub, *inHub;
+
+    // Empty oracle filled by load()
+    DistanceOracle();
+
+    // Point the views into the image and index the vertex ids
+    void attach();
+
+    // Position of v in DiGraph::getVertices(), or -1 if v is missing
+    int indexOf(int v) const;
+
+public:
+    /*!
+     * @function DistanceOracle
+     * @abstract Construct DistanceOracle-type object based on a directed
+     *           graph and compute its labels.
+     * @param target directed graph used as input
+     * @param weighted use edge weights as lengths instead of hop counts
+     * @param useParallel search hubs with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if weighted and some edge
+     *            weight is negative
+     */
+    DistanceOracle(const DiGraph &target, bool weighted = false, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function DistanceOracle
+     * @abstract Copy constructor for DistanceOracle-type object. The
+     *           immutable label image is shared.
+     * @param other another DistanceOracle-type object
+     */
+    DistanceOracle(const DistanceOracle &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for DistanceOracle-type object.
+     * @param other another DistanceOracle-type object
+     */
+    DistanceOracle &operator=(const DistanceOracle &other);
+
+    /*!
+     * @function distance
+     * @abstract Returns the length of a shortest path from u to v
+     * @param u the start vertex
+     * @param v the end vertex
+     * @return the distance, infinity if v is unreachable from u
+     * @exception throws std::out_of_range if u or v is not in the graph
+     */
+    double distance(int u, int v) const;
+
+    // Return total number of label entries over all vertices
+    size_t labelSize() const;
+
+    /*!
+     * @function save
+     * @abstract Write the label image to a file
+     * @param path the file to create or overwrite
+     * @exception throws std::invalid_argument if the file cannot be
+     *            written
+     */
+    void save(const std::string &path) const;
+
+    /*!
+     * @function load
+     * @abstract Map a file written by save() into memory
+     * @param path the file to map
+     * @return the oracle reading its labels from the mapping
+     * @exception throws std::invalid_argument if the file cannot be
+     *            mapped or does not hold a valid label image
+     */
+    static DistanceOracle load(const std::string &path);
+};
+
+#endif /*DISTANCE_ORACLE*/
@@ -0,0 +1,316 @@
+/**dynamic-topo-order.cpp
+ *
+ * Maintains a topological order of a directed acyclic graph under edge
+ * insertions using the Pearce-Kelly algorithm. Inserting v -> w when v
+ * already precedes w costs O(1) expected, with duplicate edges detected
+ * through a hash set of packed endpoints. Otherwise only the vertices
+ * whose position lies between w and v are searched and reordered, and an
+ * edge that would close a cycle is rejected together with the cycle it
+ * would create.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "dynamic-topo-order.hpp"
+#include "topo-sort.hpp"
+
+// Pack the edge x -> y between dense indices into one key
+static uint64_t edgeKey(int x, int y)
+{
+    return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+}
+
+// Check if the edge x -> y between dense indices exists
+bool DynamicTopologicalOrder::hasEdge(int x, int y) const { return edgeKeys.count(edgeKey(x, y)) != 0; }
+
+// Start a new search generation
+unsigned DynamicTopologicalOrder::nextEpoch()
+{
+    if (++epoch == 0)
+    {
+        std::fill(mark.begin(), mark.end(), 0);
+        epoch = 1;
+    }
+    return epoch;
+}
+
+// Collect vertices reachable from y positioned before ub; false if x is reached
+bool DynamicTopologicalOrder::forwardSearch(int y, int x, int ub)
+{
+    unsigned cur = nextEpoch();
+    stack.clear();
+    deltaF.clear();
+    mark[y] = cur;
+    parent[y] = -1;
+    stack.push_back(y);
+
+    while (!stack.empty())
+    {
+        int u = stack.back();
+        stack.pop_back();
+        deltaF.push_back(u);
+        for (int z : out[u])
+        {
+            if (z == x)
+            {
+                parent[x] = u;
+                return false;
+            }
+            if (mark[z] != cur && pos[z] < ub)
+            {
+                mark[z] = cur;
+                parent[z] = u;
+                stack.push_back(z);
+            }
+        }
+    }
+    return true;
+}
+
+// Collect vertices reaching x positioned after lb
+void DynamicTopologicalOrder::backwardSearch(int x, int lb)
+{
+    unsigned cur = nextEpoch();
+    stack.clear();
+    deltaB.clear();
+    mark[x] = cur;
+    stack.push_back(x);
+
+    while (!stack.empty())
+    {
+        int u = stack.back();
+        stack.pop_back();
+        deltaB.push_back(u);
+        for (int z : in[u])
+        {
+            if (mark[z] != cur && pos[z] > lb)
+            {
+                mark[z] = cur;
+                stack.push_back(z);
+            }
+        }
+    }
+}
+
+// Move deltaB in front of deltaF within the positions they occupy
+void DynamicTopologicalOrder::reorder()
+{
+    auto byPos = [this](int a, int b)
+    { return pos[a] < pos[b]; };
+    std::sort(deltaB.begin(), deltaB.end(), byPos);
+    std::sort(deltaF.begin(), deltaF.end(), byPos);
+
+    // Pool of positions currently held by both sets, in increasing order
+    slots.clear();
+    size_t i = 0, j = 0;
+    while (i < deltaB.size() || j < deltaF.size())
+    {
+        if (j == deltaF.size() || (i < deltaB.size() && pos[deltaB[i]] < pos[deltaF[j]]))
+            slots.push_back(pos[deltaB[i++]]);
+        else
+            slots.push_back(pos[deltaF[j++]]);
+    }
+
+    // Hand out the slots to deltaB first, then deltaF, keeping relative orders
+    size_t k = 0;
+    for (int u : deltaB)
+    {
+        pos[u] = slots[k];
+        vertexAt[slots[k++]] = u;
+    }
+    for (int u : deltaF)
+    {
+        pos[u] = slots[k];
+        vertexAt[slots[k++]] = u;
+    }
+}
+
+/*!
+ * @function DynamicTopologicalOrder
+ * @abstract Construct an empty DynamicTopologicalOrder-type object
+ */
+DynamicTopologicalOrder::DynamicTopologicalOrder() : edgeCount(0), epoch(0) {}
+
+/*!
+ * @function DynamicTopologicalOrder
+ * @abstract Construct DynamicTopologicalOrder-type object starting from
+ *           a directed acyclic graph
+ * @param target directed acyclic graph used as input
+ * @exception throws std::invalid_argument if target is cyclic
+ */
+DynamicTopologicalOrder::DynamicTopologicalOrder(const DiGraph &target)
+    : edgeCount(0), epoch(0)
+{
+    TopologicalSort ts(target);
+    if (!ts.isDAG())
+        throw std::invalid_argument("Dynamic topological order: initial graph is cyclic");
+
+    for (int v : ts.order())
+        insertVertex(v);
+    edgeKeys.reserve(target.E());
+    for (const Node &node : target.getVertices())
+    {
+        int x = idToIndex.at(node.getId());
+        for (const Edge &e : node.edges())
+        {
+            int y = idToIndex.at(e.getTo());
+            out[x].push_back(y);
+            in[y].push_back(x);
+            edgeKeys.insert(edgeKey(x, y));
+            edgeCount++;
+        }
+    }
+}
+
+// Return number of vertices
+size_t DynamicTopologicalOrder::V() const { return ids.size(); }
+// Return number of edges
+size_t DynamicTopologicalOrder::E() const { return edgeCount; }
+
+// Check if the structure contains v
+bool DynamicTopologicalOrder::contains(int v) const { return idToIndex.find(v) != idToIndex.end(); }
+
+/*!
+ * @function insertVertex
+ * @abstract Insert a vertex with key v at the end of the order
+ * @param v Key of the new vertex
+ */
+void DynamicTopologicalOrder::insertVertex(int v)
+{
+    if (contains(v))
+        return;
+
+    int x = ids.size();
+    idToIndex.insert({v, x});
+    ids.push_back(v);
+    out.emplace_back();
+    in.emplace_back();
+    pos.push_back(x);
+    vertexAt.push_back(x);
+    mark.push_back(0);
+    parent.push_back(-1);
+}
+
+/*!
+ * @function insertEdge
+ * @abstract Insert the edge v -> w unless it would create a cycle.
+ *           Inserting an existing edge has no effect.
+ * @param v The starting vertex
+ * @param w The destination vertex
+ * @return true if the edge was inserted, false if it was rejected
+ *         because w already reaches v; see lastCycle()
+ * @exception throws std::out_of_range if v or w is not present
+ */
+bool DynamicTopologicalOrder::insertEdge(int v, int w)
+{
+    if (!contains(v))
+        throw std::out_of_range("Edge insertion error: vertex " + std::to_string(v) + " is not in graph");
+    if (!contains(w))
+        throw std::out_of_range("Edge insertion error: vertex " + std::to_string(w) + " is not in graph");
+
+    int x = idToIndex.at(v);
+    int y = idToIndex.at(w);
+    cyclePath.clear();
+
+    if (x == y)
+    {
+        cyclePath = {v, v};
+        return false;
+    }
+    if (hasEdge(x, y))
+        return true;
+
+    // Order is invalidated only if w currently precedes v
+    if (pos[y] < pos[x])
+    {
+        int lb = pos[y], ub = pos[x];
+        if (!forwardSearch(y, x, ub))
+        {
+            // Walk the search tree back from x to y, then close with v -> w
+            for (int u = x; u != -1; u = parent[u])
+                cyclePath.push_back(ids[u]);
+            cyclePath.push_back(v);
+            std::reverse(cyclePath.begin(), cyclePath.end());
+            return false;
+        }
+        backwardSearch(x, lb);
+        reorder();
+    }
+
+    out[x].push_back(y);
+    in[y].push_back(x);
+    edgeKeys.insert(edgeKey(x, y));
+    edgeCount++;
+    return true;
+}
+
+/*!
+ * @function eraseEdge
+ * @abstract Remove the edge v -> w if it exists. Removing edges never
+ *           invalidates the current order.
+ * @param v The starting vertex
+ * @param w The destination vertex
+ * @exception throws std::out_of_range if v or w is not present
+ */
+void DynamicTopologicalOrder::eraseEdge(int v, int w)
+{
+    if (!contains(v))
+        throw std::out_of_range("Edge removal error: vertex " + std::to_string(v) + " is not in graph");
+    if (!contains(w))
+        throw std::out_of_range("Edge removal error: vertex " + std::to_string(w) + " is not in graph");
+
+    int x = idToIndex.at(v);
+    int y = idToIndex.at(w);
+    if (edgeKeys.erase(edgeKey(x, y)) == 0)
+        return;
+
+    // Swap-and-pop, adjacency order is irrelevant
+    auto outIt = std::find(out[x].begin(), out[x].end(), y);
+    *outIt = out[x].back();
+    out[x].pop_back();
+    auto inIt = std::find(in[y].begin(), in[y].end(), x);
+    *inIt = in[y].back();
+    in[y].pop_back();
+    edgeCount--;
+}
+
+/*!
+ * @function lastCycle
+ * @abstract Returns the cycle that made the last insertEdge call fail
+ * @return vertices v, w, ..., v of the cycle the rejected edge v -> w
+ *         would close. Empty if the last insertion succeeded.
+ */
+const std::vector<int> &DynamicTopologicalOrder::lastCycle() const { return cyclePath; }
+
+/*!
+ * @function precedes
+ * @abstract Checks whether v comes before w in the current order
+ * @param v the first queried vertex
+ * @param w the second queried vertex
+ * @exception throws std::out_of_range if v or w is not present
+ */
+bool DynamicTopologicalOrder::precedes(int v, int w) const
+{
+    if (!contains(v))
+        throw std::out_of_range("Dynamic topological order: vertex " + std::to_string(v) + " is not in graph");
+    if (!contains(w))
+        throw std::out_of_range("Dynamic topological order: vertex " + std::to_string(w) + " is not in graph");
+    return pos[idToIndex.at(v)] < pos[idToIndex.at(w)];
+}
+
+/*!
+ * @function order
+ * @abstract Returns the current topological order
+ * @return vertex ids in topological order
+ */
+std::vector<int> DynamicTopologicalOrder::order() const
+{
+    std::vector<int> result;
+    result.reserve(ids.size());
+    for (int x : vertexAt)
+        result.push_back(ids[x]);
+    return result;
+}
@@ -0,0 +1,144 @@
+/**dynamic-topo-order.hpp
+ *
+ * Maintains a topological order of a directed acyclic graph under edge
+ * insertions using the Pearce-Kelly algorithm. Inserting v -> w when v
+ * already precedes w costs O(1) expected, with duplicate edges detected
+ * through a hash set of packed endpoints. Otherwise only the vertices whose
+ * position lies between w and v are searched and reordered, and an edge
+ * that would close a cycle is rejected together with the cycle it would
+ * create.
+ *
+ * All searches reuse the same workspace and visited marks are reset by
+ * bumping an epoch counter, so an insertion allocates nothing beyond its
+ * adjacency entries and hash-set node once the buffers have grown to the
+ * size of the affected regions.
+ */
+
+#ifndef DYNAMIC_TOPO_ORDER
+#define DYNAMIC_TOPO_ORDER
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "graph/digraph.hpp"
+
+class DynamicTopologicalOrder
+{
+private:
+    std::vector<int> ids;
+    std::unordered_map<int, int> idToIndex;
+    std::vector<std::vector<int>> out;
+    std::vector<std::vector<int>> in;
+    // Packed (x, y) keys of all edges for O(1) duplicate checks
+    std::unordered_set<uint64_t> edgeKeys;
+    size_t edgeCount;
+
+    // pos[x] is the position of index x, vertexAt[p] the index at position p
+    std::vector<int> pos;
+    std::vector<int> vertexAt;
+
+    // Search workspace
+    std::vector<unsigned> mark;
+    std::vector<int> parent;
+    std::vector<int> stack;
+    std::vector<int> deltaF;
+    std::vector<int> deltaB;
+    std::vector<int> slots;
+    unsigned epoch;
+    std::vector<int> cyclePath;
+
+    // Check if the edge x -> y between dense indices exists
+    bool hasEdge(int x, int y) const;
+
+    // Collect vertices reachable from y positioned before ub; false if x is reached
+    bool forwardSearch(int y, int x, int ub);
+
+    // Collect vertices reaching x positioned after lb
+    void backwardSearch(int x, int lb);
+
+    // Move deltaB in front of deltaF within the positions they occupy
+    void reorder();
+
+    // Start a new search generation
+    unsigned nextEpoch();
+
+public:
+    /*!
+     * @function DynamicTopologicalOrder
+     * @abstract Construct an empty DynamicTopologicalOrder-type object
+     */
+    DynamicTopologicalOrder();
+
+    /*!
+     * @function DynamicTopologicalOrder
+     * @abstract Construct DynamicTopologicalOrder-type object starting from
+     *           a directed acyclic graph
+     * @param target directed acyclic graph used as input
+     * @exception throws std::invalid_argument if target is cyclic
+     */
+    DynamicTopologicalOrder(const DiGraph &target);
+
+    // Return number of vertices
+    size_t V() const;
+    // Return number of edges
+    size_t E() const;
+
+    // Check if the structure contains v
+    bool contains(int v) const;
+
+    /*!
+     * @function insertVertex
+     * @abstract Insert a vertex with key v at the end of the order
+     * @param v Key of the new vertex
+     */
+    void insertVertex(int v);
+
+    /*!
+     * @function insertEdge
+     * @abstract Insert the edge v -> w unless it would create a cycle.
+     *           Inserting an existing edge has no effect.
+     * @param v The starting vertex
+     * @param w The destination vertex
+     * @return true if the edge was inserted, false if it was rejected
+     *         because w already reaches v; see lastCycle()
+     * @exception throws std::out_of_range if v or w is not present
+     */
+    bool insertEdge(int v, int w);
+
+    /*!
+     * @function eraseEdge
+     * @abstract Remove the edge v -> w if it exists. Removing edges never
+     *           invalidates the current order.
+     * @param v The starting vertex
+     * @param w The destination vertex
+     * @exception throws std::out_of_range if v or w is not present
+     */
+    void eraseEdge(int v, int w);
+
+    /*!
+     * @function lastCycle
+     * @abstract Returns the cycle that made the last insertEdge call fail
+     * @return vertices v, w, ..., v of the cycle the rejected edge v -> w
+     *         would close. Empty if the last insertion succeeded.
+     */
+    const std::vector<int> &lastCycle() const;
+
+    /*!
+     * @function precedes
+     * @abstract Checks whether v comes before w in the current order
+     * @param v the first queried vertex
+     * @param w the second queried vertex
+     * @exception throws std::out_of_range if v or w is not present
+     */
+    bool precedes(int v, int w) const;
+
+    /*!
+     * @function order
+     * @abstract Returns the current topological order
+     * @return vertex ids in topological order
+     */
+    std::vector<int> order() const;
+};
+
+#endif /*DYNAMIC_TOPO_ORDER*/
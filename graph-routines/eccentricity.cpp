@@ -0,0 +1,294 @@
+/**eccentricity.cpp
+ *
+ * Exact diameter, radius and eccentricities by lower and upper bound
+ * pruning, or bounds from a parallel sample of breadth-first searches.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "eccentricity.hpp"
+#include "strong-connectivity.hpp"
+#include "utils/parallel.hpp"
+
+// Distances of one forward and one backward search
+struct Eccentricity::Search
+{
+    std::vector<int> forward, backward;
+    std::vector<int> forwardOrder, backwardOrder;
+    int ecc, farthest;
+
+    Search(int V) : forward(V, -1), backward(V, -1), ecc(0), farthest(-1) {}
+};
+
+// BFS from s filling dist and the visit order; returns the largest distance
+static int bfs(const CompactDiGraph &g, int s, std::vector<int> &dist, std::vector<int> &order)
+{
+    dist[s] = 0;
+    order.assign(1, s);
+    for (size_t head = 0; head < order.size(); head++)
+    {
+        int v = order[head];
+        for (size_t e = g.begin(v); e < g.end(v); e++)
+        {
+            int w = g.target(e);
+            if (dist[w] == -1)
+            {
+                dist[w] = dist[v] + 1;
+                order.push_back(w);
+            }
+        }
+    }
+    return dist[order.back()];
+}
+
+// Search from every source and tighten the bounds
+void Eccentricity::round(const CompactDiGraph &rev, const std::vector<int> &sources, std::vector<Search> &slots,
+                         int numThreads)
+{
+    parallelFor(0, sources.size(), [&](size_t i, int)
+                {
+                    Search &s = slots[i];
+                    s.ecc = bfs(g, sources[i], s.forward, s.forwardOrder);
+                    s.farthest = s.forwardOrder.back();
+                    if (!symmetric)
+                        bfs(rev, sources[i], s.backward, s.backwardOrder); },
+                numThreads, 1);
+
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        Search &s = slots[i];
+        int v = sources[i], e = s.ecc;
+        // backward[w] is the distance from w to v
+        std::vector<int> &backward = symmetric ? s.forward : s.backward;
+        std::vector<int> &backwardOrder = symmetric ? s.forwardOrder : s.backwardOrder;
+        for (int w : backwardOrder)
+        {
+            int d = backward[w];
+            lower[w] = std::max(lower[w], d);
+            if (comp[w] == comp[v])
+            {
+                lower[w] = std::max(lower[w], e - s.forward[w]);
+                upper[w] = std::min(upper[w], e + d);
+            }
+        }
+        lower[v] = upper[v] = e;
+
+        for (int w : s.forwardOrder)
+            s.forward[w] = -1;
+        if (!symmetric)
+            for (int w : s.backwardOrder)
+                s.backward[w] = -1;
+        searchCount++;
+    }
+}
+
+// Bounding or sampled searches until the result is known
+void Eccentricity::compute(int samples, unsigned int seed, int numThreads)
+{
+    int V = g.V();
+    CompactDiGraph rev = symmetric ? CompactDiGraph() : g.reverse();
+    lower.assign(V, 0);
+    upper.assign(V, std::max(V - 1, 0));
+    std::vector<int> degree(V);
+    for (int v = 0; v < V; v++)
+    {
+        degree[v] = g.end(v) - g.begin(v);
+        if (!symmetric)
+            degree[v] += rev.end(v) - rev.begin(v);
+
+        // Vertices without edges to others reach nothing
+        bool sink = true;
+        for (size_t e = g.begin(v); e < g.end(v) && sink; e++)
+            sink = g.target(e) == v;
+        if (sink)
+            upper[v] = 0;
+    }
+    auto updateExtremes = [&]()
+    {
+        diameterBound = V == 0 ? 0 : *std::max_element(lower.begin(), lower.end());
+        radiusBound = V == 0 ? 0 : *std::min_element(upper.begin(), upper.end());
+    };
+    std::vector<Search> slots(numThreads, Search(V));
+    std::vector<int> sources;
+
+    if (samples > 0 && samples < V)
+    {
+        // Partial Fisher-Yates shuffle picks distinct sources uniformly
+        std::vector<int> pool(V);
+        std::iota(pool.begin(), pool.end(), 0);
+        std::mt19937 rng(seed);
+        for (int i = 0; i < samples; i++)
+            std::swap(pool[i], pool[std::uniform_int_distribution<int>(i, V - 1)(rng)]);
+        int far = -1, farEcc = -1;
+        for (int first = 0; first < samples; first += numThreads)
+        {
+            sources.assign(pool.begin() + first, pool.begin() + std::min(samples, first + numThreads));
+            round(rev, sources, slots, numThreads);
+            for (size_t i = 0; i < sources.size(); i++)
+                if (slots[i].ecc > farEcc)
+                {
+                    farEcc = slots[i].ecc;
+                    far = slots[i].farthest;
+                }
+        }
+
+        // Second sweep from the vertex farthest from the most eccentric source
+        if (lower[far] < upper[far])
+            round(rev, std::vector<int>(1, far), slots, numThreads);
+        updateExtremes();
+        exact = false;
+        return;
+    }
+
+    std::vector<int> candidates;
+    for (int v = 0; v < V; v++)
+        if (lower[v] < upper[v])
+            candidates.push_back(v);
+    updateExtremes();
+    bool high = true;
+    std::vector<char> picked(V, 0);
+    while (!candidates.empty())
+    {
+        // Alternate between likely peripheral and likely central vertices,
+        // preferring high degrees on ties
+        sources.clear();
+        while (sources.size() < static_cast<size_t>(numThreads) && sources.size() < candidates.size())
+        {
+            int best = -1;
+            for (int w : candidates)
+            {
+                if (picked[w])
+                    continue;
+                if (best == -1)
+                    best = w;
+                else if (high ? upper[w] > upper[best] || (upper[w] == upper[best] && degree[w] > degree[best])
+                              : lower[w] < lower[best] || (lower[w] == lower[best] && degree[w] > degree[best]))
+                    best = w;
+            }
+            picked[best] = 1;
+            sources.push_back(best);
+            high = !high;
+        }
+        round(rev, sources, slots, numThreads);
+        for (int v : sources)
+            picked[v] = 0;
+
+        // Drop vertices that are resolved or can no longer be extreme
+        updateExtremes();
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](int w)
+                                        { return lower[w] == upper[w] ||
+                                                 (upper[w] <= diameterBound && lower[w] >= radiusBound); }),
+                         candidates.end());
+    }
+    exact = true;
+}
+
+/*!
+ * @function Eccentricity
+ * @abstract Construct Eccentricity-type object based on a directed
+ *           graph, following edge directions.
+ * @param target directed graph used as input
+ * @param samples number of sampled sources, 0 or at least the number
+ *                of vertices computes exact values
+ * @param seed seed for choosing sampled sources
+ * @param useParallel run searches with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+Eccentricity::Eccentricity(const DiGraph &target, int samples, unsigned int seed, bool useParallel, int numThreads)
+    : g(target), symmetric(false), comp(StrongConnectivity(target).ids()), diameterBound(0), radiusBound(0),
+      searchCount(0), exact(false)
+{
+    compute(samples, seed, useParallel ? resolveThreads(numThreads) : 1);
+}
+
+/*!
+ * @function Eccentricity
+ * @abstract Construct Eccentricity-type object based on an undirected
+ *           graph. Parameters are the same as for directed graphs.
+ */
+Eccentricity::Eccentricity(const Graph &target, int samples, unsigned int seed, bool useParallel, int numThreads)
+    : g(target), symmetric(true), comp(StrongConnectivity(target).ids()), diameterBound(0), radiusBound(0),
+      searchCount(0), exact(false)
+{
+    compute(samples, seed, useParallel ? resolveThreads(numThreads) : 1);
+}
+
+/*!
+ * @function Eccentricity
+ * @abstract Copy constructor for Eccentricity-type object.
+ * @param other another Eccentricity-type object
+ */
+Eccentricity::Eccentricity(const Eccentricity &other)
+    : g(other.g), symmetric(other.symmetric), comp(other.comp), lower(other.lower), upper(other.upper),
+      diameterBound(other.diameterBound), radiusBound(other.radiusBound), searchCount(other.searchCount),
+      exact(other.exact) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for Eccentricity-type object.
+ * @param other another Eccentricity-type object
+ */
+Eccentricity &Eccentricity::operator=(const Eccentricity &other)
+{
+    Eccentricity newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->symmetric, newCopy.symmetric);
+    std::swap(this->comp, newCopy.comp);
+    std::swap(this->lower, newCopy.lower);
+    std::swap(this->upper, newCopy.upper);
+    std::swap(this->diameterBound, newCopy.diameterBound);
+    std::swap(this->radiusBound, newCopy.radiusBound);
+    std::swap(this->searchCount, newCopy.searchCount);
+    std::swap(this->exact, newCopy.exact);
+    return *this;
+}
+
+// Return the diameter, a lower bound in the sampled mode
+int Eccentricity::diameter() const { return diameterBound; }
+
+// Return the radius, an upper bound in the sampled mode
+int Eccentricity::radius() const { return radiusBound; }
+
+/*!
+ * @function eccentricity
+ * @abstract Returns the eccentricity of v, searching from v if the
+ *           bounds did not resolve it
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int Eccentricity::eccentricity(int v) const
+{
+    std::pair<int, int> known = bounds(v);
+    if (known.first == known.second)
+        return known.first;
+    std::vector<int> dist(g.V(), -1), order;
+    return bfs(g, g.index(v), dist, order);
+}
+
+/*!
+ * @function bounds
+ * @abstract Returns the bounds on the eccentricity of v known without
+ *           a further search
+ * @param v the queried vertex
+ * @return lower and upper bound, equal once v is resolved
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+std::pair<int, int> Eccentricity::bounds(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Eccentricity: vertex " + std::to_string(v) + " is not in graph");
+    int i = g.index(v);
+    return {lower[i], upper[i]};
+}
+
+// Checks if diameter() and radius() are exact
+bool Eccentricity::isExact() const { return exact; }
+
+// Return number of breadth-first searches run
+int Eccentricity::searches() const { return searchCount; }
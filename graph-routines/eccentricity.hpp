@@ -0,0 +1,126 @@
+/**eccentricity.hpp
+ *
+ * The eccentricity of a vertex is the largest number of hops from it to
+ * any vertex it reaches. The diameter is the largest and the radius the
+ * smallest eccentricity; on disconnected graphs both are taken over the
+ * eccentricities within each component, so an isolated vertex or a sink
+ * has eccentricity 0.
+ *
+ * The exact mode follows the bounding scheme of Takes and Kosters, which
+ * generalizes iFUB and the double sweep: every BFS from a vertex v fixes
+ * its eccentricity e and bounds each vertex w at distance d from v to
+ * [max(d, e - d), e + d]. Searches alternate between the vertex with the
+ * largest upper and the one with the smallest lower bound, starting from
+ * the vertex of highest degree, and a vertex is dropped once it is
+ * resolved or can be neither peripheral nor central. On real-world graphs
+ * this ends after a handful of searches. On directed graphs the bounds
+ * use a backward search too and the e-based bounds only hold within a
+ * strongly connected component, so vertices outside large components may
+ * need a search of their own. The parallel mode runs one search per
+ * thread in every round.
+ *
+ * The sampled mode searches only the given number of random vertices, in
+ * parallel, plus a final sweep from the farthest vertex found. diameter()
+ * is then a lower and radius() an upper bound.
+ */
+
+#ifndef ECCENTRICITY
+#define ECCENTRICITY
+
+#include <utility>
+#include <vector>
+#include "graph/digraph.hpp"
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class Eccentricity
+{
+private:
+    struct Search;
+
+    CompactDiGraph g;
+    bool symmetric;
+    std::vector<int> comp;
+    std::vector<int> lower, upper;
+    int diameterBound, radiusBound;
+    int searchCount;
+    bool exact;
+
+    // Search from every source and tighten the bounds
+    void round(const CompactDiGraph &rev, const std::vector<int> &sources, std::vector<Search> &slots,
+               int numThreads);
+
+    // Bounding or sampled searches until the result is known
+    void compute(int samples, unsigned int seed, int numThreads);
+
+public:
+    /*!
+     * @function Eccentricity
+     * @abstract Construct Eccentricity-type object based on a directed
+     *           graph, following edge directions.
+     * @param target directed graph used as input
+     * @param samples number of sampled sources, 0 or at least the number
+     *                of vertices computes exact values
+     * @param seed seed for choosing sampled sources
+     * @param useParallel run searches with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    Eccentricity(const DiGraph &target, int samples = 0, unsigned int seed = 0,
+                 bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function Eccentricity
+     * @abstract Construct Eccentricity-type object based on an undirected
+     *           graph. Parameters are the same as for directed graphs.
+     */
+    Eccentricity(const Graph &target, int samples = 0, unsigned int seed = 0,
+                 bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function Eccentricity
+     * @abstract Copy constructor for Eccentricity-type object.
+     * @param other another Eccentricity-type object
+     */
+    Eccentricity(const Eccentricity &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for Eccentricity-type object.
+     * @param other another Eccentricity-type object
+     */
+    Eccentricity &operator=(const Eccentricity &other);
+
+    // Return the diameter, a lower bound in the sampled mode
+    int diameter() const;
+
+    // Return the radius, an upper bound in the sampled mode
+    int radius() const;
+
+    /*!
+     * @function eccentricity
+     * @abstract Returns the eccentricity of v, searching from v if the
+     *           bounds did not resolve it
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int eccentricity(int v) const;
+
+    /*!
+     * @function bounds
+     * @abstract Returns the bounds on the eccentricity of v known without
+     *           a further search
+     * @param v the queried vertex
+     * @return lower and upper bound, equal once v is resolved
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    std::pair<int, int> bounds(int v) const;
+
+    // Checks if diameter() and radius() are exact
+    bool isExact() const;
+
+    // Return number of breadth-first searches run
+    int searches() const;
+};
+
+#endif /*ECCENTRICITY*/
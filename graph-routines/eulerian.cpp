@@ -8,35 +8,290 @@
  * cycle in a directed graph and returns such a path as an iterable
  * data type.
  *
- * For undirected graph, each edge is treated as bidirectional edges
- * in a directed graph setting.
+ * For an undirected Graph, the path uses every undirected edge once. A
+ * Graph passed as a DiGraph instead has each edge treated as two
+ * directed edges, one per direction.
  */
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 #include "graph/digraph.hpp"
 #include "eulerian.hpp"
 
+// Number of adjacency entries, which is E() for a DiGraph and 2 E() for a
+// Graph viewed as one
+static size_t arcCount(const DiGraph &target)
+{
+    size_t arcs = 0;
+    for (const Node &node : target.getVertices())
+        arcs += std::distance(node.edges().begin(), node.edges().end());
+    return arcs;
+}
+
+/*!
+ * @function writePath
+ * @abstract Streaming mode: writes the Eulerian path of target into
+ *           buffer without building an Eulerian object. Graphs without
+ *           edges have no Eulerian path.
+ * @param target directed graph used as input
+ * @param buffer destination of the E + 1 vertices of the path
+ * @param capacity number of ints available in buffer
+ * @return number of vertices written, E + 1 if a path exists and 0
+ *         otherwise. The buffer content is unspecified when 0 is returned.
+ * @exception throws std::length_error if capacity is less than E + 1
+ */
+size_t Eulerian::writePath(const DiGraph &target, int *buffer, size_t capacity)
+{
+    const std::vector<Node> &vertices = target.getVertices();
+    int V = vertices.size();
+    size_t E = arcCount(target);
+    if (E == 0)
+        return 0;
+    if (capacity < E + 1)
+        throw std::length_error("Eulerian: buffer holds " + std::to_string(capacity) +
+                                " vertices but the path needs " + std::to_string(E + 1));
+
+    // Dense targets in CSR form, looked up once; out-edges of v are
+    // head[offsets[v]] to head[offsets[v + 1] - 1]
+    std::vector<size_t> offsets(V + 1, 0);
+    std::vector<int> head;
+    head.reserve(E);
+    for (int v = 0; v < V; v++)
+    {
+        for (const Edge &e : vertices[v].edges())
+            head.push_back(target.indexOf(e.getTo()));
+        offsets[v + 1] = head.size();
+    }
+
+    // Degree balance out - in; a path needs every balance in {-1, 0, 1}
+    // with at most one start (+1) and one end (-1)
+    std::vector<int> balance(V, 0);
+    for (int v = 0; v < V; v++)
+    {
+        balance[v] += offsets[v + 1] - offsets[v];
+        for (size_t a = offsets[v]; a < offsets[v + 1]; a++)
+            balance[head[a]]--;
+    }
+
+    int start = -1, starts = 0, ends = 0;
+    for (int v = 0; v < V && starts <= 1 && ends <= 1; v++)
+    {
+        if (balance[v] == 1)
+        {
+            start = v;
+            starts++;
+        }
+        else if (balance[v] == -1)
+            ends++;
+        else if (balance[v] != 0)
+            return 0;
+    }
+    if (starts > 1 || ends > 1 || starts != ends)
+        return 0;
+
+    // Balanced graph: any vertex with an outgoing edge can start the circuit
+    for (int v = 0; start == -1 && v < V; v++)
+        if (offsets[v + 1] > offsets[v])
+            start = v;
+
+    // Hierholzer: follow unused edges until stuck, then emit the vertex.
+    // Vertices are emitted in reverse, so the buffer is filled from the back.
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    std::vector<int> stack;
+    stack.push_back(start);
+    size_t pos = E + 1;
+    while (!stack.empty())
+    {
+        int v = stack.back();
+        if (cursor[v] < offsets[v + 1])
+            stack.push_back(head[cursor[v]++]);
+        else
+        {
+            stack.pop_back();
+            if (pos == 0) // Defensive: more emissions than edges
+                return 0;
+            buffer[--pos] = vertices[v].getId();
+        }
+    }
+
+    // Edges outside the component of start were never reached
+    return pos == 0 ? E + 1 : 0;
+}
+
+/*!
+ * @function writePath
+ * @abstract Streaming mode for undirected graphs: writes a path using
+ *           every undirected edge once into buffer. Graphs without
+ *           edges have no Eulerian path.
+ * @param target undirected graph used as input
+ * @param buffer destination of the E + 1 vertices of the path
+ * @param capacity number of ints available in buffer
+ * @return number of vertices written, E + 1 if a path exists and 0
+ *         otherwise. The buffer content is unspecified when 0 is returned.
+ * @exception throws std::length_error if capacity is less than E + 1
+ */
+size_t Eulerian::writePath(const Graph &target, int *buffer, size_t capacity)
+{
+    const std::vector<Node> &vertices = target.getVertices();
+    int V = vertices.size();
+    size_t E = target.E();
+    if (E == 0)
+        return 0;
+    if (capacity < E + 1)
+        throw std::length_error("Eulerian: buffer holds " + std::to_string(capacity) +
+                                " vertices but the path needs " + std::to_string(E + 1));
+
+    // Adjacency entries in CSR form; arcs of vertex v are head[offsets[v]]
+    // to head[offsets[v + 1] - 1]. Adjacency is symmetric, so placing v
+    // into the row of each neighbor in increasing order of v builds every
+    // row sorted by target with one lookup per entry.
+    std::vector<size_t> offsets(V + 1, 0);
+    for (int v = 0; v < V; v++)
+        offsets[v + 1] = offsets[v] + std::distance(vertices[v].edges().begin(), vertices[v].edges().end());
+    if (offsets[V] != 2 * E)
+        return 0;
+    std::vector<int> head(2 * E);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (int v = 0; v < V; v++)
+        for (const Edge &e : vertices[v].edges())
+            head[cursor[target.indexOf(e.getTo())]++] = v;
+
+    // Pair the two entries of every edge in one sweep: for a fixed w the
+    // entries v -> w with v < w are met in increasing order of v, which is
+    // also the order of the entries w -> v at the front of row w. The two
+    // entries of a self-loop sit next to each other.
+    std::vector<size_t> twin(2 * E);
+    std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+    for (int v = 0; v < V; v++)
+    {
+        for (size_t a = offsets[v]; a < offsets[v + 1]; a++)
+        {
+            int w = head[a];
+            if (w > v)
+            {
+                size_t b = cursor[w]++;
+                twin[a] = b;
+                twin[b] = a;
+            }
+            else if (w == v)
+            {
+                twin[a] = a + 1;
+                twin[a + 1] = a;
+                a++;
+            }
+        }
+    }
+
+    // A path needs zero or two vertices of odd degree and starts at one
+    int start = -1, odd = 0;
+    for (int v = 0; v < V; v++)
+    {
+        if ((offsets[v + 1] - offsets[v]) % 2 == 1)
+        {
+            if (odd++ == 0)
+                start = v;
+        }
+    }
+    if (odd != 0 && odd != 2)
+        return 0;
+    for (int v = 0; start == -1 && v < V; v++)
+        if (offsets[v + 1] > offsets[v])
+            start = v;
+
+    // Hierholzer as for directed graphs. Walking an entry clears its twin
+    // to -1, so the edge is not walked again from the other endpoint.
+    std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+    std::vector<int> stack;
+    stack.push_back(start);
+    size_t pos = E + 1;
+    while (!stack.empty())
+    {
+        int v = stack.back();
+        while (cursor[v] < offsets[v + 1] && head[cursor[v]] == -1)
+            cursor[v]++;
+        if (cursor[v] < offsets[v + 1])
+        {
+            size_t a = cursor[v]++;
+            head[twin[a]] = -1;
+            stack.push_back(head[a]);
+        }
+        else
+        {
+            stack.pop_back();
+            if (pos == 0) // Defensive: more emissions than edges
+                return 0;
+            buffer[--pos] = vertices[v].getId();
+        }
+    }
+
+    // Edges outside the component of start were never reached
+    return pos == 0 ? E + 1 : 0;
+}
+
 /*!
  * @function Eulerian
- * @abstract Construct Eulerian-type object based on an
- * undirected graph.
+ * @abstract Construct Eulerian-type object based on a
+ * directed graph.
+ * @param target directed graph used as input
+ */
+Eulerian::Eulerian(const DiGraph &target) : hasCycle(false)
+{
+    size_t E = arcCount(target);
+    if (E == 0)
+        return;
+
+    path.resize(E + 1);
+    if (writePath(target, path.data(), path.size()) == 0)
+    {
+        path.clear();
+        return;
+    }
+    hasCycle = path.front() == path.back();
+}
+
+/*!
+ * @function Eulerian
+ * @abstract Construct Eulerian-type object based on an undirected
+ * graph, using every undirected edge once.
  * @param target undirected graph used as input
  */
-Eulerian::Eulerian(const DiGraph &target) {}
+Eulerian::Eulerian(const Graph &target) : hasCycle(false)
+{
+    if (target.E() == 0)
+        return;
+
+    path.resize(target.E() + 1);
+    if (writePath(target, path.data(), path.size()) == 0)
+    {
+        path.clear();
+        return;
+    }
+    hasCycle = path.front() == path.back();
+}
 
 /*!
  * @function Eulerian
  * @abstract Copy constructor for Eulerian-type object.
  * @param other another Eulerian-type object
  */
-Eulerian::Eulerian(const Eulerian &other) {}
+Eulerian::Eulerian(const Eulerian &other) : path(other.path), hasCycle(other.hasCycle) {}
 
 /*!
  * @function operator=
  * @abstract Copy-assignment operator for Eulerian-type object.
  * @param other another Eulerian-type object
  */
-Eulerian &Eulerian::operator=(const Eulerian &other) {}
+Eulerian &Eulerian::operator=(const Eulerian &other)
+{
+    Eulerian newCopy(other);
+    std::swap(this->path, newCopy.path);
+    std::swap(this->hasCycle, newCopy.hasCycle);
+    return *this;
+}
 
 /*!
  * @function getPath
@@ -47,18 +302,18 @@ Eulerian &Eulerian::operator=(const Eulerian &other) {}
  * @return std::vector<int> with entried being the vertices of the
  *         Eulerian path from start to end
  */
-std::vector<int> Eulerian::getPath() {}
+const std::vector<int> &Eulerian::getPath() const { return path; }
 
 /*!
  * @function hasEulerianPath
  * @abstract Checks whether the directed graph has an Eulerian path
  * @return true if there is an Eulerian path, false otherwise
  */
-bool Eulerian::hasEulerianPath() {}
+bool Eulerian::hasEulerianPath() const { return !path.empty(); }
 
 /*!
  * @function hasEulerianCycle
  * @abstract Checks whether the directed graph has an Eulerian cycle
  * @return true if there is an Eulerian cycle, false otherwise
  */
-bool Eulerian::hasEulerianCycle() {}
\ No newline at end of file
+bool Eulerian::hasEulerianCycle() const { return hasCycle; }
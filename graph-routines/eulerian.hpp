@@ -8,12 +8,24 @@
  * cycle in a directed graph and returns such a path as an iterable
  * data type.
  *
- * For undirected graph, each edge is treated as bidirectional edges
- * in a directed graph setting.
+ * For an undirected Graph, the path uses every undirected edge once. A
+ * Graph passed as a DiGraph instead has each edge treated as two
+ * directed edges, one per direction.
+ *
+ * The path is built by an iterative Hierholzer that advances one cursor
+ * per vertex through its adjacency list, so every edge is read exactly
+ * once, nothing is erased from the graph and recursion depth is not
+ * bounded by the call stack. The path can also be streamed straight into
+ * a caller-provided buffer without an intermediate copy.
  */
 
+#ifndef EULERIAN
+#define EULERIAN
+
+#include <cstddef>
 #include <vector>
 #include "graph/digraph.hpp"
+#include "graph/graph.hpp"
 
 class Eulerian
 {
@@ -24,12 +36,20 @@ private:
 public:
     /*!
      * @function Eulerian
-     * @abstract Construct Eulerian-type object based on an
-     * undirected graph.
-     * @param target undirected graph used as input
+     * @abstract Construct Eulerian-type object based on a
+     * directed graph.
+     * @param target directed graph used as input
      */
     Eulerian(const DiGraph &target);
 
+    /*!
+     * @function Eulerian
+     * @abstract Construct Eulerian-type object based on an undirected
+     * graph, using every undirected edge once.
+     * @param target undirected graph used as input
+     */
+    Eulerian(const Graph &target);
+
     /*!
      * @function Eulerian
      * @abstract Copy constructor for Eulerian-type object.
@@ -53,19 +73,49 @@ public:
      * @return std::vector<int> with entried being the vertices of the
      *         Eulerian path from start to end
      */
-    std::vector<int> getPath();
+    const std::vector<int> &getPath() const;
 
     /*!
      * @function hasEulerianPath
      * @abstract Checks whether the directed graph has an Eulerian path
      * @return true if there is an Eulerian path, false otherwise
      */
-    bool hasEulerianPath();
+    bool hasEulerianPath() const;
 
     /*!
      * @function hasEulerianCycle
      * @abstract Checks whether the directed graph has an Eulerian cycle
      * @return true if there is an Eulerian cycle, false otherwise
      */
-    bool hasEulerianCycle();
-};
\ No newline at end of file
+    bool hasEulerianCycle() const;
+
+    /*!
+     * @function writePath
+     * @abstract Streaming mode: writes the Eulerian path of target into
+     *           buffer without building an Eulerian object. Graphs without
+     *           edges have no Eulerian path.
+     * @param target directed graph used as input
+     * @param buffer destination of the E + 1 vertices of the path
+     * @param capacity number of ints available in buffer
+     * @return number of vertices written, E + 1 if a path exists and 0
+     *         otherwise. The buffer content is unspecified when 0 is returned.
+     * @exception throws std::length_error if capacity is less than E + 1
+     */
+    static size_t writePath(const DiGraph &target, int *buffer, size_t capacity);
+
+    /*!
+     * @function writePath
+     * @abstract Streaming mode for undirected graphs: writes a path using
+     *           every undirected edge once into buffer. Graphs without
+     *           edges have no Eulerian path.
+     * @param target undirected graph used as input
+     * @param buffer destination of the E + 1 vertices of the path
+     * @param capacity number of ints available in buffer
+     * @return number of vertices written, E + 1 if a path exists and 0
+     *         otherwise. The buffer content is unspecified when 0 is returned.
+     * @exception throws std::length_error if capacity is less than E + 1
+     */
+    static size_t writePath(const Graph &target, int *buffer, size_t capacity);
+};
+
+#endif /*EULERIAN*/
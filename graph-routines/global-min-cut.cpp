@@ -0,0 +1,412 @@
+/**global-min-cut.cpp
+ *
+ * Global minimum cut of a weighted undirected graph by Stoer-Wagner or by
+ * parallel Karger-Stein trials.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "global-min-cut.hpp"
+#include "utils/parallel.hpp"
+
+// Undirected edge between dense indices
+struct WeightedEdge
+{
+    int u, v;
+    double w;
+};
+
+// Representative of v with path halving
+static int findRoot(std::vector<int> &parent, int v)
+{
+    while (parent[v] != v)
+    {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+// Exact minimum cut of a connected multigraph on n >= 2 vertices; side
+// marks the vertices of one side
+static double stoerWagner(int n, const std::vector<WeightedEdge> &edges, std::vector<char> &side)
+{
+    // Lists keep original endpoints; merged vertices are resolved through rep
+    std::vector<std::vector<std::pair<int, double>>> adj(n);
+    for (const WeightedEdge &e : edges)
+    {
+        if (e.u != e.v)
+        {
+            adj[e.u].push_back({e.v, e.w});
+            adj[e.v].push_back({e.u, e.w});
+        }
+    }
+    std::vector<int> rep(n), alive(n), next(n, -1), tail(n);
+    std::iota(rep.begin(), rep.end(), 0);
+    std::iota(alive.begin(), alive.end(), 0);
+    std::iota(tail.begin(), tail.end(), 0);
+    std::vector<double> key(n);
+    std::vector<char> added(n);
+    std::priority_queue<std::pair<double, int>> heap;
+    double best = std::numeric_limits<double>::infinity();
+
+    while (alive.size() > 1)
+    {
+        // Maximum adjacency order; keys only grow, so heap entries below the
+        // current key are stale
+        for (int v : alive)
+        {
+            key[v] = 0;
+            added[v] = 0;
+        }
+        heap.push({0, alive[0]});
+        int prev = -1, last = -1;
+        double lastKey = 0;
+        while (!heap.empty())
+        {
+            std::pair<double, int> top = heap.top();
+            heap.pop();
+            int u = top.second;
+            if (added[u] || top.first < key[u])
+                continue;
+            added[u] = 1;
+            prev = last;
+            last = u;
+            lastKey = top.first;
+            for (const std::pair<int, double> &entry : adj[u])
+            {
+                int r = findRoot(rep, entry.first);
+                if (r != u && !added[r])
+                {
+                    key[r] += entry.second;
+                    heap.push({key[r], r});
+                }
+            }
+        }
+
+        // The cut of the phase separates the last vertex from the rest
+        if (lastKey < best)
+        {
+            best = lastKey;
+            side.assign(n, 0);
+            for (int m = last; m != -1; m = next[m])
+                side[m] = 1;
+        }
+
+        // Merge last into prev
+        rep[last] = prev;
+        next[tail[prev]] = last;
+        tail[prev] = tail[last];
+        if (adj[prev].size() < adj[last].size())
+            adj[prev].swap(adj[last]);
+        adj[prev].insert(adj[prev].end(), adj[last].begin(), adj[last].end());
+        std::vector<std::pair<int, double>>().swap(adj[last]);
+        *std::find(alive.begin(), alive.end(), last) = alive.back();
+        alive.pop_back();
+    }
+    return best;
+}
+
+// Contract random edges, chosen with probability proportional to weight,
+// until target vertices remain. map receives the new vertex of each old
+// one and out the merged edges; returns the number of new vertices, more
+// than target only if no edge of positive weight is left.
+static int contract(int n, const std::vector<WeightedEdge> &edges, int target, std::mt19937 &rng,
+                    std::vector<int> &map, std::vector<WeightedEdge> &out)
+{
+    // Sorting by exponential keys with rate w gives the order of a
+    // weighted random contraction
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::vector<std::pair<double, int>> order;
+    order.reserve(edges.size());
+    for (size_t i = 0; i < edges.size(); i++)
+        if (edges[i].w > 0)
+            order.push_back({-std::log(1 - uniform(rng)) / edges[i].w, static_cast<int>(i)});
+    std::sort(order.begin(), order.end());
+
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    int count = n;
+    for (size_t k = 0; k < order.size() && count > target; k++)
+    {
+        const WeightedEdge &e = edges[order[k].second];
+        int a = findRoot(parent, e.u), b = findRoot(parent, e.v);
+        if (a != b)
+        {
+            parent[a] = b;
+            count--;
+        }
+    }
+
+    std::vector<int> dense(n, -1);
+    int m = 0;
+    map.resize(n);
+    for (int v = 0; v < n; v++)
+    {
+        int r = findRoot(parent, v);
+        if (dense[r] == -1)
+            dense[r] = m++;
+        map[v] = dense[r];
+    }
+
+    // Drop self-loops and merge parallel edges
+    out.clear();
+    for (const WeightedEdge &e : edges)
+    {
+        int a = map[e.u], b = map[e.v];
+        if (a != b)
+            out.push_back({std::min(a, b), std::max(a, b), e.w});
+    }
+    std::sort(out.begin(), out.end(), [](const WeightedEdge &x, const WeightedEdge &y)
+              { return x.u != y.u ? x.u < y.u : x.v < y.v; });
+    size_t kept = 0;
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        if (kept > 0 && out[kept - 1].u == out[i].u && out[kept - 1].v == out[i].v)
+            out[kept - 1].w += out[i].w;
+        else
+            out[kept++] = out[i];
+    }
+    out.resize(kept);
+    return m;
+}
+
+// One Karger-Stein trial: two contractions to n / sqrt(2) vertices, each
+// followed by a recursive call, with exact cuts for small graphs
+static double recursiveCut(int n, const std::vector<WeightedEdge> &edges, std::mt19937 &rng, std::vector<char> &side)
+{
+    if (n <= 6)
+        return stoerWagner(n, edges, side);
+
+    int target = static_cast<int>(std::ceil(1 + n / std::sqrt(2.0)));
+    double best = std::numeric_limits<double>::infinity();
+    std::vector<int> map;
+    std::vector<WeightedEdge> sub;
+    std::vector<char> subSide;
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        int m = contract(n, edges, target, rng, map, sub);
+        double cut;
+        if (m > target)
+        {
+            // Only zero-weight edges join the remaining groups
+            cut = 0;
+            subSide.assign(m, 0);
+            subSide[map[0]] = 1;
+        }
+        else
+            cut = recursiveCut(m, sub, rng, subSide);
+
+        if (cut < best)
+        {
+            best = cut;
+            side.resize(n);
+            for (int v = 0; v < n; v++)
+                side[v] = subSide[map[v]];
+        }
+        if (best == 0)
+            break;
+    }
+    return best;
+}
+
+// Edges of a snapshot of an undirected graph, each once
+static std::vector<WeightedEdge> edgeList(const CompactDiGraph &g)
+{
+    std::vector<WeightedEdge> edges;
+    edges.reserve(g.E() / 2);
+    for (int u = 0; u < static_cast<int>(g.V()); u++)
+        for (size_t e = g.begin(u); e < g.end(u); e++)
+            if (u < g.target(e))
+                edges.push_back({u, g.target(e), g.weight(e)});
+    return edges;
+}
+
+// Independent Karger-Stein trials; keeps the smallest cut found
+void GlobalMinCut::kargerStein(int trials, unsigned int seed, int numThreads)
+{
+    std::vector<WeightedEdge> edges = edgeList(g);
+    int V = g.V();
+
+    // Per-thread best cut; ties go to the earlier trial so the result does
+    // not depend on the number of threads
+    struct Best
+    {
+        double value = std::numeric_limits<double>::infinity();
+        size_t trial = 0;
+        std::vector<char> side;
+    };
+    std::vector<Best> local(numThreads);
+    parallelFor(0, trials, [&](size_t i, int t)
+                {
+                    std::mt19937 rng(seed + 0x9e3779b9u * static_cast<unsigned int>(i + 1));
+                    std::vector<char> side;
+                    double cut = recursiveCut(V, edges, rng, side);
+                    Best &b = local[t];
+                    if (cut < b.value || (cut == b.value && i < b.trial))
+                    {
+                        b.value = cut;
+                        b.trial = i;
+                        b.side.swap(side);
+                    } },
+                numThreads, 1);
+
+    Best *best = &local[0];
+    for (Best &b : local)
+        if (b.value < best->value || (b.value == best->value && b.trial < best->trial))
+            best = &b;
+    cutWeight = best->value;
+    inSide.swap(best->side);
+}
+
+/*!
+ * @function GlobalMinCut
+ * @abstract Construct GlobalMinCut-type object based on a weighted
+ *           undirected graph and find a minimum cut.
+ * @param target undirected graph with non-negative edge weights
+ * @param algorithm exact Stoer-Wagner or randomized Karger-Stein
+ * @param trials number of Karger-Stein trials, 0 selects
+ *               ceil(log2(V))^2; ignored by Stoer-Wagner
+ * @param seed seed for the random contractions
+ * @param useParallel run trials with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if the graph has fewer than
+ *            two vertices or a negative edge weight
+ */
+GlobalMinCut::GlobalMinCut(const Graph &target, Algorithm algorithm, int trials,
+                           unsigned int seed, bool useParallel, int numThreads)
+    : g(target), cutWeight(0), trialCount(0)
+{
+    int V = g.V();
+    if (V < 2)
+        throw std::invalid_argument("Global min cut: graph needs at least two vertices");
+    for (double w : g.getWeights())
+        if (w < 0)
+            throw std::invalid_argument("Global min cut: negative edge weight " + std::to_string(w));
+
+    // A disconnected graph has an empty cut around the first component
+    std::vector<char> reached(V, 0);
+    std::vector<int> queue(1, 0);
+    reached[0] = 1;
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        for (size_t e = g.begin(queue[i]); e < g.end(queue[i]); e++)
+        {
+            int w = g.target(e);
+            if (!reached[w])
+            {
+                reached[w] = 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    if (static_cast<int>(queue.size()) < V)
+    {
+        inSide.resize(V);
+        for (int v = 0; v < V; v++)
+            inSide[v] = !reached[v];
+        return;
+    }
+
+    if (algorithm == Algorithm::StoerWagner)
+        cutWeight = stoerWagner(V, edgeList(g), inSide);
+    else
+    {
+        if (trials <= 0)
+        {
+            int logV = static_cast<int>(std::ceil(std::log2(V)));
+            trials = std::max(1, logV * logV);
+        }
+        trialCount = trials;
+        kargerStein(trials, seed, useParallel ? resolveThreads(numThreads) : 1);
+    }
+
+    if (inSide[0])
+        for (char &flag : inSide)
+            flag = !flag;
+}
+
+/*!
+ * @function GlobalMinCut
+ * @abstract Copy constructor for GlobalMinCut-type object.
+ * @param other another GlobalMinCut-type object
+ */
+GlobalMinCut::GlobalMinCut(const GlobalMinCut &other)
+    : g(other.g), cutWeight(other.cutWeight), inSide(other.inSide), trialCount(other.trialCount) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for GlobalMinCut-type object.
+ * @param other another GlobalMinCut-type object
+ */
+GlobalMinCut &GlobalMinCut::operator=(const GlobalMinCut &other)
+{
+    GlobalMinCut newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->cutWeight, newCopy.cutWeight);
+    std::swap(this->inSide, newCopy.inSide);
+    std::swap(this->trialCount, newCopy.trialCount);
+    return *this;
+}
+
+// Return the total weight of the cut edges
+double GlobalMinCut::value() const { return cutWeight; }
+
+// Return number of Karger-Stein trials run, 0 for Stoer-Wagner
+int GlobalMinCut::trials() const { return trialCount; }
+
+/*!
+ * @function side
+ * @abstract Returns the side of the cut that does not contain the
+ *           first vertex of Graph::getVertices()
+ * @return vertices of that side, ordered as in Graph::getVertices()
+ */
+std::vector<int> GlobalMinCut::side() const
+{
+    std::vector<int> result;
+    for (int v = 0; v < static_cast<int>(g.V()); v++)
+        if (inSide[v])
+            result.push_back(g.id(v));
+    return result;
+}
+
+/*!
+ * @function sameSide
+ * @abstract Checks if two vertices are on the same side of the cut
+ * @param v first query vertex
+ * @param w second query vertex
+ * @exception throws std::out_of_range if graph does not contain v or w
+ */
+bool GlobalMinCut::sameSide(int v, int w) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Global min cut: vertex " + std::to_string(v) + " is not in graph");
+    if (!g.contains(w))
+        throw std::out_of_range("Global min cut: vertex " + std::to_string(w) + " is not in graph");
+    return inSide[g.index(v)] == inSide[g.index(w)];
+}
+
+/*!
+ * @function cutEdges
+ * @abstract Returns the edges between the two sides
+ * @return each cut edge once, from the side of the first vertex
+ */
+std::vector<Edge> GlobalMinCut::cutEdges() const
+{
+    std::vector<Edge> result;
+    for (int u = 0; u < static_cast<int>(g.V()); u++)
+        if (!inSide[u])
+            for (size_t e = g.begin(u); e < g.end(u); e++)
+                if (inSide[g.target(e)])
+                    result.emplace_back(g.id(u), g.id(g.target(e)), g.weight(e));
+    return result;
+}
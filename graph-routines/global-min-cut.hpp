@@ -0,0 +1,111 @@
+/**global-min-cut.hpp
+ *
+ * A global minimum cut of a weighted undirected graph is a split of its
+ * vertices into two non-empty sides such that the total weight of edges
+ * between the sides is as small as possible. Unlike an s-t cut, no pair
+ * of vertices is fixed in advance.
+ *
+ * Stoer-Wagner finds an exact minimum cut in V - 1 phases. Each phase
+ * orders the vertices by maximum adjacency: the next vertex is always the
+ * one most tightly connected to those already ordered, kept in a binary
+ * heap. The cut around the last vertex is a candidate, and the last two
+ * vertices are then merged, for O(V E log V) time overall.
+ *
+ * Karger-Stein contracts random edges, picked with probability
+ * proportional to their weight, down to about V / sqrt(2) vertices twice
+ * and recurses on both results, solving small graphs exactly. One trial
+ * finds a minimum cut with probability Omega(1 / log V); independent
+ * trials run in parallel and the smallest cut found is kept.
+ */
+
+#ifndef GLOBAL_MIN_CUT
+#define GLOBAL_MIN_CUT
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class GlobalMinCut
+{
+public:
+    enum class Algorithm
+    {
+        StoerWagner,
+        KargerStein
+    };
+
+private:
+    CompactDiGraph g;
+    double cutWeight;
+    // True for vertices on the side without the first vertex
+    std::vector<char> inSide;
+    int trialCount;
+
+    // Independent Karger-Stein trials; keeps the smallest cut found
+    void kargerStein(int trials, unsigned int seed, int numThreads);
+
+public:
+    /*!
+     * @function GlobalMinCut
+     * @abstract Construct GlobalMinCut-type object based on a weighted
+     *           undirected graph and find a minimum cut.
+     * @param target undirected graph with non-negative edge weights
+     * @param algorithm exact Stoer-Wagner or randomized Karger-Stein
+     * @param trials number of Karger-Stein trials, 0 selects
+     *               ceil(log2(V))^2; ignored by Stoer-Wagner
+     * @param seed seed for the random contractions
+     * @param useParallel run trials with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if the graph has fewer than
+     *            two vertices or a negative edge weight
+     */
+    GlobalMinCut(const Graph &target, Algorithm algorithm = Algorithm::StoerWagner, int trials = 0,
+                 unsigned int seed = 0, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function GlobalMinCut
+     * @abstract Copy constructor for GlobalMinCut-type object.
+     * @param other another GlobalMinCut-type object
+     */
+    GlobalMinCut(const GlobalMinCut &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for GlobalMinCut-type object.
+     * @param other another GlobalMinCut-type object
+     */
+    GlobalMinCut &operator=(const GlobalMinCut &other);
+
+    // Return the total weight of the cut edges
+    double value() const;
+
+    // Return number of Karger-Stein trials run, 0 for Stoer-Wagner
+    int trials() const;
+
+    /*!
+     * @function side
+     * @abstract Returns the side of the cut that does not contain the
+     *           first vertex of Graph::getVertices()
+     * @return vertices of that side, ordered as in Graph::getVertices()
+     */
+    std::vector<int> side() const;
+
+    /*!
+     * @function sameSide
+     * @abstract Checks if two vertices are on the same side of the cut
+     * @param v first query vertex
+     * @param w second query vertex
+     * @exception throws std::out_of_range if graph does not contain v or w
+     */
+    bool sameSide(int v, int w) const;
+
+    /*!
+     * @function cutEdges
+     * @abstract Returns the edges between the two sides
+     * @return each cut edge once, from the side of the first vertex
+     */
+    std::vector<Edge> cutEdges() const;
+};
+
+#endif /*GLOBAL_MIN_CUT*/
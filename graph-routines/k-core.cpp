@@ -0,0 +1,175 @@
+/**k-core.cpp
+ *
+ * The k-core of an undirected graph is its largest subgraph in which
+ * every vertex has at least k neighbors. Core numbers are computed by
+ * repeatedly removing a vertex of minimum remaining degree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "k-core.hpp"
+#include "utils/parallel.hpp"
+
+// Bucket peeling over degree-sorted vertices
+void CoreDecomposition::bucketPeel()
+{
+    // Degrees at removal are the core numbers
+    g.peelOrder(cores);
+    for (int c : cores)
+        maxCore = std::max(maxCore, c);
+}
+
+// Level-synchronous peeling with atomic degrees
+void CoreDecomposition::parallelPeel(int numThreads)
+{
+    int V = g.V();
+    std::vector<std::atomic<int>> deg(V), stamp(V);
+    parallelFor(0, V, [&](size_t v, int)
+                {
+                    deg[v].store(g.simpleDegree(v), std::memory_order_relaxed);
+                    stamp[v].store(-1, std::memory_order_relaxed); },
+                numThreads);
+
+    // Lazy buckets: a vertex is added to bucket[d] whenever a level ends
+    // with its degree at d, and an entry is live only while the degree
+    // still equals d. Degrees only fall, so every vertex enters a bucket
+    // at most once per level that touches it and the total work is
+    // O(V + E + maximum degree).
+    int maxDeg = 0;
+    for (int v = 0; v < V; v++)
+        maxDeg = std::max(maxDeg, deg[v].load(std::memory_order_relaxed));
+    std::vector<std::vector<int>> bucket(maxDeg + 1);
+    for (int v = 0; v < V; v++)
+        bucket[deg[v].load(std::memory_order_relaxed)].push_back(v);
+    std::vector<int> frontier, touched;
+    std::vector<std::vector<int>> local(numThreads), localTouched(numThreads);
+
+    for (int k = 0; k <= maxDeg; k++)
+    {
+        std::vector<int> &entries = bucket[k];
+        parallelFor(0, entries.size(), [&](size_t i, int t)
+                    {
+                        if (deg[entries[i]].load(std::memory_order_relaxed) == k)
+                            local[t].push_back(entries[i]); },
+                    numThreads);
+        gather(local, frontier);
+        std::vector<int>().swap(entries);
+        if (frontier.empty())
+            continue;
+        maxCore = k;
+
+        // A neighbor is released by the one decrement that takes it from
+        // k + 1 to k; other neighbors are rebucketed once the level ends
+        while (!frontier.empty())
+        {
+            parallelFor(0, frontier.size(), [&](size_t i, int t)
+                        {
+                            int v = frontier[i];
+                            cores[v] = k;
+                            for (size_t e = g.begin(v); e < g.end(v); e++)
+                            {
+                                int w = g.target(e);
+                                if (deg[w].load(std::memory_order_relaxed) <= k)
+                                    continue;
+                                int before = deg[w].fetch_sub(1, std::memory_order_relaxed);
+                                if (before == k + 1)
+                                    local[t].push_back(w);
+                                else if (before > k + 1 && stamp[w].exchange(k, std::memory_order_relaxed) != k)
+                                    localTouched[t].push_back(w);
+                            } },
+                        numThreads, 256);
+            gather(local, frontier);
+        }
+
+        gather(localTouched, touched);
+        for (int w : touched)
+        {
+            int d = deg[w].load(std::memory_order_relaxed);
+            if (d > k)
+                bucket[d].push_back(w);
+        }
+    }
+}
+
+/*!
+ * @function CoreDecomposition
+ * @abstract Construct CoreDecomposition-type object based on an
+ *           undirected graph. Self-loops are ignored.
+ * @param target undirected graph used as input
+ * @param useParallel peel each level with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+CoreDecomposition::CoreDecomposition(const Graph &target, bool useParallel, int numThreads)
+    : g(target), cores(g.V(), 0), maxCore(0)
+{
+    if (useParallel)
+        parallelPeel(resolveThreads(numThreads));
+    else
+        bucketPeel();
+}
+
+/*!
+ * @function CoreDecomposition
+ * @abstract Copy constructor for CoreDecomposition-type object.
+ * @param other another CoreDecomposition-type object
+ */
+CoreDecomposition::CoreDecomposition(const CoreDecomposition &other)
+    : g(other.g), cores(other.cores), maxCore(other.maxCore) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for CoreDecomposition-type object.
+ * @param other another CoreDecomposition-type object
+ */
+CoreDecomposition &CoreDecomposition::operator=(const CoreDecomposition &other)
+{
+    CoreDecomposition newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->cores, newCopy.cores);
+    std::swap(this->maxCore, newCopy.maxCore);
+    return *this;
+}
+
+/*!
+ * @function coreNumber
+ * @abstract Returns the core number of v
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int CoreDecomposition::coreNumber(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Core decomposition: vertex " + std::to_string(v) + " is not in graph");
+    return cores[g.index(v)];
+}
+
+/*!
+ * @function coreNumbers
+ * @abstract Returns all core numbers ordered as in Graph::getVertices()
+ * @return core number of every vertex
+ */
+const std::vector<int> &CoreDecomposition::coreNumbers() const { return cores; }
+
+// Return the largest core number, 0 for an empty graph
+int CoreDecomposition::degeneracy() const { return maxCore; }
+
+/*!
+ * @function core
+ * @abstract Returns the vertices of the k-core
+ * @param k the minimum degree inside the core
+ * @return vertex ids with core number at least k, ordered as in
+ *         Graph::getVertices()
+ */
+std::vector<int> CoreDecomposition::core(int k) const
+{
+    std::vector<int> members;
+    for (int v = 0; v < static_cast<int>(g.V()); v++)
+        if (cores[v] >= k)
+            members.push_back(g.id(v));
+    return members;
+}
@@ -0,0 +1,92 @@
+/**k-core.hpp
+ *
+ * The k-core of an undirected graph is its largest subgraph in which
+ * every vertex has at least k neighbors. The core number of a vertex is
+ * the largest k for which it belongs to the k-core, and the largest core
+ * number is the degeneracy of the graph.
+ *
+ * The sequential mode peels vertices in order of current degree with the
+ * bucket algorithm of Batagelj and Zaversnik in O(V + E). The parallel
+ * mode removes all vertices of degree k at once, decrementing the
+ * degrees of their neighbors atomically; neighbors that drop to k are
+ * removed in the next sub-round of the same k. Vertices wait in lazy
+ * buckets by degree as in Julienne, so a level only looks at vertices
+ * whose degree it may hold and the total work stays O(V + E) plus the
+ * maximum degree.
+ */
+
+#ifndef K_CORE
+#define K_CORE
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class CoreDecomposition
+{
+private:
+    CompactDiGraph g;
+    std::vector<int> cores;
+    int maxCore;
+
+    // Bucket peeling over degree-sorted vertices
+    void bucketPeel();
+
+    // Level-synchronous peeling with atomic degrees
+    void parallelPeel(int numThreads);
+
+public:
+    /*!
+     * @function CoreDecomposition
+     * @abstract Construct CoreDecomposition-type object based on an
+     *           undirected graph. Self-loops are ignored.
+     * @param target undirected graph used as input
+     * @param useParallel peel each level with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    CoreDecomposition(const Graph &target, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function CoreDecomposition
+     * @abstract Copy constructor for CoreDecomposition-type object.
+     * @param other another CoreDecomposition-type object
+     */
+    CoreDecomposition(const CoreDecomposition &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for CoreDecomposition-type object.
+     * @param other another CoreDecomposition-type object
+     */
+    CoreDecomposition &operator=(const CoreDecomposition &other);
+
+    /*!
+     * @function coreNumber
+     * @abstract Returns the core number of v
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int coreNumber(int v) const;
+
+    /*!
+     * @function coreNumbers
+     * @abstract Returns all core numbers ordered as in Graph::getVertices()
+     * @return core number of every vertex
+     */
+    const std::vector<int> &coreNumbers() const;
+
+    // Return the largest core number, 0 for an empty graph
+    int degeneracy() const;
+
+    /*!
+     * @function core
+     * @abstract Returns the vertices of the k-core
+     * @param k the minimum degree inside the core
+     * @return vertex ids with core number at least k, ordered as in
+     *         Graph::getVertices()
+     */
+    std::vector<int> core(int k) const;
+};
+
+#endif /*K_CORE*/
@@ -0,0 +1,306 @@
+/**label-propagation.cpp
+ *
+ * Clustering by label propagation: every vertex repeatedly adopts the
+ * label carrying the largest edge weight among its neighbors.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "label-propagation.hpp"
+#include "utils/parallel.hpp"
+
+// Open-addressing table of label votes, reused across vertices by one thread
+struct LabelHistogram
+{
+    std::vector<int> keys;
+    std::vector<double> votes;
+    std::vector<size_t> used;
+    size_t mask = 0;
+
+    static size_t slot(int label) { return static_cast<uint32_t>(label) * 2654435761u >> 7; }
+
+    static uint32_t mix(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        return x ^ (x >> 16);
+    }
+
+    // Prepare for a vertex with the given degree, keeping the load below 1/2
+    void reset(size_t degree)
+    {
+        for (size_t s : used)
+            keys[s] = -1;
+        used.clear();
+        size_t capacity = 16;
+        while (capacity < 2 * degree)
+            capacity <<= 1;
+        if (capacity > keys.size())
+        {
+            keys.assign(capacity, -1);
+            votes.resize(capacity);
+        }
+        mask = capacity - 1;
+    }
+
+    void add(int label, double weight)
+    {
+        if (2 * (used.size() + 1) > mask + 1)
+            grow();
+        size_t s = slot(label) & mask;
+        while (keys[s] != -1 && keys[s] != label)
+            s = (s + 1) & mask;
+        if (keys[s] == -1)
+        {
+            keys[s] = label;
+            votes[s] = 0;
+            used.push_back(s);
+        }
+        votes[s] += weight;
+    }
+
+    // Double the active part of the table; only reached if the degree
+    // passed to reset was too small
+    void grow()
+    {
+        std::vector<std::pair<int, double>> entries;
+        for (size_t s : used)
+            entries.push_back({keys[s], votes[s]});
+        reset(mask + 1);
+        for (const std::pair<int, double> &entry : entries)
+            add(entry.first, entry.second);
+    }
+
+    // Label with the most votes; current wins ties, other ties go to the
+    // label with the larger salted hash so that no label floods the graph
+    int best(int current, uint32_t salt) const
+    {
+        int label = current;
+        double top = -1;
+        for (size_t s : used)
+        {
+            if (keys[s] == current && votes[s] >= top)
+            {
+                label = current;
+                top = votes[s];
+            }
+            else if (votes[s] > top || (votes[s] == top && label != current &&
+                                        mix(keys[s] ^ salt) > mix(label ^ salt)))
+            {
+                label = keys[s];
+                top = votes[s];
+            }
+        }
+        return label;
+    }
+};
+
+// Run passes until at most maxChanged labels change
+void LabelPropagation::propagate(const DiGraph &g, Mode mode, size_t maxChanged, int maxIterations, unsigned seed, int numThreads)
+{
+    const std::vector<Node> &vertices = g.getVertices();
+    int V = vertices.size();
+    bool identity = idToIndex.empty();
+
+    std::vector<std::atomic<int>> current(V);
+    for (int v = 0; v < V; v++)
+        current[v].store(v, std::memory_order_relaxed);
+    std::vector<int> next(mode == Mode::Synchronous ? V : 0);
+    std::vector<int> order;
+    if (mode == Mode::Asynchronous)
+    {
+        order.resize(V);
+        for (int v = 0; v < V; v++)
+            order[v] = v;
+    }
+    std::mt19937 rng(seed);
+    std::vector<LabelHistogram> histograms(numThreads);
+    std::vector<PaddedSum> changed(numThreads);
+
+    // New label of the vertex at position v given the labels in current
+    auto vote = [&](int v, int t)
+    {
+        LabelHistogram &h = histograms[t];
+        const Node &node = vertices[v];
+        h.reset(node.getOutDeg());
+        for (const Edge &edge : node.edges())
+        {
+            int w = identity ? edge.getTo() : idToIndex.find(edge.getTo())->second;
+            if (w != v)
+                h.add(current[w].load(std::memory_order_relaxed), edge.getWeight());
+        }
+        uint32_t salt = LabelHistogram::mix(seed ^ LabelHistogram::mix(v + 0x9e3779b9u * passes));
+        return h.best(current[v].load(std::memory_order_relaxed), salt);
+    };
+
+    for (passes = 0; passes < maxIterations;)
+    {
+        for (PaddedSum &c : changed)
+            c.value = 0;
+        passes++;
+
+        if (mode == Mode::Asynchronous)
+        {
+            std::shuffle(order.begin(), order.end(), rng);
+            parallelFor(0, V, [&](size_t i, int t)
+                        {
+                            int v = order[i];
+                            int label = vote(v, t);
+                            if (label != current[v].load(std::memory_order_relaxed))
+                            {
+                                current[v].store(label, std::memory_order_relaxed);
+                                changed[t].value++;
+                            } },
+                        numThreads, 4096);
+        }
+        else
+        {
+            parallelFor(0, V, [&](size_t v, int t)
+                        {
+                            next[v] = vote(v, t);
+                            if (next[v] != current[v].load(std::memory_order_relaxed))
+                                changed[t].value++; },
+                        numThreads, 4096);
+            parallelFor(0, V, [&](size_t v, int)
+                        { current[v].store(next[v], std::memory_order_relaxed); },
+                        numThreads, 4096);
+        }
+
+        double total = 0;
+        for (const PaddedSum &c : changed)
+            total += c.value;
+        if (total <= maxChanged)
+        {
+            _converged = true;
+            break;
+        }
+    }
+
+    // Number communities densely by first appearance
+    std::vector<int> dense(V, -1);
+    labels.resize(V);
+    for (int v = 0; v < V; v++)
+    {
+        int label = current[v].load(std::memory_order_relaxed);
+        if (dense[label] == -1)
+            dense[label] = _count++;
+        labels[v] = dense[label];
+    }
+}
+
+/*!
+ * @function LabelPropagation
+ * @abstract Construct LabelPropagation-type object based on a graph
+ *           and cluster its vertices. Ties between labels keep the
+ *           current label, otherwise they are broken pseudo-randomly
+ *           from the seed, the vertex and the pass.
+ * @param target graph used as input, not copied
+ * @param mode synchronous or asynchronous label updates
+ * @param threshold stop once at most this fraction of vertices changes
+ *                  label in a pass
+ * @param maxIterations upper bound on the number of passes
+ * @param seed seed for the random visiting order and tie-breaking
+ * @param useParallel update labels with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if threshold is negative or
+ *            maxIterations is not positive
+ */
+LabelPropagation::LabelPropagation(const DiGraph &target, Mode mode, double threshold,
+                                   int maxIterations, unsigned seed, bool useParallel, int numThreads)
+    : _count(0), passes(0), _converged(false)
+{
+    if (threshold < 0)
+        throw std::invalid_argument("Label propagation: threshold must not be negative");
+    if (maxIterations <= 0)
+        throw std::invalid_argument("Label propagation: maxIterations must be positive");
+
+    const std::vector<Node> &vertices = target.getVertices();
+    int V = vertices.size();
+    ids.resize(V);
+    bool identity = true;
+    for (int v = 0; v < V; v++)
+    {
+        ids[v] = vertices[v].getId();
+        identity = identity && ids[v] == v;
+    }
+    if (!identity)
+        for (int v = 0; v < V; v++)
+            idToIndex[ids[v]] = v;
+
+    propagate(target, mode, static_cast<size_t>(threshold * V), maxIterations, seed,
+              useParallel ? resolveThreads(numThreads) : 1);
+}
+
+/*!
+ * @function LabelPropagation
+ * @abstract Copy constructor for LabelPropagation-type object.
+ * @param other another LabelPropagation-type object
+ */
+LabelPropagation::LabelPropagation(const LabelPropagation &other)
+    : ids(other.ids), idToIndex(other.idToIndex), labels(other.labels), _count(other._count),
+      passes(other.passes), _converged(other._converged) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for LabelPropagation-type object.
+ * @param other another LabelPropagation-type object
+ */
+LabelPropagation &LabelPropagation::operator=(const LabelPropagation &other)
+{
+    LabelPropagation newCopy(other);
+    std::swap(this->ids, newCopy.ids);
+    std::swap(this->idToIndex, newCopy.idToIndex);
+    std::swap(this->labels, newCopy.labels);
+    std::swap(this->_count, newCopy._count);
+    std::swap(this->passes, newCopy.passes);
+    std::swap(this->_converged, newCopy._converged);
+    return *this;
+}
+
+/*!
+ * @function community
+ * @abstract Returns the community of v
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int LabelPropagation::community(int v) const
+{
+    if (idToIndex.empty())
+    {
+        if (v >= 0 && v < static_cast<int>(ids.size()))
+            return labels[v];
+    }
+    else
+    {
+        auto it = idToIndex.find(v);
+        if (it != idToIndex.end())
+            return labels[it->second];
+    }
+    throw std::out_of_range("Label propagation: vertex " + std::to_string(v) + " is not in graph");
+}
+
+/*!
+ * @function communities
+ * @abstract Returns the community of every vertex ordered as in
+ *           Graph::getVertices()
+ * @return dense labels in [0, count()), numbered by first appearance
+ */
+const std::vector<int> &LabelPropagation::communities() const { return labels; }
+
+// Return number of communities
+int LabelPropagation::count() const { return _count; }
+
+// Return number of passes performed
+int LabelPropagation::iterations() const { return passes; }
+
+// Return true if the change threshold was reached within maxIterations
+bool LabelPropagation::converged() const { return _converged; }
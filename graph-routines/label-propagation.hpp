@@ -0,0 +1,112 @@
+/**label-propagation.hpp
+ *
+ * Clustering by label propagation. Every vertex starts in its own
+ * community and repeatedly adopts the label carrying the largest total
+ * edge weight among its neighbors, until few labels change. Each pass is
+ * linear in the number of edges, which makes it a fast, coarse
+ * alternative to modularity-based community detection.
+ *
+ * The synchronous mode computes all new labels from the labels of the
+ * previous pass. The asynchronous mode updates labels in place and visits
+ * vertices in a new random order every pass, which usually converges in
+ * fewer passes and avoids the label oscillation the synchronous mode can
+ * show on bipartite structures. Votes are counted in per-thread hash
+ * histograms sized by the degree of the visited vertex.
+ *
+ * The graph is read through its adjacency lists and is neither copied nor
+ * converted to a CompactDiGraph. For a Graph labels spread over both
+ * directions of every edge; for a DiGraph a vertex only listens to its
+ * out-neighbors.
+ */
+
+#ifndef LABEL_PROPAGATION
+#define LABEL_PROPAGATION
+
+#include <unordered_map>
+#include <vector>
+#include "graph/digraph.hpp"
+
+class LabelPropagation
+{
+public:
+    enum class Mode
+    {
+        Synchronous,
+        Asynchronous
+    };
+
+private:
+    std::vector<int> ids;
+    // Empty when vertex ids equal their positions in getVertices()
+    std::unordered_map<int, int> idToIndex;
+    std::vector<int> labels;
+    int _count;
+    int passes;
+    bool _converged;
+
+    // Run passes until at most maxChanged labels change
+    void propagate(const DiGraph &g, Mode mode, size_t maxChanged, int maxIterations, unsigned seed, int numThreads);
+
+public:
+    /*!
+     * @function LabelPropagation
+     * @abstract Construct LabelPropagation-type object based on a graph
+     *           and cluster its vertices. Ties between labels keep the
+     *           current label, otherwise they are broken pseudo-randomly
+     *           from the seed, the vertex and the pass.
+     * @param target graph used as input, not copied
+     * @param mode synchronous or asynchronous label updates
+     * @param threshold stop once at most this fraction of vertices changes
+     *                  label in a pass
+     * @param maxIterations upper bound on the number of passes
+     * @param seed seed for the random visiting order and tie-breaking
+     * @param useParallel update labels with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if threshold is negative or
+     *            maxIterations is not positive
+     */
+    LabelPropagation(const DiGraph &target, Mode mode = Mode::Asynchronous, double threshold = 1e-4,
+                     int maxIterations = 100, unsigned seed = 0, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function LabelPropagation
+     * @abstract Copy constructor for LabelPropagation-type object.
+     * @param other another LabelPropagation-type object
+     */
+    LabelPropagation(const LabelPropagation &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for LabelPropagation-type object.
+     * @param other another LabelPropagation-type object
+     */
+    LabelPropagation &operator=(const LabelPropagation &other);
+
+    /*!
+     * @function community
+     * @abstract Returns the community of v
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int community(int v) const;
+
+    /*!
+     * @function communities
+     * @abstract Returns the community of every vertex ordered as in
+     *           Graph::getVertices()
+     * @return dense labels in [0, count()), numbered by first appearance
+     */
+    const std::vector<int> &communities() const;
+
+    // Return number of communities
+    int count() const;
+
+    // Return number of passes performed
+    int iterations() const;
+
+    // Return true if the change threshold was reached within maxIterations
+    bool converged() const;
+};
+
+#endif /*LABEL_PROPAGATION*/
@@ -0,0 +1,434 @@
+/**louvain.cpp
+ *
+ * Community detection by modularity maximization on a weighted undirected
+ * graph with the Louvain method: local moving, splitting of disconnected
+ * communities and contraction into a coarser graph, level by level.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "louvain.hpp"
+#include "utils/parallel.hpp"
+
+// Upper bound on sweeps of one local moving phase
+static const int MAX_SWEEPS = 64;
+// Smallest modularity gain for another sweep
+static const double MIN_GAIN = 1e-7;
+
+static void atomicAdd(std::atomic<double> &x, double delta)
+{
+    double cur = x.load(std::memory_order_relaxed);
+    while (!x.compare_exchange_weak(cur, cur + delta, std::memory_order_relaxed))
+        ;
+}
+
+// Per-thread weights from one vertex to each neighboring community
+struct CommunityWeights
+{
+    std::vector<double> weight;
+    std::vector<char> seen;
+    std::vector<int> touched;
+
+    CommunityWeights(int n) : weight(n, 0), seen(n, 0) {}
+
+    void add(int c, double w)
+    {
+        if (!seen[c])
+        {
+            seen[c] = 1;
+            touched.push_back(c);
+        }
+        weight[c] += w;
+    }
+
+    void clear()
+    {
+        for (int c : touched)
+        {
+            weight[c] = 0;
+            seen[c] = 0;
+        }
+        touched.clear();
+    }
+};
+
+// Local moving phase on one level; returns true if any vertex moved
+bool Louvain::localMoving(const CompactDiGraph &level, std::vector<int> &label, bool deterministic, int numThreads) const
+{
+    int n = level.V();
+    std::vector<double> k(n, 0);
+    double m2 = 0;
+    for (int u = 0; u < n; u++)
+    {
+        for (size_t e = level.begin(u); e < level.end(u); e++)
+            k[u] += level.weight(e);
+        m2 += k[u];
+    }
+    for (int u = 0; u < n; u++)
+        label[u] = u;
+    if (m2 == 0)
+        return false;
+
+    std::vector<std::atomic<int>> comm(n), size(n);
+    std::vector<std::atomic<double>> tot(n);
+    for (int u = 0; u < n; u++)
+    {
+        comm[u].store(u, std::memory_order_relaxed);
+        size[u].store(1, std::memory_order_relaxed);
+        tot[u].store(k[u], std::memory_order_relaxed);
+    }
+    std::vector<CommunityWeights> acc(numThreads, CommunityWeights(n));
+
+    // Community with the largest gain for u; staying wins ties, then the smaller label
+    auto best = [&](int u, CommunityWeights &a)
+    {
+        int C = comm[u].load(std::memory_order_relaxed);
+        for (size_t e = level.begin(u); e < level.end(u); e++)
+            if (level.target(e) != u)
+                a.add(comm[level.target(e)].load(std::memory_order_relaxed), level.weight(e));
+
+        double scale = resolution * k[u] / m2;
+        double inC = a.seen[C] ? a.weight[C] : 0;
+        double bestGain = inC - scale * (tot[C].load(std::memory_order_relaxed) - k[u]);
+        int bestD = C;
+        for (int D : a.touched)
+        {
+            if (D == C)
+                continue;
+            double gain = a.weight[D] - scale * tot[D].load(std::memory_order_relaxed);
+            if (gain > bestGain || (gain == bestGain && bestD != C && D < bestD))
+            {
+                bestGain = gain;
+                bestD = D;
+            }
+        }
+        a.clear();
+        return bestD;
+    };
+
+    auto snapshot = [&](std::vector<int> &out)
+    {
+        for (int u = 0; u < n; u++)
+            out[u] = comm[u].load(std::memory_order_relaxed);
+    };
+
+    bool anyMove = false;
+    double quality = modularityOf(level, label);
+    std::vector<int> target(n), current(n);
+    for (int sweep = 0; sweep < MAX_SWEEPS; sweep++)
+    {
+        std::atomic<int> moves(0);
+        if (!deterministic)
+        {
+            // Moves take effect immediately and are seen by later vertices
+            parallelFor(0, n, [&](size_t u, int t)
+                        {
+                            int C = comm[u].load(std::memory_order_relaxed);
+                            int D = best(u, acc[t]);
+                            if (D == C)
+                                return;
+                            atomicAdd(tot[C], -k[u]);
+                            atomicAdd(tot[D], k[u]);
+                            comm[u].store(D, std::memory_order_relaxed);
+                            moves.fetch_add(1, std::memory_order_relaxed); },
+                        numThreads, 256);
+        }
+        else
+        {
+            // Decide every move against the same labels, then apply them
+            // together. Two singletons may only merge into the smaller
+            // label, otherwise they could keep swapping.
+            parallelFor(0, n, [&](size_t u, int t)
+                        {
+                            int C = comm[u].load(std::memory_order_relaxed);
+                            int D = best(u, acc[t]);
+                            if (D != C && D > C && size[C].load(std::memory_order_relaxed) == 1 &&
+                                size[D].load(std::memory_order_relaxed) == 1)
+                                D = C;
+                            target[u] = D;
+                            if (D != C)
+                                moves.fetch_add(1, std::memory_order_relaxed); },
+                        numThreads, 256);
+            snapshot(current);
+            for (int c = 0; c < n; c++)
+            {
+                tot[c].store(0, std::memory_order_relaxed);
+                size[c].store(0, std::memory_order_relaxed);
+            }
+            for (int u = 0; u < n; u++)
+            {
+                comm[u].store(target[u], std::memory_order_relaxed);
+                atomicAdd(tot[target[u]], k[u]);
+                size[target[u]].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (moves.load() == 0)
+            break;
+
+        snapshot(target);
+        double next = modularityOf(level, target);
+        if (deterministic && next <= quality)
+        {
+            // Synchronous moves can conflict; discard a sweep that did not help
+            for (int u = 0; u < n; u++)
+                comm[u].store(current[u], std::memory_order_relaxed);
+            break;
+        }
+        anyMove = true;
+        bool done = next - quality < MIN_GAIN;
+        quality = next;
+        if (done)
+            break;
+    }
+
+    snapshot(label);
+    return anyMove;
+}
+
+// Split communities into connected parts and relabel densely; returns
+// the number of communities
+int Louvain::refine(const CompactDiGraph &level, std::vector<int> &label) const
+{
+    int n = level.V();
+    std::vector<int> part(n, -1), queue;
+    queue.reserve(n);
+    int count = 0;
+    for (int s = 0; s < n; s++)
+    {
+        if (part[s] != -1)
+            continue;
+        part[s] = count;
+        queue.assign(1, s);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            int u = queue[head];
+            for (size_t e = level.begin(u); e < level.end(u); e++)
+            {
+                int v = level.target(e);
+                if (part[v] == -1 && label[v] == label[u])
+                {
+                    part[v] = count;
+                    queue.push_back(v);
+                }
+            }
+        }
+        count++;
+    }
+    label.swap(part);
+    return count;
+}
+
+// Contract every community into a single vertex
+CompactDiGraph Louvain::coarsen(const CompactDiGraph &level, const std::vector<int> &label, int count, int numThreads) const
+{
+    int n = level.V();
+
+    // Members of each community, in vertex order
+    std::vector<int> start(count + 1, 0), members(n);
+    for (int u = 0; u < n; u++)
+        start[label[u] + 1]++;
+    for (int c = 0; c < count; c++)
+        start[c + 1] += start[c];
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int u = 0; u < n; u++)
+        members[fill[label[u]]++] = u;
+
+    // Community rows, including the self-loop that keeps internal weight
+    std::vector<std::vector<std::pair<int, double>>> rows(count);
+    std::vector<CommunityWeights> acc(numThreads, CommunityWeights(count));
+    parallelFor(0, count, [&](size_t c, int t)
+                {
+                    CommunityWeights &a = acc[t];
+                    for (int i = start[c]; i < start[c + 1]; i++)
+                    {
+                        int u = members[i];
+                        for (size_t e = level.begin(u); e < level.end(u); e++)
+                            a.add(label[level.target(e)], level.weight(e));
+                    }
+                    for (int D : a.touched)
+                        rows[c].push_back({D, a.weight[D]});
+                    a.clear(); },
+                numThreads, 64);
+
+    std::vector<size_t> offsets(count + 1, 0);
+    for (int c = 0; c < count; c++)
+        offsets[c + 1] = offsets[c] + rows[c].size();
+    std::vector<int> targets(offsets[count]);
+    std::vector<double> weights(offsets[count]);
+    for (int c = 0; c < count; c++)
+    {
+        for (size_t i = 0; i < rows[c].size(); i++)
+        {
+            targets[offsets[c] + i] = rows[c][i].first;
+            weights[offsets[c] + i] = rows[c][i].second;
+        }
+    }
+    return CompactDiGraph(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+// Modularity of a labeling of a level graph
+double Louvain::modularityOf(const CompactDiGraph &level, const std::vector<int> &label) const
+{
+    int n = level.V();
+    std::vector<double> in(n, 0), tot(n, 0);
+    double m2 = 0;
+    for (int u = 0; u < n; u++)
+    {
+        for (size_t e = level.begin(u); e < level.end(u); e++)
+        {
+            double w = level.weight(e);
+            m2 += w;
+            tot[label[u]] += w;
+            if (label[level.target(e)] == label[u])
+                in[label[u]] += w;
+        }
+    }
+    if (m2 == 0)
+        return 0;
+
+    double q = 0;
+    for (int c = 0; c < n; c++)
+        q += in[c] / m2 - resolution * (tot[c] / m2) * (tot[c] / m2);
+    return q;
+}
+
+/*!
+ * @function Louvain
+ * @abstract Construct Louvain-type object based on a weighted
+ *           undirected graph and detect communities level by level.
+ * @param target undirected graph used as input
+ * @param resolution weight of the expected edges in modularity
+ * @param deterministic apply moves in synchronous sweeps so that the
+ *                      result does not depend on thread scheduling
+ * @param useParallel move vertices with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if an edge weight is negative
+ *            or resolution is not positive
+ */
+Louvain::Louvain(const Graph &target, double resolution, bool deterministic, bool useParallel, int numThreads)
+    : g(target), resolution(resolution)
+{
+    if (!(resolution > 0))
+        throw std::invalid_argument("Louvain: resolution must be positive");
+    for (double w : g.getWeights())
+        if (w < 0)
+            throw std::invalid_argument("Louvain: negative edge weight " + std::to_string(w));
+    numThreads = useParallel ? resolveThreads(numThreads) : 1;
+
+    int V = g.V();
+    std::vector<int> orig(V);
+    for (int v = 0; v < V; v++)
+        orig[v] = v;
+
+    // The first level works on the snapshot itself, later ones on contractions
+    const CompactDiGraph *level = &g;
+    CompactDiGraph coarse;
+    while (level->V() > 0)
+    {
+        int n = level->V();
+        std::vector<int> label(n);
+        bool moved = localMoving(*level, label, deterministic, numThreads);
+        int count = moved ? refine(*level, label) : n;
+        if (!moved && !levelLabels.empty())
+            break;
+
+        for (int v = 0; v < V; v++)
+            orig[v] = label[orig[v]];
+        levelLabels.push_back(orig);
+        levelCounts.push_back(count);
+        levelModularity.push_back(modularityOf(g, orig));
+        if (!moved || count == n)
+            break;
+
+        coarse = coarsen(*level, label, count, numThreads);
+        level = &coarse;
+    }
+}
+
+/*!
+ * @function Louvain
+ * @abstract Copy constructor for Louvain-type object.
+ * @param other another Louvain-type object
+ */
+Louvain::Louvain(const Louvain &other)
+    : g(other.g), resolution(other.resolution), levelLabels(other.levelLabels),
+      levelCounts(other.levelCounts), levelModularity(other.levelModularity) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for Louvain-type object.
+ * @param other another Louvain-type object
+ */
+Louvain &Louvain::operator=(const Louvain &other)
+{
+    Louvain newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->resolution, newCopy.resolution);
+    std::swap(this->levelLabels, newCopy.levelLabels);
+    std::swap(this->levelCounts, newCopy.levelCounts);
+    std::swap(this->levelModularity, newCopy.levelModularity);
+    return *this;
+}
+
+// Return number of levels, 0 for an empty graph
+int Louvain::levels() const { return levelLabels.size(); }
+
+/*!
+ * @function labels
+ * @abstract Returns the community of every vertex after a level,
+ *           ordered as in Graph::getVertices(). Communities of each
+ *           level are merges of those of the previous one.
+ * @param level the level to query
+ * @return dense labels in [0, count(level))
+ * @exception throws std::out_of_range if level is not in [0, levels())
+ */
+const std::vector<int> &Louvain::labels(int level) const
+{
+    if (level < 0 || level >= levels())
+        throw std::out_of_range("Louvain: level " + std::to_string(level) + " does not exist");
+    return levelLabels[level];
+}
+
+/*!
+ * @function count
+ * @abstract Returns the number of communities after a level
+ * @param level the level to query
+ * @exception throws std::out_of_range if level is not in [0, levels())
+ */
+int Louvain::count(int level) const
+{
+    if (level < 0 || level >= levels())
+        throw std::out_of_range("Louvain: level " + std::to_string(level) + " does not exist");
+    return levelCounts[level];
+}
+
+/*!
+ * @function modularity
+ * @abstract Returns the modularity of the communities after a level
+ * @param level the level to query
+ * @exception throws std::out_of_range if level is not in [0, levels())
+ */
+double Louvain::modularity(int level) const
+{
+    if (level < 0 || level >= levels())
+        throw std::out_of_range("Louvain: level " + std::to_string(level) + " does not exist");
+    return levelModularity[level];
+}
+
+/*!
+ * @function community
+ * @abstract Returns the community of v after the last level
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int Louvain::community(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Louvain: vertex " + std::to_string(v) + " is not in graph");
+    return levelLabels.back()[g.index(v)];
+}
@@ -0,0 +1,125 @@
+/**louvain.hpp
+ *
+ * Community detection by modularity maximization on a weighted undirected
+ * graph. Modularity compares the weight of edges inside communities with
+ * the weight expected if edges were rewired at random keeping degrees;
+ * the resolution parameter scales the expected part, so larger values
+ * favor smaller communities.
+ *
+ * This routine runs the Louvain method. Each level starts with a local
+ * moving phase in which vertices repeatedly join the neighboring community
+ * with the largest modularity gain. As in the Leiden method, communities
+ * are then split into their connected parts so that no community is
+ * internally disconnected, and every community is contracted into one
+ * vertex of a new CompactDiGraph that the next level works on. Levels are
+ * added until no vertex moves.
+ *
+ * The parallel mode moves vertices concurrently, updating community
+ * labels and weights atomically, so results can differ between runs. The
+ * deterministic mode instead evaluates every vertex against a frozen copy
+ * of the labels and applies all moves together, keeping a sweep only if
+ * it raises modularity; its result does not depend on the number of
+ * threads.
+ */
+
+#ifndef LOUVAIN
+#define LOUVAIN
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class Louvain
+{
+private:
+    CompactDiGraph g;
+    double resolution;
+    std::vector<std::vector<int>> levelLabels;
+    std::vector<int> levelCounts;
+    std::vector<double> levelModularity;
+
+    // Local moving phase on one level; returns true if any vertex moved
+    bool localMoving(const CompactDiGraph &level, std::vector<int> &label, bool deterministic, int numThreads) const;
+
+    // Split communities into connected parts and relabel densely; returns
+    // the number of communities
+    int refine(const CompactDiGraph &level, std::vector<int> &label) const;
+
+    // Contract every community into a single vertex
+    CompactDiGraph coarsen(const CompactDiGraph &level, const std::vector<int> &label, int count, int numThreads) const;
+
+    // Modularity of a labeling of a level graph
+    double modularityOf(const CompactDiGraph &level, const std::vector<int> &label) const;
+
+public:
+    /*!
+     * @function Louvain
+     * @abstract Construct Louvain-type object based on a weighted
+     *           undirected graph and detect communities level by level.
+     * @param target undirected graph used as input
+     * @param resolution weight of the expected edges in modularity
+     * @param deterministic apply moves in synchronous sweeps so that the
+     *                      result does not depend on thread scheduling
+     * @param useParallel move vertices with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if an edge weight is negative
+     *            or resolution is not positive
+     */
+    Louvain(const Graph &target, double resolution = 1.0, bool deterministic = false,
+            bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function Louvain
+     * @abstract Copy constructor for Louvain-type object.
+     * @param other another Louvain-type object
+     */
+    Louvain(const Louvain &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for Louvain-type object.
+     * @param other another Louvain-type object
+     */
+    Louvain &operator=(const Louvain &other);
+
+    // Return number of levels, 0 for an empty graph
+    int levels() const;
+
+    /*!
+     * @function labels
+     * @abstract Returns the community of every vertex after a level,
+     *           ordered as in Graph::getVertices(). Communities of each
+     *           level are merges of those of the previous one.
+     * @param level the level to query
+     * @return dense labels in [0, count(level))
+     * @exception throws std::out_of_range if level is not in [0, levels())
+     */
+    const std::vector<int> &labels(int level) const;
+
+    /*!
+     * @function count
+     * @abstract Returns the number of communities after a level
+     * @param level the level to query
+     * @exception throws std::out_of_range if level is not in [0, levels())
+     */
+    int count(int level) const;
+
+    /*!
+     * @function modularity
+     * @abstract Returns the modularity of the communities after a level
+     * @param level the level to query
+     * @exception throws std::out_of_range if level is not in [0, levels())
+     */
+    double modularity(int level) const;
+
+    /*!
+     * @function community
+     * @abstract Returns the community of v after the last level
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int community(int v) const;
+};
+
+#endif /*LOUVAIN*/
@@ -0,0 +1,220 @@
+/**matching.cpp
+ *
+ * Maximum cardinality matching of a bipartite graph by Hopcroft-Karp
+ * with a greedy warm start.
+ */
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "matching.hpp"
+#include "bipartite.hpp"
+
+// Hopcroft-Karp on the left vertices and their right neighbors
+void BipartiteMatching::hopcroftKarp(const std::vector<int> &left, bool greedyStart)
+{
+    const int INF = std::numeric_limits<int>::max();
+    int V = g.V();
+    std::vector<int> &mate = mates;
+
+    if (greedyStart)
+    {
+        for (int u : left)
+        {
+            for (size_t e = g.begin(u); e < g.end(u); e++)
+            {
+                int r = g.target(e);
+                if (mate[r] == -1)
+                {
+                    mate[u] = r;
+                    mate[r] = u;
+                    _size++;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<int> dist(V, INF), queue, stack;
+    std::vector<size_t> cur(V);
+    while (true)
+    {
+        // Layer left vertices by alternating distance from a free left
+        // vertex, stopping at the first layer that reaches a free right one
+        queue.clear();
+        for (int u : left)
+        {
+            dist[u] = mate[u] == -1 ? 0 : INF;
+            if (mate[u] == -1)
+                queue.push_back(u);
+        }
+        int limit = INF;
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            int u = queue[i];
+            if (dist[u] >= limit)
+                break;
+            for (size_t e = g.begin(u); e < g.end(u); e++)
+            {
+                int next = mate[g.target(e)];
+                if (next == -1)
+                    limit = dist[u] + 1;
+                else if (dist[next] == INF)
+                {
+                    dist[next] = dist[u] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+        if (limit == INF)
+            break;
+
+        // Vertex-disjoint augmenting paths along the layers. The stack
+        // holds left vertices; the edge at cur[u] leads to the next one.
+        for (int u : left)
+            cur[u] = g.begin(u);
+        for (int root : left)
+        {
+            if (mate[root] != -1)
+                continue;
+            stack.assign(1, root);
+            while (!stack.empty())
+            {
+                int u = stack.back();
+                if (cur[u] == g.end(u))
+                {
+                    // Dead end: remove u from the layers and backtrack
+                    dist[u] = INF;
+                    stack.pop_back();
+                    if (!stack.empty())
+                        cur[stack.back()]++;
+                    continue;
+                }
+                int next = mate[g.target(cur[u])];
+                if (next == -1 && dist[u] + 1 == limit)
+                {
+                    for (int w : stack)
+                    {
+                        int r = g.target(cur[w]);
+                        mate[w] = r;
+                        mate[r] = w;
+                        dist[w] = INF;
+                    }
+                    _size++;
+                    break;
+                }
+                if (next != -1 && dist[next] == dist[u] + 1)
+                    stack.push_back(next);
+                else
+                    cur[u]++;
+            }
+        }
+    }
+}
+
+/*!
+ * @function BipartiteMatching
+ * @abstract Construct BipartiteMatching-type object based on a
+ *           bipartite undirected graph and find a maximum matching.
+ * @param target bipartite undirected graph used as input
+ * @param greedyStart match greedily before the first phase
+ * @exception throws std::invalid_argument if the graph is not bipartite
+ */
+BipartiteMatching::BipartiteMatching(const Graph &target, bool greedyStart)
+    : g(target), mates(g.V(), -1), _size(0)
+{
+    if (g.V() == 0)
+        return;
+    Bipartite sides(target);
+    if (!sides.isBipartite())
+        throw std::invalid_argument("Bipartite matching: graph is not bipartite");
+
+    std::vector<int> left;
+    left.reserve(sides.getPart1().size());
+    for (int v : sides.getPart1())
+        left.push_back(g.index(v));
+    hopcroftKarp(left, greedyStart);
+}
+
+/*!
+ * @function BipartiteMatching
+ * @abstract Copy constructor for BipartiteMatching-type object.
+ * @param other another BipartiteMatching-type object
+ */
+BipartiteMatching::BipartiteMatching(const BipartiteMatching &other)
+    : g(other.g), mates(other.mates), _size(other._size) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for BipartiteMatching-type object.
+ * @param other another BipartiteMatching-type object
+ */
+BipartiteMatching &BipartiteMatching::operator=(const BipartiteMatching &other)
+{
+    BipartiteMatching newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->mates, newCopy.mates);
+    std::swap(this->_size, newCopy._size);
+    return *this;
+}
+
+// Return number of matched edges
+int BipartiteMatching::size() const { return _size; }
+
+/*!
+ * @function isMatched
+ * @abstract Checks if v is an endpoint of a matched edge
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+bool BipartiteMatching::isMatched(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Bipartite matching: vertex " + std::to_string(v) + " is not in graph");
+    return mates[g.index(v)] != -1;
+}
+
+/*!
+ * @function mate
+ * @abstract Returns the vertex matched with v
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph,
+ *            std::logic_error if v is unmatched
+ */
+int BipartiteMatching::mate(int v) const
+{
+    if (!isMatched(v))
+        throw std::logic_error("Bipartite matching: vertex " + std::to_string(v) + " is unmatched");
+    return g.id(mates[g.index(v)]);
+}
+
+/*!
+ * @function edges
+ * @abstract Returns the matched edges, each once from the endpoint
+ *           that comes first in Graph::getVertices()
+ * @return matched edges with their weights, ordered by the first
+ *         endpoint
+ */
+std::vector<Edge> BipartiteMatching::edges() const
+{
+    std::vector<Edge> result;
+    result.reserve(_size);
+    for (int u = 0; u < static_cast<int>(g.V()); u++)
+    {
+        if (mates[u] == -1)
+            continue;
+        // Each matched edge is visited from both endpoints; keep the first
+        for (size_t e = g.begin(u); e < g.end(u); e++)
+        {
+            if (g.target(e) == mates[u])
+            {
+                if (u < mates[u])
+                    result.emplace_back(g.id(u), g.id(mates[u]), g.weight(e));
+                break;
+            }
+        }
+    }
+    return result;
+}
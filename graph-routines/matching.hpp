@@ -0,0 +1,88 @@
+/**matching.hpp
+ *
+ * A matching is a set of edges without common vertices. This routine
+ * finds a matching of maximum cardinality in a bipartite graph, using the
+ * two sets computed by Bipartite as the left and right sides.
+ *
+ * A greedy pass first matches every left vertex to its first free
+ * neighbor. Hopcroft-Karp then works in phases: a BFS from all free left
+ * vertices layers the graph by alternating path length, and depth-first
+ * searches with explicit stacks augment along a maximal set of
+ * vertex-disjoint shortest paths. There are O(sqrt(V)) phases, for
+ * O(E sqrt(V)) time overall.
+ */
+
+#ifndef MATCHING
+#define MATCHING
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class BipartiteMatching
+{
+private:
+    CompactDiGraph g;
+    // Dense index of the partner of every vertex, -1 if unmatched
+    std::vector<int> mates;
+    int _size;
+
+    // Hopcroft-Karp on the left vertices and their right neighbors
+    void hopcroftKarp(const std::vector<int> &left, bool greedyStart);
+
+public:
+    /*!
+     * @function BipartiteMatching
+     * @abstract Construct BipartiteMatching-type object based on a
+     *           bipartite undirected graph and find a maximum matching.
+     * @param target bipartite undirected graph used as input
+     * @param greedyStart match greedily before the first phase
+     * @exception throws std::invalid_argument if the graph is not bipartite
+     */
+    BipartiteMatching(const Graph &target, bool greedyStart = true);
+
+    /*!
+     * @function BipartiteMatching
+     * @abstract Copy constructor for BipartiteMatching-type object.
+     * @param other another BipartiteMatching-type object
+     */
+    BipartiteMatching(const BipartiteMatching &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for BipartiteMatching-type object.
+     * @param other another BipartiteMatching-type object
+     */
+    BipartiteMatching &operator=(const BipartiteMatching &other);
+
+    // Return number of matched edges
+    int size() const;
+
+    /*!
+     * @function isMatched
+     * @abstract Checks if v is an endpoint of a matched edge
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    bool isMatched(int v) const;
+
+    /*!
+     * @function mate
+     * @abstract Returns the vertex matched with v
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph,
+     *            std::logic_error if v is unmatched
+     */
+    int mate(int v) const;
+
+    /*!
+     * @function edges
+     * @abstract Returns the matched edges, each once from the endpoint
+     *           that comes first in Graph::getVertices()
+     * @return matched edges with their weights, ordered by the first
+     *         endpoint
+     */
+    std::vector<Edge> edges() const;
+};
+
+#endif /*MATCHING*/
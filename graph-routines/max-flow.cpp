@@ -0,0 +1,497 @@
+/**max-flow.cpp
+ *
+ * Maximum flow and minimum cut of a directed graph with edge weights as
+ * capacities, by push-relabel or Dinic's algorithm on a paired residual
+ * CSR graph.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "max-flow.hpp"
+
+// Residual arcs with paired reverse arcs
+struct MaxFlow::Residual
+{
+    // Arcs leaving vertex u are first[u] to first[u + 1] - 1
+    std::vector<size_t> first;
+    std::vector<int> head;
+    std::vector<size_t> pair;
+    std::vector<double> cap;
+    // Forward arc of every edge of the snapshot
+    std::vector<size_t> arcOf;
+
+    Residual(const CompactDiGraph &g)
+        : first(g.V() + 1, 0), head(2 * g.E()), pair(2 * g.E()), cap(2 * g.E()), arcOf(g.E())
+    {
+        int V = g.V();
+        for (int u = 0; u < V; u++)
+        {
+            for (size_t e = g.begin(u); e < g.end(u); e++)
+            {
+                first[u + 1]++;
+                first[g.target(e) + 1]++;
+            }
+        }
+        for (int u = 0; u < V; u++)
+            first[u + 1] += first[u];
+
+        std::vector<size_t> fill(first.begin(), first.end() - 1);
+        for (int u = 0; u < V; u++)
+        {
+            for (size_t e = g.begin(u); e < g.end(u); e++)
+            {
+                int v = g.target(e);
+                size_t a = fill[u]++, b = fill[v]++;
+                head[a] = v;
+                head[b] = u;
+                pair[a] = b;
+                pair[b] = a;
+                cap[a] = g.weight(e);
+                cap[b] = 0;
+                arcOf[e] = a;
+            }
+        }
+    }
+
+    // Move f units along arc a
+    void push(size_t a, double f)
+    {
+        cap[a] -= f;
+        cap[pair[a]] += f;
+    }
+};
+
+// Highest-label push-relabel with global relabeling and gap heuristics
+void MaxFlow::pushRelabel(Residual &r)
+{
+    int n = g.V();
+    std::vector<int> d(n, 0);
+    std::vector<double> excess(n, 0);
+    std::vector<size_t> cur(r.first.begin(), r.first.end() - 1);
+    std::vector<std::vector<int>> active(n);
+    int maxActive = -1;
+    // Doubly linked lists of all vertices by label below n, so a gap only
+    // visits the vertices above it
+    std::vector<int> bucket(n, -1), next(n), prev(n);
+    int maxLabel = -1;
+    size_t work = 0;
+    const size_t relabelPeriod = 6 * n + r.head.size() / 2;
+
+    auto insert = [&](int v)
+    {
+        prev[v] = -1;
+        next[v] = bucket[d[v]];
+        if (next[v] != -1)
+            prev[next[v]] = v;
+        bucket[d[v]] = v;
+        maxLabel = std::max(maxLabel, d[v]);
+    };
+
+    auto remove = [&](int v)
+    {
+        if (prev[v] != -1)
+            next[prev[v]] = next[v];
+        else
+            bucket[d[v]] = next[v];
+        if (next[v] != -1)
+            prev[next[v]] = prev[v];
+    };
+
+    auto activate = [&](int v)
+    {
+        if (v != s && v != t && d[v] < n)
+        {
+            active[d[v]].push_back(v);
+            maxActive = std::max(maxActive, d[v]);
+        }
+    };
+
+    // Exact distances to the sink by a backward BFS over residual arcs;
+    // vertices that cannot reach the sink get label n
+    auto globalRelabel = [&]()
+    {
+        std::fill(d.begin(), d.end(), n);
+        std::fill(bucket.begin(), bucket.end(), -1);
+        maxLabel = -1;
+        std::vector<int> queue(1, t);
+        d[t] = 0;
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            int w = queue[i];
+            insert(w);
+            for (size_t a = r.first[w]; a < r.first[w + 1]; a++)
+            {
+                int v = r.head[a];
+                if (d[v] == n && v != s && r.cap[r.pair[a]] > 0)
+                {
+                    d[v] = d[w] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        for (std::vector<int> &bucket : active)
+            bucket.clear();
+        maxActive = -1;
+        for (int v = 0; v < n; v++)
+        {
+            cur[v] = r.first[v];
+            if (excess[v] > 0)
+                activate(v);
+        }
+        work = 0;
+    };
+
+    // Push along admissible arcs of u starting at its current arc; returns
+    // true if all excess left u
+    auto pushFrom = [&](int u, bool phaseOne)
+    {
+        size_t a = cur[u], end = r.first[u + 1];
+        for (; a < end; a++)
+        {
+            int v = r.head[a];
+            if (r.cap[a] > 0 && d[u] == d[v] + 1)
+            {
+                double f = std::min(excess[u], r.cap[a]);
+                bool idle = excess[v] <= 0;
+                r.push(a, f);
+                excess[u] -= f;
+                excess[v] += f;
+                if (idle && phaseOne)
+                    activate(v);
+                else if (idle && v != s && v != t)
+                    active[0].push_back(v);
+                if (excess[u] <= 0)
+                    break;
+            }
+        }
+        cur[u] = a;
+        return excess[u] <= 0;
+    };
+
+    // Smallest label that makes some residual arc of u admissible
+    auto relabel = [&](int u)
+    {
+        int label = std::numeric_limits<int>::max();
+        for (size_t a = r.first[u]; a < r.first[u + 1]; a++)
+            if (r.cap[a] > 0)
+                label = std::min(label, d[r.head[a]] + 1);
+        cur[u] = r.first[u];
+        work += r.first[u + 1] - r.first[u] + 12;
+        return label;
+    };
+
+    // Phase one: maximum preflow, only vertices below label n are active
+    for (size_t a = r.first[s]; a < r.first[s + 1]; a++)
+    {
+        double f = r.cap[a];
+        if (f > 0)
+        {
+            r.push(a, f);
+            excess[r.head[a]] += f;
+            excess[s] -= f;
+        }
+    }
+    globalRelabel();
+
+    while (maxActive >= 0)
+    {
+        if (active[maxActive].empty())
+        {
+            maxActive--;
+            continue;
+        }
+        int u = active[maxActive].back();
+        active[maxActive].pop_back();
+        // Vertices lifted by a gap stay in their old bucket
+        if (d[u] != maxActive)
+            continue;
+
+        while (!pushFrom(u, true))
+        {
+            int old = d[u], label = relabel(u);
+            remove(u);
+            if (bucket[old] == -1)
+            {
+                // Nothing at label old is left, so nothing above it can
+                // reach the sink
+                for (int k = old + 1; k <= maxLabel; k++)
+                {
+                    for (int v = bucket[k]; v != -1; v = next[v])
+                        d[v] = n;
+                    bucket[k] = -1;
+                }
+                maxLabel = old - 1;
+                d[u] = n;
+                break;
+            }
+            d[u] = std::min(label, n);
+            if (d[u] == n)
+                break;
+            insert(u);
+            if (work > relabelPeriod)
+            {
+                globalRelabel();
+                break;
+            }
+        }
+    }
+    maxFlow = excess[t];
+    markCut(r);
+
+    // Phase two: return the excess left behind to the source. Labels stay
+    // valid, so a plain FIFO push-relabel without the bound on labels ends
+    // with every excess at the source.
+    std::vector<int> &queue = active[0];
+    queue.clear();
+    for (int v = 0; v < n; v++)
+    {
+        cur[v] = r.first[v];
+        if (v != s && v != t && excess[v] > 0)
+            queue.push_back(v);
+    }
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        int u = queue[i];
+        while (!pushFrom(u, false))
+            d[u] = relabel(u);
+    }
+}
+
+// Blocking flows on BFS level graphs
+void MaxFlow::dinic(Residual &r)
+{
+    int n = g.V();
+    std::vector<int> level(n), queue;
+    std::vector<size_t> cur(n), path;
+    maxFlow = 0;
+
+    while (true)
+    {
+        std::fill(level.begin(), level.end(), -1);
+        level[s] = 0;
+        queue.assign(1, s);
+        for (size_t i = 0; i < queue.size() && level[t] < 0; i++)
+        {
+            int u = queue[i];
+            for (size_t a = r.first[u]; a < r.first[u + 1]; a++)
+            {
+                int v = r.head[a];
+                if (level[v] < 0 && r.cap[a] > 0)
+                {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        if (level[t] < 0)
+            break;
+
+        // Iterative DFS keeping the arcs of the current path; after an
+        // augmentation it resumes from the tail of the first saturated arc
+        std::copy(r.first.begin(), r.first.end() - 1, cur.begin());
+        path.clear();
+        int u = s;
+        while (true)
+        {
+            if (u == t)
+            {
+                double f = std::numeric_limits<double>::infinity();
+                for (size_t a : path)
+                    f = std::min(f, r.cap[a]);
+                size_t keep = path.size();
+                for (size_t i = 0; i < path.size(); i++)
+                {
+                    r.push(path[i], f);
+                    if (keep == path.size() && r.cap[path[i]] <= 0)
+                        keep = i;
+                }
+                maxFlow += f;
+                path.resize(keep);
+                u = keep == 0 ? s : r.head[path[keep - 1]];
+                continue;
+            }
+
+            size_t &a = cur[u];
+            while (a < r.first[u + 1] && !(r.cap[a] > 0 && level[r.head[a]] == level[u] + 1))
+                a++;
+            if (a < r.first[u + 1])
+            {
+                path.push_back(a);
+                u = r.head[a];
+                continue;
+            }
+
+            // Dead end: drop u from the level graph and retreat
+            level[u] = -1;
+            if (path.empty())
+                break;
+            size_t back = path.back();
+            path.pop_back();
+            u = r.head[r.pair[back]];
+            cur[u]++;
+        }
+    }
+    markCut(r);
+}
+
+// Mark vertices that cannot reach the sink in the residual graph
+void MaxFlow::markCut(const Residual &r)
+{
+    int n = g.V();
+    std::vector<char> reaches(n, 0);
+    std::vector<int> queue(1, t);
+    reaches[t] = 1;
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        int w = queue[i];
+        for (size_t a = r.first[w]; a < r.first[w + 1]; a++)
+        {
+            int v = r.head[a];
+            if (!reaches[v] && r.cap[r.pair[a]] > 0)
+            {
+                reaches[v] = 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    sourceSide.resize(n);
+    for (int v = 0; v < n; v++)
+        sourceSide[v] = !reaches[v];
+}
+
+/*!
+ * @function MaxFlow
+ * @abstract Construct MaxFlow-type object based on a directed graph and
+ *           compute a maximum flow from source to sink.
+ * @param target directed graph whose edge weights are capacities
+ * @param source the vertex flow leaves
+ * @param sink the vertex flow enters
+ * @param algorithm push-relabel or Dinic
+ * @exception throws std::out_of_range if source or sink is not in the
+ *            graph, std::invalid_argument if source equals sink or a
+ *            capacity is negative
+ */
+MaxFlow::MaxFlow(const DiGraph &target, int source, int sink, Algorithm algorithm)
+    : g(target), maxFlow(0)
+{
+    if (!g.contains(source))
+        throw std::out_of_range("Max flow: vertex " + std::to_string(source) + " is not in graph");
+    if (!g.contains(sink))
+        throw std::out_of_range("Max flow: vertex " + std::to_string(sink) + " is not in graph");
+    if (source == sink)
+        throw std::invalid_argument("Max flow: source and sink must differ");
+    for (double w : g.getWeights())
+        if (w < 0)
+            throw std::invalid_argument("Max flow: negative capacity " + std::to_string(w));
+    s = g.index(source);
+    t = g.index(sink);
+
+    Residual r(g);
+    if (algorithm == Algorithm::PushRelabel)
+        pushRelabel(r);
+    else
+        dinic(r);
+
+    edgeFlow.resize(g.E());
+    for (size_t e = 0; e < g.E(); e++)
+        edgeFlow[e] = g.getWeights()[e] - r.cap[r.arcOf[e]];
+}
+
+/*!
+ * @function MaxFlow
+ * @abstract Copy constructor for MaxFlow-type object.
+ * @param other another MaxFlow-type object
+ */
+MaxFlow::MaxFlow(const MaxFlow &other)
+    : g(other.g), s(other.s), t(other.t), maxFlow(other.maxFlow), edgeFlow(other.edgeFlow),
+      sourceSide(other.sourceSide) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for MaxFlow-type object.
+ * @param other another MaxFlow-type object
+ */
+MaxFlow &MaxFlow::operator=(const MaxFlow &other)
+{
+    MaxFlow newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->s, newCopy.s);
+    std::swap(this->t, newCopy.t);
+    std::swap(this->maxFlow, newCopy.maxFlow);
+    std::swap(this->edgeFlow, newCopy.edgeFlow);
+    std::swap(this->sourceSide, newCopy.sourceSide);
+    return *this;
+}
+
+// Return the value of the maximum flow
+double MaxFlow::value() const { return maxFlow; }
+
+/*!
+ * @function flow
+ * @abstract Returns the flow on the edge v -> w
+ * @param v the tail of the edge
+ * @param w the head of the edge
+ * @exception throws std::out_of_range if the edge is not in the graph
+ */
+double MaxFlow::flow(int v, int w) const
+{
+    if (g.contains(v) && g.contains(w))
+    {
+        int u = g.index(v), x = g.index(w);
+        for (size_t e = g.begin(u); e < g.end(u); e++)
+            if (g.target(e) == x)
+                return edgeFlow[e];
+    }
+    throw std::out_of_range("Max flow: edge " + std::to_string(v) + "->" + std::to_string(w) + " is not in graph");
+}
+
+/*!
+ * @function flows
+ * @abstract Returns every edge that carries flow
+ * @return edges weighted by their flow, ordered as in
+ *         Graph::getVertices() by tail
+ */
+std::vector<Edge> MaxFlow::flows() const
+{
+    std::vector<Edge> result;
+    for (int u = 0; u < static_cast<int>(g.V()); u++)
+        for (size_t e = g.begin(u); e < g.end(u); e++)
+            if (edgeFlow[e] > 0)
+                result.emplace_back(g.id(u), g.id(g.target(e)), edgeFlow[e]);
+    return result;
+}
+
+/*!
+ * @function inSourceSide
+ * @abstract Check if v is on the source side of the minimum cut
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+bool MaxFlow::inSourceSide(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Max flow: vertex " + std::to_string(v) + " is not in graph");
+    return sourceSide[g.index(v)];
+}
+
+/*!
+ * @function minCut
+ * @abstract Returns the edges from the source side to the sink side of
+ *           the minimum cut; their capacities sum to value()
+ * @return cut edges weighted by their capacity
+ */
+std::vector<Edge> MaxFlow::minCut() const
+{
+    std::vector<Edge> result;
+    for (int u = 0; u < static_cast<int>(g.V()); u++)
+        if (sourceSide[u])
+            for (size_t e = g.begin(u); e < g.end(u); e++)
+                if (!sourceSide[g.target(e)])
+                    result.emplace_back(g.id(u), g.id(g.target(e)), g.weight(e));
+    return result;
+}
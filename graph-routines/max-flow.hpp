@@ -0,0 +1,128 @@
+/**max-flow.hpp
+ *
+ * Maximum flow from a source to a sink of a directed graph whose edge
+ * weights are capacities. By the max-flow min-cut theorem the flow value
+ * equals the capacity of a minimum cut, and the vertices that can still
+ * reach the sink through residual edges form the sink side of such a cut.
+ *
+ * Both algorithms work on a residual graph in CSR form in which the arc
+ * of every edge and its reverse arc are stored next to the other arcs of
+ * their tails, each holding the position of its partner.
+ *
+ * The push-relabel algorithm always discharges an active vertex of the
+ * highest label. Labels are recomputed exactly by a backward BFS from the
+ * sink after an amount of relabeling work proportional to the graph size
+ * (global relabeling), and when no vertex is left at some label, every
+ * vertex above it is lifted out of reach of the sink (gap heuristic).
+ * Vertices are kept in one list per label, so a gap only visits the
+ * vertices it lifts. The first phase ends with a maximum preflow and a
+ * minimum cut; a second phase returns the remaining excess to the source
+ * to obtain a flow.
+ *
+ * Dinic's algorithm instead repeatedly builds the BFS level graph from
+ * the source and saturates it with a blocking flow found by iterative
+ * depth-first searches.
+ */
+
+#ifndef MAX_FLOW
+#define MAX_FLOW
+
+#include <vector>
+#include "graph/digraph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class MaxFlow
+{
+public:
+    enum class Algorithm
+    {
+        PushRelabel,
+        Dinic
+    };
+
+private:
+    // Residual arcs with paired reverse arcs
+    struct Residual;
+
+    CompactDiGraph g;
+    int s, t;
+    double maxFlow;
+    std::vector<double> edgeFlow;
+    std::vector<char> sourceSide;
+
+    // Highest-label push-relabel with global relabeling and gap heuristics
+    void pushRelabel(Residual &r);
+
+    // Blocking flows on BFS level graphs
+    void dinic(Residual &r);
+
+    // Mark vertices that cannot reach the sink in the residual graph
+    void markCut(const Residual &r);
+
+public:
+    /*!
+     * @function MaxFlow
+     * @abstract Construct MaxFlow-type object based on a directed graph and
+     *           compute a maximum flow from source to sink.
+     * @param target directed graph whose edge weights are capacities
+     * @param source the vertex flow leaves
+     * @param sink the vertex flow enters
+     * @param algorithm push-relabel or Dinic
+     * @exception throws std::out_of_range if source or sink is not in the
+     *            graph, std::invalid_argument if source equals sink or a
+     *            capacity is negative
+     */
+    MaxFlow(const DiGraph &target, int source, int sink, Algorithm algorithm = Algorithm::PushRelabel);
+
+    /*!
+     * @function MaxFlow
+     * @abstract Copy constructor for MaxFlow-type object.
+     * @param other another MaxFlow-type object
+     */
+    MaxFlow(const MaxFlow &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for MaxFlow-type object.
+     * @param other another MaxFlow-type object
+     */
+    MaxFlow &operator=(const MaxFlow &other);
+
+    // Return the value of the maximum flow
+    double value() const;
+
+    /*!
+     * @function flow
+     * @abstract Returns the flow on the edge v -> w
+     * @param v the tail of the edge
+     * @param w the head of the edge
+     * @exception throws std::out_of_range if the edge is not in the graph
+     */
+    double flow(int v, int w) const;
+
+    /*!
+     * @function flows
+     * @abstract Returns every edge that carries flow
+     * @return edges weighted by their flow, ordered as in
+     *         Graph::getVertices() by tail
+     */
+    std::vector<Edge> flows() const;
+
+    /*!
+     * @function inSourceSide
+     * @abstract Check if v is on the source side of the minimum cut
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    bool inSourceSide(int v) const;
+
+    /*!
+     * @function minCut
+     * @abstract Returns the edges from the source side to the sink side of
+     *           the minimum cut; their capacities sum to value()
+     * @return cut edges weighted by their capacity
+     */
+    std::vector<Edge> minCut() const;
+};
+
+#endif /*MAX_FLOW*/
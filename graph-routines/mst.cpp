@@ -0,0 +1,320 @@
+/**mst.cpp
+ *
+ * A minimum spanning tree (MST) of a connected weighted undirected graph
+ * is a subset of its edges that connects all vertices without cycles and
+ * has the smallest total weight. A disconnected graph has a minimum
+ * spanning forest with one tree per connected component.
+ *
+ * This routine provides Kruskal, Filter-Kruskal and Boruvka. Ties between
+ * equal weights are broken by endpoint indices, so all three return the
+ * same forest.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+#include "mst.hpp"
+#include "graph/compact-digraph.hpp"
+#include "utils/parallel.hpp"
+#include "utils/uf.hpp"
+
+// Ranges below this size are sorted outright by Filter-Kruskal
+static const size_t FILTER_CUTOFF = 1 << 12;
+
+// Ranges from this size on are filtered and partitioned by several threads
+static const size_t PARALLEL_FILTER_CUTOFF = 1 << 14;
+
+// Total order on edges: weight, then endpoints
+bool MinimumSpanningTree::lighter(const WeightedEdge &a, const WeightedEdge &b)
+{
+    if (a.weight != b.weight)
+        return a.weight < b.weight;
+    if (a.v != b.v)
+        return a.v < b.v;
+    return a.w < b.w;
+}
+
+// Kruskal over the whole edge list
+void MinimumSpanningTree::kruskal(int V, std::vector<WeightedEdge> &edges, std::vector<WeightedEdge> &chosen, int numThreads)
+{
+    parallelSort(edges.begin(), edges.end(), lighter, numThreads);
+
+    UF<int> uf(V);
+    for (const WeightedEdge &e : edges)
+    {
+        if (chosen.size() + 1 >= static_cast<size_t>(V))
+            break;
+        if (!uf.isConnected(e.v, e.w))
+        {
+            uf.connect(e.v, e.w);
+            chosen.push_back(e);
+        }
+    }
+}
+
+// Quicksort-style Kruskal that filters out edges inside one component
+void MinimumSpanningTree::filterKruskal(int V, std::vector<WeightedEdge> &edges, std::vector<WeightedEdge> &chosen, int numThreads)
+{
+    UF<int> uf(V);
+    std::vector<std::pair<size_t, size_t>> ranges = {{0, edges.size()}};
+    std::vector<std::vector<WeightedEdge>> localLight(numThreads), localHeavy(numThreads);
+    std::vector<WeightedEdge> light, heavy;
+
+    // Ranges are popped light to heavy, so every edge of a range is
+    // examined after all lighter edges have been merged
+    while (!ranges.empty() && chosen.size() + 1 < static_cast<size_t>(V))
+    {
+        size_t lo = ranges.back().first, hi = ranges.back().second;
+        ranges.pop_back();
+        auto first = edges.begin() + lo;
+
+        // Median of three is neither the lightest nor the heaviest edge
+        // under a total order, so both sides are smaller than the range
+        auto medianOfThree = [&](size_t end)
+        {
+            WeightedEdge a = *first, b = edges[lo + (end - lo) / 2], c = edges[end - 1];
+            return lighter(a, b) ? (lighter(b, c) ? b : (lighter(a, c) ? c : a))
+                                 : (lighter(a, c) ? a : (lighter(b, c) ? c : b));
+        };
+
+        // Large ranges: drop edges inside one component and split around
+        // the pivot in one parallel pass. Nothing connects during the pass,
+        // so the union-find is only read.
+        if (numThreads > 1 && hi - lo >= PARALLEL_FILTER_CUTOFF)
+        {
+            WeightedEdge pivot = medianOfThree(hi);
+            parallelFor(lo, hi, [&](size_t i, int t)
+                        {
+                            const WeightedEdge &e = edges[i];
+                            if (!uf.peekConnected(e.v, e.w))
+                                (lighter(e, pivot) ? localLight[t] : localHeavy[t]).push_back(e); },
+                        numThreads);
+            gather(localLight, light);
+            gather(localHeavy, heavy);
+            std::copy(light.begin(), light.end(), first);
+            std::copy(heavy.begin(), heavy.end(), first + light.size());
+            size_t mid = lo + light.size();
+            ranges.push_back({mid, mid + heavy.size()});
+            ranges.push_back({lo, mid});
+            continue;
+        }
+
+        auto last = std::partition(first, edges.begin() + hi, [&uf](const WeightedEdge &e)
+                                   { return !uf.isConnected(e.v, e.w); });
+        hi = last - edges.begin();
+
+        if (hi - lo <= FILTER_CUTOFF)
+        {
+            std::sort(first, last, lighter);
+            for (auto it = first; it != last; ++it)
+            {
+                if (!uf.isConnected(it->v, it->w))
+                {
+                    uf.connect(it->v, it->w);
+                    chosen.push_back(*it);
+                }
+            }
+            continue;
+        }
+
+        WeightedEdge pivot = medianOfThree(hi);
+        auto middle = std::partition(first, last, [&pivot](const WeightedEdge &e)
+                                     { return lighter(e, pivot); });
+        size_t mid = middle - edges.begin();
+        ranges.push_back({mid, hi});
+        ranges.push_back({lo, mid});
+    }
+}
+
+// Lightest-edge hooking and contraction rounds
+void MinimumSpanningTree::boruvka(int V, const std::vector<WeightedEdge> &edges, std::vector<WeightedEdge> &chosen, int numThreads)
+{
+    // Working edges between current component labels, pointing into edges
+    struct Contracted
+    {
+        int cv;
+        int cw;
+        int id;
+    };
+    std::vector<Contracted> work(edges.size());
+    parallelFor(0, edges.size(), [&](size_t i, int)
+                { work[i] = {edges[i].v, edges[i].w, static_cast<int>(i)}; },
+                numThreads);
+
+    std::vector<std::atomic<int>> best(V);
+    std::vector<int> parent(V), next(V);
+    std::vector<int> active(V);
+    std::iota(active.begin(), active.end(), 0);
+    std::vector<std::vector<int>> localPicks(numThreads);
+    std::vector<std::vector<Contracted>> localWork(numThreads);
+    std::vector<int> picks;
+
+    while (!work.empty())
+    {
+        parallelFor(0, active.size(), [&](size_t i, int)
+                    { best[active[i]].store(-1, std::memory_order_relaxed); },
+                    numThreads);
+
+        // Every component keeps the position of its lightest incident edge
+        parallelFor(0, work.size(), [&](size_t i, int)
+                    {
+                        int endpoints[2] = {work[i].cv, work[i].cw};
+                        for (int c : endpoints)
+                        {
+                            int cur = best[c].load(std::memory_order_relaxed);
+                            while ((cur == -1 || lighter(edges[work[i].id], edges[work[cur].id])) &&
+                                   !best[c].compare_exchange_weak(cur, static_cast<int>(i), std::memory_order_relaxed))
+                                ;
+                        } },
+                    numThreads);
+
+        // Hook each component to the other end of its lightest edge. Two
+        // components that picked the same edge form the only possible
+        // cycle; the smaller label becomes the root and adds the edge once.
+        parallelFor(0, active.size(), [&](size_t i, int t)
+                    {
+                        int c = active[i];
+                        int e = best[c].load(std::memory_order_relaxed);
+                        parent[c] = c;
+                        if (e == -1)
+                            return;
+                        int other = work[e].cv == c ? work[e].cw : work[e].cv;
+                        bool mutual = best[other].load(std::memory_order_relaxed) == e;
+                        if (!mutual || c > other)
+                            parent[c] = other;
+                        if (!mutual || c < other)
+                            localPicks[t].push_back(work[e].id); },
+                    numThreads);
+        gather(localPicks, picks);
+        for (int id : picks)
+            chosen.push_back(edges[id]);
+
+        // Pointer jumping until every component points at its root
+        bool changed = true;
+        while (changed)
+        {
+            std::atomic<bool> anyChange(false);
+            parallelFor(0, active.size(), [&](size_t i, int)
+                        {
+                            int c = active[i];
+                            next[c] = parent[parent[c]];
+                            if (next[c] != parent[c])
+                                anyChange.store(true, std::memory_order_relaxed); },
+                        numThreads);
+            parallelFor(0, active.size(), [&](size_t i, int)
+                        { parent[active[i]] = next[active[i]]; },
+                        numThreads);
+            changed = anyChange.load();
+        }
+
+        // Contract: relabel endpoints and drop edges inside one component
+        parallelFor(0, work.size(), [&](size_t i, int t)
+                    {
+                        Contracted e = work[i];
+                        e.cv = parent[e.cv];
+                        e.cw = parent[e.cw];
+                        if (e.cv != e.cw)
+                            localWork[t].push_back(e); },
+                    numThreads);
+        gather(localWork, work);
+
+        // Roots with at least one edge carry on to the next round
+        size_t kept = 0;
+        for (int c : active)
+            if (parent[c] == c && best[c].load(std::memory_order_relaxed) != -1)
+                active[kept++] = c;
+        active.resize(kept);
+    }
+}
+
+/*!
+ * @function MinimumSpanningTree
+ * @abstract Construct MinimumSpanningTree-type object based on a
+ *           weighted undirected graph.
+ * @param target undirected graph used as input
+ * @param algorithm algorithm used to build the forest
+ * @param useParallel sort, filter, hook and contract with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+MinimumSpanningTree::MinimumSpanningTree(const Graph &target, Algorithm algorithm, bool useParallel, int numThreads)
+    : totalWeight(0)
+{
+    CompactDiGraph g(target);
+    int V = g.V();
+    numThreads = useParallel ? resolveThreads(numThreads) : 1;
+
+    // Each undirected edge once, from the smaller index; self-loops never
+    // belong to a spanning forest
+    std::vector<WeightedEdge> edges;
+    edges.reserve(g.E() / 2);
+    for (int v = 0; v < V; v++)
+        for (size_t e = g.begin(v); e < g.end(v); e++)
+            if (v < g.target(e))
+                edges.push_back({v, g.target(e), g.weight(e)});
+
+    std::vector<WeightedEdge> chosen;
+    chosen.reserve(V);
+    if (algorithm == Algorithm::Kruskal)
+        kruskal(V, edges, chosen, numThreads);
+    else if (algorithm == Algorithm::FilterKruskal)
+        filterKruskal(V, edges, chosen, numThreads);
+    else
+        boruvka(V, edges, chosen, numThreads);
+
+    std::sort(chosen.begin(), chosen.end(), lighter);
+    tree.reserve(chosen.size());
+    for (const WeightedEdge &e : chosen)
+    {
+        tree.emplace_back(g.id(e.v), g.id(e.w), e.weight);
+        totalWeight += e.weight;
+    }
+    _components = V - static_cast<int>(chosen.size());
+}
+
+/*!
+ * @function MinimumSpanningTree
+ * @abstract Copy constructor for MinimumSpanningTree-type object.
+ * @param other another MinimumSpanningTree-type object
+ */
+MinimumSpanningTree::MinimumSpanningTree(const MinimumSpanningTree &other)
+    : tree(other.tree), totalWeight(other.totalWeight), _components(other._components) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for MinimumSpanningTree-type object.
+ * @param other another MinimumSpanningTree-type object
+ */
+MinimumSpanningTree &MinimumSpanningTree::operator=(const MinimumSpanningTree &other)
+{
+    MinimumSpanningTree newCopy(other);
+    std::swap(this->tree, newCopy.tree);
+    std::swap(this->totalWeight, newCopy.totalWeight);
+    std::swap(this->_components, newCopy._components);
+    return *this;
+}
+
+/*!
+ * @function edges
+ * @abstract Returns the edges of the minimum spanning forest in
+ *           increasing order of weight
+ * @return forest edges, V - components() of them
+ */
+const std::vector<Edge> &MinimumSpanningTree::edges() const { return tree; }
+
+/*!
+ * @function weight
+ * @abstract Returns the total weight of the minimum spanning forest
+ * @return sum of the edge weights of the forest
+ */
+double MinimumSpanningTree::weight() const { return totalWeight; }
+
+/*!
+ * @function components
+ * @abstract Returns the number of trees in the forest, i.e. the number
+ *           of connected components of the graph
+ * @return number of trees, 1 if the graph is connected
+ */
+int MinimumSpanningTree::components() const { return _components; }
@@ -0,0 +1,118 @@
+/**mst.hpp
+ *
+ * A minimum spanning tree (MST) of a connected weighted undirected graph
+ * is a subset of its edges that connects all vertices without cycles and
+ * has the smallest total weight. A disconnected graph has a minimum
+ * spanning forest with one tree per connected component.
+ *
+ * This routine provides three algorithms that return the same forest.
+ * Ties between equal weights are broken by endpoint indices, so the
+ * minimum forest is unique.
+ *  - Kruskal sorts all edges, in parallel if requested, and adds them
+ *    in order through a union-find.
+ *  - Filter-Kruskal partitions the edges around a pivot weight like
+ *    quicksort and drops heavy edges whose endpoints are already
+ *    connected before sorting them, which avoids sorting most edges
+ *    of dense graphs. In parallel, large ranges are filtered and
+ *    partitioned by all threads; small ranges and the union-find
+ *    merges stay sequential.
+ *  - Boruvka lets every component pick its lightest outgoing edge in
+ *    parallel, merges along those edges and contracts, halving the
+ *    number of components in each round.
+ */
+
+#ifndef MST
+#define MST
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/node-edge.hpp"
+
+class MinimumSpanningTree
+{
+public:
+    enum class Algorithm
+    {
+        Kruskal,
+        FilterKruskal,
+        Boruvka
+    };
+
+private:
+    // Undirected edge between dense indices v < w
+    struct WeightedEdge
+    {
+        int v;
+        int w;
+        double weight;
+    };
+
+    std::vector<Edge> tree;
+    double totalWeight;
+    int _components;
+
+    // Total order on edges: weight, then endpoints
+    static bool lighter(const WeightedEdge &a, const WeightedEdge &b);
+
+    // Kruskal over the whole edge list
+    void kruskal(int V, std::vector<WeightedEdge> &edges, std::vector<WeightedEdge> &chosen, int numThreads);
+
+    // Quicksort-style Kruskal that filters out edges inside one component
+    void filterKruskal(int V, std::vector<WeightedEdge> &edges, std::vector<WeightedEdge> &chosen, int numThreads);
+
+    // Lightest-edge hooking and contraction rounds
+    void boruvka(int V, const std::vector<WeightedEdge> &edges, std::vector<WeightedEdge> &chosen, int numThreads);
+
+public:
+    /*!
+     * @function MinimumSpanningTree
+     * @abstract Construct MinimumSpanningTree-type object based on a
+     *           weighted undirected graph.
+     * @param target undirected graph used as input
+     * @param algorithm algorithm used to build the forest
+     * @param useParallel sort, filter, hook and contract with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    MinimumSpanningTree(const Graph &target, Algorithm algorithm = Algorithm::FilterKruskal,
+                        bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function MinimumSpanningTree
+     * @abstract Copy constructor for MinimumSpanningTree-type object.
+     * @param other another MinimumSpanningTree-type object
+     */
+    MinimumSpanningTree(const MinimumSpanningTree &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for MinimumSpanningTree-type object.
+     * @param other another MinimumSpanningTree-type object
+     */
+    MinimumSpanningTree &operator=(const MinimumSpanningTree &other);
+
+    /*!
+     * @function edges
+     * @abstract Returns the edges of the minimum spanning forest in
+     *           increasing order of weight
+     * @return forest edges, V - components() of them
+     */
+    const std::vector<Edge> &edges() const;
+
+    /*!
+     * @function weight
+     * @abstract Returns the total weight of the minimum spanning forest
+     * @return sum of the edge weights of the forest
+     */
+    double weight() const;
+
+    /*!
+     * @function components
+     * @abstract Returns the number of trees in the forest, i.e. the number
+     *           of connected components of the graph
+     * @return number of trees, 1 if the graph is connected
+     */
+    int components() const;
+};
+
+#endif /*MST*/
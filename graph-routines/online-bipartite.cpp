@@ -0,0 +1,196 @@
+/**online-bipartite.cpp
+ *
+ * Tracks whether an undirected graph stays bipartite while edges are
+ * streamed into it. Every vertex keeps the parity of its path to the
+ * parent in a union-find forest, so the parity between two vertices of
+ * one component is the xor along their paths to the root. Inserting an
+ * edge between two vertices of equal parity in the same component closes
+ * an odd cycle.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "online-bipartite.hpp"
+
+// Find the root of x, compressing the path and returning the parity of x to it
+int OnlineBipartite::find(int x, unsigned char &toRoot)
+{
+    int root = x;
+    toRoot = 0;
+    while (parent[root] != root)
+    {
+        toRoot ^= parity[root];
+        root = parent[root];
+    }
+
+    // Hang every vertex on the path directly below the root
+    unsigned char p = toRoot;
+    while (parent[x] != root && x != root)
+    {
+        int next = parent[x];
+        unsigned char nextParity = p ^ parity[x];
+        parent[x] = root;
+        parity[x] = p;
+        x = next;
+        p = nextParity;
+    }
+    return root;
+}
+
+// Dense index of v
+int OnlineBipartite::indexOf(int v, const char *what) const
+{
+    auto it = idToIndex.find(v);
+    if (it == idToIndex.end())
+        throw std::out_of_range(std::string(what) + ": vertex " + std::to_string(v) + " is not in graph");
+    return it->second;
+}
+
+/*!
+ * @function OnlineBipartite
+ * @abstract Construct an empty OnlineBipartite-type object
+ */
+OnlineBipartite::OnlineBipartite() : edgeCount(0), _isBipartite(true), oddEdge(0, 0) {}
+
+/*!
+ * @function OnlineBipartite
+ * @abstract Construct OnlineBipartite-type object and insert all
+ *           vertices and edges of an undirected graph
+ * @param target undirected graph used as input
+ */
+OnlineBipartite::OnlineBipartite(const Graph &target) : OnlineBipartite()
+{
+    for (const Node &node : target.getVertices())
+        insertVertex(node.getId());
+
+    // Both directions are stored, insert each edge once
+    for (const Node &node : target.getVertices())
+    {
+        int v = node.getId();
+        for (const Edge &e : node.edges())
+            if (v <= e.getTo())
+                insertEdge(v, e.getTo());
+    }
+}
+
+// Return number of vertices
+size_t OnlineBipartite::V() const { return ids.size(); }
+// Return number of inserted edges
+size_t OnlineBipartite::E() const { return edgeCount; }
+
+// Check if the structure contains v
+bool OnlineBipartite::contains(int v) const { return idToIndex.find(v) != idToIndex.end(); }
+
+/*!
+ * @function insertVertex
+ * @abstract Insert an isolated vertex with key v. Inserting an existing
+ *           vertex has no effect.
+ * @param v Key of the new vertex
+ */
+void OnlineBipartite::insertVertex(int v)
+{
+    if (contains(v))
+        return;
+
+    int x = ids.size();
+    idToIndex.insert({v, x});
+    ids.push_back(v);
+    parent.push_back(x);
+    sizes.push_back(1);
+    parity.push_back(0);
+}
+
+/*!
+ * @function insertEdge
+ * @abstract Insert the undirected edge between v and w
+ * @param v The first vertex
+ * @param w The second vertex
+ * @return true if the graph is still bipartite after the insertion
+ * @exception throws std::out_of_range if v or w is not present
+ */
+bool OnlineBipartite::insertEdge(int v, int w)
+{
+    int x = indexOf(v, "Edge insertion error");
+    int y = indexOf(w, "Edge insertion error");
+    edgeCount++;
+
+    unsigned char px, py;
+    int rx = find(x, px);
+    int ry = find(y, py);
+
+    if (rx == ry)
+    {
+        // Endpoints on the same side close an odd cycle
+        if (px == py && _isBipartite)
+        {
+            _isBipartite = false;
+            oddEdge = {v, w};
+        }
+        return _isBipartite;
+    }
+
+    // Weighted union; the parity of the hung root puts x and y on opposite sides
+    if (sizes[rx] < sizes[ry])
+        std::swap(rx, ry);
+    parent[ry] = rx;
+    parity[ry] = px ^ py ^ 1;
+    sizes[rx] += sizes[ry];
+    return _isBipartite;
+}
+
+/*!
+ * @function isBipartite
+ * @abstract Checks if the graph built so far is bipartite
+ * @return true if the graph is bipartite, false otherwise
+ */
+bool OnlineBipartite::isBipartite() const { return _isBipartite; }
+
+/*!
+ * @function firstOddEdge
+ * @abstract Returns the first inserted edge that closed an odd cycle
+ * @return the edge as passed to insertEdge
+ * @exception throws std::logic_error if the graph is still bipartite
+ */
+std::pair<int, int> OnlineBipartite::firstOddEdge() const
+{
+    if (_isBipartite)
+        throw std::logic_error("Online bipartite: graph is bipartite");
+    return oddEdge;
+}
+
+/*!
+ * @function isConnected
+ * @abstract Checks if v and w are in the same connected component
+ * @param v first query vertex
+ * @param w second query vertex
+ * @exception throws std::out_of_range if v or w is not present
+ */
+bool OnlineBipartite::isConnected(int v, int w)
+{
+    unsigned char px, py;
+    int x = indexOf(v, "Invalid bipartite query");
+    int y = indexOf(w, "Invalid bipartite query");
+    return find(x, px) == find(y, py);
+}
+
+/*!
+ * @function sameSet
+ * @abstract Checks if v and w must be on the same side of every
+ *           bipartition, i.e. they are connected by a path of even length
+ * @param v first query vertex
+ * @param w second query vertex
+ * @return true if v and w are connected and on the same side, false
+ *         otherwise or if the graph is not bipartite
+ * @exception throws std::out_of_range if v or w is not present
+ */
+bool OnlineBipartite::sameSet(int v, int w)
+{
+    unsigned char px, py;
+    int x = indexOf(v, "Invalid bipartite query");
+    int y = indexOf(w, "Invalid bipartite query");
+    if (!_isBipartite)
+        return false;
+    return find(x, px) == find(y, py) && px == py;
+}
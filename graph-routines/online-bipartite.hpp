@@ -0,0 +1,123 @@
+/**online-bipartite.hpp
+ *
+ * Tracks whether an undirected graph stays bipartite while edges are
+ * streamed into it. Every vertex keeps the parity of its path to the
+ * parent in a union-find forest, so the parity between two vertices of
+ * one component is the xor along their paths to the root. Inserting an
+ * edge between two vertices of equal parity in the same component closes
+ * an odd cycle.
+ *
+ * Union by size with path compression gives near-constant amortized time
+ * per insertion, compared to recoloring the whole graph with Bipartite.
+ * Since edges are never removed, the graph stays non-bipartite from the
+ * first odd edge on, and that edge is kept for reporting.
+ */
+
+#ifndef ONLINE_BIPARTITE
+#define ONLINE_BIPARTITE
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "graph/graph.hpp"
+
+class OnlineBipartite
+{
+private:
+    std::vector<int> ids;
+    std::unordered_map<int, int> idToIndex;
+    size_t edgeCount;
+
+    // Union-find forest; parity[x] is the side of x relative to parent[x]
+    std::vector<int> parent;
+    std::vector<int> sizes;
+    std::vector<unsigned char> parity;
+
+    bool _isBipartite;
+    std::pair<int, int> oddEdge;
+
+    // Find the root of x, compressing the path and returning the parity of x to it
+    int find(int x, unsigned char &toRoot);
+
+    // Dense index of v
+    int indexOf(int v, const char *what) const;
+
+public:
+    /*!
+     * @function OnlineBipartite
+     * @abstract Construct an empty OnlineBipartite-type object
+     */
+    OnlineBipartite();
+
+    /*!
+     * @function OnlineBipartite
+     * @abstract Construct OnlineBipartite-type object and insert all
+     *           vertices and edges of an undirected graph
+     * @param target undirected graph used as input
+     */
+    OnlineBipartite(const Graph &target);
+
+    // Return number of vertices
+    size_t V() const;
+    // Return number of inserted edges
+    size_t E() const;
+
+    // Check if the structure contains v
+    bool contains(int v) const;
+
+    /*!
+     * @function insertVertex
+     * @abstract Insert an isolated vertex with key v. Inserting an existing
+     *           vertex has no effect.
+     * @param v Key of the new vertex
+     */
+    void insertVertex(int v);
+
+    /*!
+     * @function insertEdge
+     * @abstract Insert the undirected edge between v and w
+     * @param v The first vertex
+     * @param w The second vertex
+     * @return true if the graph is still bipartite after the insertion
+     * @exception throws std::out_of_range if v or w is not present
+     */
+    bool insertEdge(int v, int w);
+
+    /*!
+     * @function isBipartite
+     * @abstract Checks if the graph built so far is bipartite
+     * @return true if the graph is bipartite, false otherwise
+     */
+    bool isBipartite() const;
+
+    /*!
+     * @function firstOddEdge
+     * @abstract Returns the first inserted edge that closed an odd cycle
+     * @return the edge as passed to insertEdge
+     * @exception throws std::logic_error if the graph is still bipartite
+     */
+    std::pair<int, int> firstOddEdge() const;
+
+    /*!
+     * @function isConnected
+     * @abstract Checks if v and w are in the same connected component
+     * @param v first query vertex
+     * @param w second query vertex
+     * @exception throws std::out_of_range if v or w is not present
+     */
+    bool isConnected(int v, int w);
+
+    /*!
+     * @function sameSet
+     * @abstract Checks if v and w must be on the same side of every
+     *           bipartition, i.e. they are connected by a path of even length
+     * @param v first query vertex
+     * @param w second query vertex
+     * @return true if v and w are connected and on the same side, false
+     *         otherwise or if the graph is not bipartite
+     * @exception throws std::out_of_range if v or w is not present
+     */
+    bool sameSet(int v, int w);
+};
+
+#endif /*ONLINE_BIPARTITE*/
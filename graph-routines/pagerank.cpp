@@ -0,0 +1,259 @@
+/**pagerank.cpp
+ *
+ * PageRank scores the vertices of a directed graph by the stationary
+ * distribution of a random surfer who follows a uniformly chosen
+ * outgoing edge with probability damping and otherwise jumps to a
+ * uniformly chosen vertex. Surfers at vertices without outgoing edges
+ * (dangling vertices) always jump.
+ *
+ * Power iteration is run as a pull-based sparse matrix-vector product
+ * over the reversed CSR snapshot. Personalized scores are approximated
+ * with the local push method of Andersen, Chung and Lang.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "pagerank.hpp"
+#include "utils/parallel.hpp"
+
+// Sum x[idx[i]] for i in [0, count)
+static double gatherSum(const int *idx, size_t count, const double *x)
+{
+    size_t i = 0;
+    double sum = 0;
+#ifdef __AVX2__
+    __m256d acc = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(idx + i));
+        acc = _mm256_add_pd(acc, _mm256_i32gather_pd(x, lanes, 8));
+    }
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+#else
+    // Independent accumulators keep the additions from serializing
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        s0 += x[idx[i]];
+        s1 += x[idx[i + 1]];
+        s2 += x[idx[i + 2]];
+        s3 += x[idx[i + 3]];
+    }
+    sum = (s0 + s1) + (s2 + s3);
+#endif
+    for (; i < count; i++)
+        sum += x[idx[i]];
+    return sum;
+}
+
+// Power iteration over the reversed snapshot
+void PageRank::powerIteration(double tolerance, int maxIterations, int numThreads)
+{
+    int N = g.V();
+    if (N == 0)
+    {
+        _converged = true;
+        return;
+    }
+
+    CompactDiGraph in = g.reverse();
+    const std::vector<size_t> &inOffsets = in.getOffsets();
+    const int *inTargets = in.getTargets().data();
+
+    scores.assign(N, 1.0 / N);
+    std::vector<double> contrib(N), next(N);
+    std::vector<PaddedSum> partial(numThreads);
+
+    while (_iterations < maxIterations)
+    {
+        // Spread each score over its out-edges; dangling mass is shared by all
+        for (PaddedSum &p : partial)
+            p.value = 0;
+        parallelFor(0, N, [&](size_t u, int t)
+                    {
+                        int deg = g.outdegree(u);
+                        if (deg == 0)
+                        {
+                            partial[t].value += scores[u];
+                            contrib[u] = 0;
+                        }
+                        else
+                            contrib[u] = scores[u] / deg; },
+                    numThreads, 4096);
+        double dangling = 0;
+        for (const PaddedSum &p : partial)
+            dangling += p.value;
+        double base = (1 - damping) / N + damping * dangling / N;
+
+        for (PaddedSum &p : partial)
+            p.value = 0;
+        parallelFor(0, N, [&](size_t v, int t)
+                    {
+                        size_t b = inOffsets[v];
+                        next[v] = base + damping * gatherSum(inTargets + b, inOffsets[v + 1] - b, contrib.data());
+                        partial[t].value += std::fabs(next[v] - scores[v]); },
+                    numThreads, 1024);
+        double delta = 0;
+        for (const PaddedSum &p : partial)
+            delta += p.value;
+
+        std::swap(scores, next);
+        _iterations++;
+        if (delta < tolerance)
+        {
+            _converged = true;
+            return;
+        }
+    }
+}
+
+/*!
+ * @function PageRank
+ * @abstract Construct PageRank-type object based on a directed graph
+ *           and run power iteration until the L1 change of the scores
+ *           drops below tolerance.
+ * @param target directed graph used as input
+ * @param damping probability of following an edge instead of jumping
+ * @param tolerance convergence threshold on the L1 change per iteration
+ * @param maxIterations upper bound on the number of iterations
+ * @param useParallel split each iteration across multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if damping is not in [0, 1)
+ */
+PageRank::PageRank(const DiGraph &target, double damping, double tolerance,
+                   int maxIterations, bool useParallel, int numThreads)
+    : g(target), damping(damping), _iterations(0), _converged(false)
+{
+    if (!(damping >= 0 && damping < 1))
+        throw std::invalid_argument("PageRank: damping " + std::to_string(damping) + " is not in [0, 1)");
+    powerIteration(tolerance, maxIterations, useParallel ? resolveThreads(numThreads) : 1);
+}
+
+/*!
+ * @function PageRank
+ * @abstract Copy constructor for PageRank-type object.
+ * @param other another PageRank-type object
+ */
+PageRank::PageRank(const PageRank &other)
+    : g(other.g), damping(other.damping), scores(other.scores),
+      _iterations(other._iterations), _converged(other._converged) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for PageRank-type object.
+ * @param other another PageRank-type object
+ */
+PageRank &PageRank::operator=(const PageRank &other)
+{
+    PageRank newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->damping, newCopy.damping);
+    std::swap(this->scores, newCopy.scores);
+    std::swap(this->_iterations, newCopy._iterations);
+    std::swap(this->_converged, newCopy._converged);
+    return *this;
+}
+
+/*!
+ * @function rank
+ * @abstract Returns the PageRank score of v. Scores sum to 1.
+ * @param v the queried vertex
+ * @return score of v
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+double PageRank::rank(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("PageRank: vertex " + std::to_string(v) + " is not in graph");
+    return scores[g.index(v)];
+}
+
+/*!
+ * @function ranks
+ * @abstract Returns all scores ordered as in DiGraph::getVertices()
+ * @return score of every vertex
+ */
+const std::vector<double> &PageRank::ranks() const { return scores; }
+
+// Return number of iterations performed
+int PageRank::iterations() const { return _iterations; }
+
+// Check if the tolerance was reached within maxIterations
+bool PageRank::converged() const { return _converged; }
+
+/*!
+ * @function personalized
+ * @abstract Approximates PageRank with all jumps going back to source.
+ *           Scores never exceed the exact ones; pushing stops once the
+ *           residual of every vertex is below epsilon times its outdegree.
+ * @param source the vertex all jumps return to
+ * @param epsilon residual threshold per unit of outdegree
+ * @return vertices with a positive score and their scores, highest first
+ * @exception throws std::out_of_range if source is not in the graph
+ * @exception throws std::invalid_argument if epsilon is not positive
+ */
+std::vector<std::pair<int, double>> PageRank::personalized(int source, double epsilon) const
+{
+    if (!g.contains(source))
+        throw std::out_of_range("PageRank: vertex " + std::to_string(source) + " is not in graph");
+    if (!(epsilon > 0))
+        throw std::invalid_argument("PageRank: epsilon must be positive");
+
+    // Sparse estimate and residual, so only visited vertices cost memory
+    std::unordered_map<int, double> estimate, residual;
+    std::deque<int> queue;
+    int s = g.index(source);
+    residual[s] = 1;
+    queue.push_back(s);
+
+    // A vertex is queued while its residual is at least epsilon per out-edge
+    auto above = [&](int u, double r)
+    { return r >= epsilon * std::max(g.outdegree(u), 1); };
+
+    while (!queue.empty())
+    {
+        int u = queue.front();
+        queue.pop_front();
+        double r = residual[u];
+        if (!above(u, r))
+            continue;
+
+        // Keep the restart share and pass the rest along the out-edges;
+        // a dangling vertex restarts at the source
+        estimate[u] += (1 - damping) * r;
+        residual[u] = 0;
+        auto push = [&](int w, double amount)
+        {
+            double &rw = residual[w];
+            bool wasQueued = above(w, rw);
+            rw += amount;
+            if (!wasQueued && above(w, rw))
+                queue.push_back(w);
+        };
+        int deg = g.outdegree(u);
+        if (deg == 0)
+            push(s, damping * r);
+        for (size_t e = g.begin(u); e < g.end(u); e++)
+            push(g.target(e), damping * r / deg);
+    }
+
+    std::vector<std::pair<int, double>> result;
+    result.reserve(estimate.size());
+    for (const std::pair<const int, double> &entry : estimate)
+        result.push_back({g.id(entry.first), entry.second});
+    std::sort(result.begin(), result.end(), [](const std::pair<int, double> &a, const std::pair<int, double> &b)
+              { return a.second != b.second ? a.second > b.second : a.first < b.first; });
+    return result;
+}
@@ -0,0 +1,110 @@
+/**pagerank.hpp
+ *
+ * PageRank scores the vertices of a directed graph by the stationary
+ * distribution of a random surfer who follows a uniformly chosen
+ * outgoing edge with probability damping and otherwise jumps to a
+ * uniformly chosen vertex. Surfers at vertices without outgoing edges
+ * (dangling vertices) always jump.
+ *
+ * This routine runs power iteration as a pull-based sparse matrix-vector
+ * product: every vertex sums the contributions of its in-neighbors over
+ * the reversed CSR snapshot, so each iteration writes every score exactly
+ * once and vertices can be split across threads without synchronization.
+ * When compiled with AVX2 enabled (e.g. -mavx2) the inner sum uses vector
+ * gathers.
+ *
+ * For local queries, personalized() approximates PageRank with restarts
+ * to a single source by the push method of Andersen, Chung and Lang. It
+ * only touches vertices near the source, so its cost is independent of
+ * the size of the graph.
+ */
+
+#ifndef PAGERANK
+#define PAGERANK
+
+#include <utility>
+#include <vector>
+#include "graph/digraph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class PageRank
+{
+private:
+    CompactDiGraph g;
+    double damping;
+    std::vector<double> scores;
+    int _iterations;
+    bool _converged;
+
+    // Power iteration over the reversed snapshot
+    void powerIteration(double tolerance, int maxIterations, int numThreads);
+
+public:
+    /*!
+     * @function PageRank
+     * @abstract Construct PageRank-type object based on a directed graph
+     *           and run power iteration until the L1 change of the scores
+     *           drops below tolerance.
+     * @param target directed graph used as input
+     * @param damping probability of following an edge instead of jumping
+     * @param tolerance convergence threshold on the L1 change per iteration
+     * @param maxIterations upper bound on the number of iterations
+     * @param useParallel split each iteration across multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if damping is not in [0, 1)
+     */
+    PageRank(const DiGraph &target, double damping = 0.85, double tolerance = 1e-10,
+             int maxIterations = 100, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function PageRank
+     * @abstract Copy constructor for PageRank-type object.
+     * @param other another PageRank-type object
+     */
+    PageRank(const PageRank &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for PageRank-type object.
+     * @param other another PageRank-type object
+     */
+    PageRank &operator=(const PageRank &other);
+
+    /*!
+     * @function rank
+     * @abstract Returns the PageRank score of v. Scores sum to 1.
+     * @param v the queried vertex
+     * @return score of v
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    double rank(int v) const;
+
+    /*!
+     * @function ranks
+     * @abstract Returns all scores ordered as in DiGraph::getVertices()
+     * @return score of every vertex
+     */
+    const std::vector<double> &ranks() const;
+
+    // Return number of iterations performed
+    int iterations() const;
+
+    // Check if the tolerance was reached within maxIterations
+    bool converged() const;
+
+    /*!
+     * @function personalized
+     * @abstract Approximates PageRank with all jumps going back to source.
+     *           Scores never exceed the exact ones; pushing stops once the
+     *           residual of every vertex is below epsilon times its outdegree.
+     * @param source the vertex all jumps return to
+     * @param epsilon residual threshold per unit of outdegree
+     * @return vertices with a positive score and their scores, highest first
+     * @exception throws std::out_of_range if source is not in the graph
+     * @exception throws std::invalid_argument if epsilon is not positive
+     */
+    std::vector<std::pair<int, double>> personalized(int source, double epsilon = 1e-6) const;
+};
+
+#endif /*PAGERANK*/
@@ -0,0 +1,607 @@
+/**planarity.cpp
+ *
+ * A graph is planar if it can be drawn in the plane without any two
+ * edges crossing. A planar drawing is described combinatorially by a
+ * rotation system: the clockwise order of the neighbors around each
+ * vertex. By Kuratowski's theorem a graph is non-planar exactly when it
+ * contains a subdivision of K5 or K3,3.
+ *
+ * This routine runs the left-right planarity test (Brandes, "The
+ * Left-Right Planarity Test") with explicit stacks in place of the
+ * recursive depth-first searches.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "planarity.hpp"
+
+/**
+ * Rotation system primitives
+ */
+
+// Insert half-edge h at v clockwise after reference (-1 if v has none yet)
+void Planarity::addHalfEdgeCw(int v, int h, int reference)
+{
+    if (reference == -1)
+    {
+        cw[h] = ccw[h] = h;
+        firstHalf[v] = h;
+        return;
+    }
+    int next = cw[reference];
+    cw[reference] = h;
+    cw[h] = next;
+    ccw[next] = h;
+    ccw[h] = reference;
+}
+
+// Insert half-edge h at v counterclockwise before reference
+void Planarity::addHalfEdgeCcw(int v, int h, int reference)
+{
+    if (reference == -1)
+    {
+        addHalfEdgeCw(v, h, -1);
+        return;
+    }
+    addHalfEdgeCw(v, h, ccw[reference]);
+    if (reference == firstHalf[v])
+        firstHalf[v] = h;
+}
+
+// Vertex a half-edge points to
+int Planarity::halfTarget(int h) const { return h % 2 == 0 ? head[h / 2] : tail[h / 2]; }
+
+// Dense index of vertex id v, -1 if absent
+int Planarity::indexOf(int v) const
+{
+    if (denseIds)
+        return v >= 0 && v < n ? v : -1;
+    auto it = std::lower_bound(idIndex.begin(), idIndex.end(), std::make_pair(v, -1));
+    if (it == idIndex.end() || it->first != v)
+        return -1;
+    return it->second;
+}
+
+/**
+ * Left-right algorithm
+ */
+
+// DFS orientation: orient edges, compute heights, lowpoints and nesting depths
+void Planarity::orient()
+{
+    for (int root = 0; root < n; root++)
+    {
+        if (height[root] != -1)
+            continue;
+        height[root] = 0;
+        roots.push_back(root);
+
+        dfsStack.assign(1, root);
+        while (!dfsStack.empty())
+        {
+            int v = dfsStack.back();
+            int finished = -1;
+
+            if (cursor[v] < incOffsets[v + 1])
+            {
+                int vw = incidence[cursor[v]++];
+                if (tail[vw] != -1) // Already oriented from the other side
+                    continue;
+                int w = edges[vw].first == v ? edges[vw].second : edges[vw].first;
+                tail[vw] = v;
+                head[vw] = w;
+                lowpt[vw] = lowpt2[vw] = height[v];
+
+                if (height[w] == -1)
+                {
+                    // Tree edge: finish it once w is done
+                    parentEdge[w] = vw;
+                    height[w] = height[v] + 1;
+                    dfsStack.push_back(w);
+                    continue;
+                }
+                lowpt[vw] = height[w]; // Back edge
+                finished = vw;
+            }
+            else
+            {
+                dfsStack.pop_back();
+                finished = parentEdge[v];
+                if (finished == -1)
+                    continue;
+                v = tail[finished];
+            }
+
+            // Nesting depth of the finished edge and lowpoints of v's parent edge
+            int vw = finished;
+            nesting[vw] = 2 * lowpt[vw] + (lowpt2[vw] < height[v] ? 1 : 0);
+            int e = parentEdge[v];
+            if (e != -1)
+            {
+                if (lowpt[vw] < lowpt[e])
+                {
+                    lowpt2[e] = std::min(lowpt[e], lowpt2[vw]);
+                    lowpt[e] = lowpt[vw];
+                }
+                else if (lowpt[vw] > lowpt[e])
+                    lowpt2[e] = std::min(lowpt2[e], lowpt[vw]);
+                else
+                    lowpt2[e] = std::min(lowpt2[e], lowpt2[vw]);
+            }
+        }
+    }
+}
+
+// Order the outgoing oriented edges of every vertex by nesting depth
+void Planarity::sortOutEdges()
+{
+    // Counting sort of all active edges by depth, which lies in
+    // [-(2n + 1), 2n + 1] once signs are applied
+    int shift = 2 * n + 1;
+    depthOffsets.assign(2 * shift + 2, 0);
+    for (size_t e = 0; e < edges.size(); e++)
+        if (activeEdge[e])
+            depthOffsets[nesting[e] + shift + 1]++;
+    for (int d = 0; d <= 2 * shift; d++)
+        depthOffsets[d + 1] += depthOffsets[d];
+    depthOrder.resize(depthOffsets.back());
+    for (size_t e = 0; e < edges.size(); e++)
+        if (activeEdge[e])
+            depthOrder[depthOffsets[nesting[e] + shift]++] = e;
+
+    // Distributing the sorted edges by tail keeps every row in depth order
+    outOffsets.assign(n + 1, 0);
+    for (int e : depthOrder)
+        outOffsets[tail[e] + 1]++;
+    for (int v = 0; v < n; v++)
+        outOffsets[v + 1] += outOffsets[v];
+
+    outEdges.resize(outOffsets[n]);
+    cursor.assign(outOffsets.begin(), outOffsets.end() - 1);
+    for (int e : depthOrder)
+        outEdges[cursor[tail[e]]++] = e;
+}
+
+// Merge the return edges of ei into the conflict pairs of the siblings
+bool Planarity::addConstraints(int ei, int e)
+{
+    auto isEmpty = [](const Interval &I)
+    { return I.low == -1 && I.high == -1; };
+    auto conflicting = [&](const Interval &I, int b)
+    { return !isEmpty(I) && lowpt[I.high] > lowpt[b]; };
+
+    ConflictPair P = {{-1, -1}, {-1, -1}};
+
+    // Merge return edges of ei into P.right
+    do
+    {
+        ConflictPair Q = conflicts.back();
+        conflicts.pop_back();
+        if (!isEmpty(Q.left))
+            std::swap(Q.left, Q.right);
+        if (!isEmpty(Q.left))
+            return false;
+        if (lowpt[Q.right.low] > lowpt[e])
+        {
+            if (isEmpty(P.right))
+                P.right = Q.right;
+            else
+                ref[P.right.low] = Q.right.high;
+            P.right.low = Q.right.low;
+        }
+        else
+            ref[Q.right.low] = lowptEdge[e];
+    } while (conflicts.size() != stackBottom[ei]);
+
+    // Merge conflicting return edges of earlier siblings into P.left
+    while (!conflicts.empty() &&
+           (conflicting(conflicts.back().left, ei) || conflicting(conflicts.back().right, ei)))
+    {
+        ConflictPair Q = conflicts.back();
+        conflicts.pop_back();
+        if (conflicting(Q.right, ei))
+            std::swap(Q.left, Q.right);
+        if (conflicting(Q.right, ei))
+            return false;
+
+        if (P.right.low != -1)
+            ref[P.right.low] = Q.right.high;
+        if (Q.right.low != -1)
+            P.right.low = Q.right.low;
+        if (isEmpty(P.left))
+            P.left = Q.left;
+        else if (P.left.low != -1)
+            ref[P.left.low] = Q.left.high;
+        P.left.low = Q.left.low;
+    }
+
+    if (!(isEmpty(P.left) && isEmpty(P.right)))
+        conflicts.push_back(P);
+    return true;
+}
+
+// Drop back edges returning to the tail of e and fix the side of e
+void Planarity::removeBackEdges(int e)
+{
+    int u = tail[e];
+    auto isEmpty = [](const Interval &I)
+    { return I.low == -1 && I.high == -1; };
+    auto lowest = [&](const ConflictPair &P)
+    {
+        if (isEmpty(P.left) && isEmpty(P.right))
+            return std::numeric_limits<int>::max();
+        if (isEmpty(P.left))
+            return lowpt[P.right.low];
+        if (isEmpty(P.right))
+            return lowpt[P.left.low];
+        return std::min(lowpt[P.left.low], lowpt[P.right.low]);
+    };
+
+    // Drop entire conflict pairs
+    while (!conflicts.empty() && lowest(conflicts.back()) == height[u])
+    {
+        ConflictPair P = conflicts.back();
+        conflicts.pop_back();
+        if (P.left.low != -1)
+            side[P.left.low] = -1;
+    }
+
+    // One more conflict pair to consider
+    if (!conflicts.empty())
+    {
+        ConflictPair P = conflicts.back();
+        conflicts.pop_back();
+
+        // Trim left interval
+        while (P.left.high != -1 && head[P.left.high] == u)
+            P.left.high = ref[P.left.high];
+        if (P.left.high == -1 && P.left.low != -1)
+        {
+            ref[P.left.low] = P.right.low;
+            side[P.left.low] = -1;
+            P.left.low = -1;
+        }
+
+        // Trim right interval
+        while (P.right.high != -1 && head[P.right.high] == u)
+            P.right.high = ref[P.right.high];
+        if (P.right.high == -1 && P.right.low != -1)
+        {
+            ref[P.right.low] = P.left.low;
+            side[P.right.low] = -1;
+            P.right.low = -1;
+        }
+        conflicts.push_back(P);
+    }
+
+    // Side of e is the side of a highest return edge
+    if (lowpt[e] < height[u] && !conflicts.empty())
+    {
+        int hl = conflicts.back().left.high;
+        int hr = conflicts.back().right.high;
+        if (hl != -1 && (hr == -1 || lowpt[hl] > lowpt[hr]))
+            ref[e] = hl;
+        else
+            ref[e] = hr;
+    }
+}
+
+// Testing phase from one DFS root: build and merge constraints
+bool Planarity::testing(int root)
+{
+    dfsStack.assign(1, root);
+    while (!dfsStack.empty())
+    {
+        int v = dfsStack.back();
+        dfsStack.pop_back();
+        int e = parentEdge[v];
+        bool descended = false;
+
+        for (; cursor[v] < outOffsets[v + 1]; cursor[v]++)
+        {
+            int ei = outEdges[cursor[v]];
+            int w = head[ei];
+            if (!skipInit[ei])
+            {
+                stackBottom[ei] = conflicts.size();
+                if (ei == parentEdge[w])
+                {
+                    // Tree edge: visit w, then come back to ei
+                    dfsStack.push_back(v);
+                    dfsStack.push_back(w);
+                    skipInit[ei] = 1;
+                    descended = true;
+                    break;
+                }
+                lowptEdge[ei] = ei; // Back edge
+                conflicts.push_back({{-1, -1}, {ei, ei}});
+            }
+
+            // Integrate new return edges
+            if (lowpt[ei] < height[v])
+            {
+                if (cursor[v] == outOffsets[v])
+                    lowptEdge[e] = lowptEdge[ei];
+                else if (!addConstraints(ei, e))
+                    return false;
+            }
+        }
+
+        if (!descended && e != -1)
+            removeBackEdges(e);
+    }
+    return true;
+}
+
+// Resolve the side of e relative to its parent through the ref chain
+int Planarity::sign(int e)
+{
+    // Walk to the end of the chain, then fold sides back without recursion
+    dfsStack.clear();
+    for (int cur = e; ref[cur] != -1; cur = ref[cur])
+        dfsStack.push_back(cur);
+    for (size_t i = dfsStack.size(); i-- > 0;)
+    {
+        int cur = dfsStack[i];
+        side[cur] *= side[ref[cur]];
+        ref[cur] = -1;
+    }
+    return side[e];
+}
+
+// Embedding phase from one DFS root: place the incoming half of every edge
+void Planarity::embedding(int root)
+{
+    dfsStack.assign(1, root);
+    while (!dfsStack.empty())
+    {
+        int v = dfsStack.back();
+        dfsStack.pop_back();
+        while (cursor[v] < outOffsets[v + 1])
+        {
+            int ei = outEdges[cursor[v]++];
+            int w = head[ei];
+            if (ei == parentEdge[w])
+            {
+                // Tree edge: first neighbor of w is its parent
+                addHalfEdgeCcw(w, 2 * ei + 1, firstHalf[w]);
+                leftRef[v] = rightRef[v] = 2 * ei;
+                dfsStack.push_back(v);
+                dfsStack.push_back(w);
+                break;
+            }
+
+            // Back edge: place at w next to the subtree it returns from
+            if (side[ei] == 1)
+                addHalfEdgeCw(w, 2 * ei + 1, rightRef[w]);
+            else
+            {
+                addHalfEdgeCcw(w, 2 * ei + 1, leftRef[w]);
+                leftRef[w] = 2 * ei + 1;
+            }
+        }
+    }
+}
+
+// Left-right test over the active edges, optionally building the rotation system
+bool Planarity::lrTest(bool embed)
+{
+    size_t m = 0;
+    for (char a : activeEdge)
+        m += a;
+    if (n > 2 && m > 3 * static_cast<size_t>(n) - 6)
+        return false;
+
+    // Incidence lists of active edges
+    incOffsets.assign(n + 1, 0);
+    for (size_t e = 0; e < edges.size(); e++)
+    {
+        if (!activeEdge[e])
+            continue;
+        incOffsets[edges[e].first + 1]++;
+        incOffsets[edges[e].second + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+        incOffsets[v + 1] += incOffsets[v];
+    incidence.resize(incOffsets[n]);
+    cursor.assign(incOffsets.begin(), incOffsets.end() - 1);
+    for (size_t e = 0; e < edges.size(); e++)
+    {
+        if (!activeEdge[e])
+            continue;
+        incidence[cursor[edges[e].first]++] = e;
+        incidence[cursor[edges[e].second]++] = e;
+    }
+
+    // Reset state
+    size_t edgeSlots = edges.size();
+    height.assign(n, -1);
+    parentEdge.assign(n, -1);
+    cursor.assign(incOffsets.begin(), incOffsets.end() - 1);
+    roots.clear();
+    tail.assign(edgeSlots, -1);
+    head.assign(edgeSlots, -1);
+    lowpt.assign(edgeSlots, 0);
+    lowpt2.assign(edgeSlots, 0);
+    nesting.assign(edgeSlots, 0);
+    ref.assign(edgeSlots, -1);
+    side.assign(edgeSlots, 1);
+    lowptEdge.assign(edgeSlots, -1);
+    stackBottom.assign(edgeSlots, 0);
+    skipInit.assign(edgeSlots, 0);
+    conflicts.clear();
+
+    orient();
+    sortOutEdges();
+
+    cursor.assign(outOffsets.begin(), outOffsets.end() - 1);
+    for (int root : roots)
+        if (!testing(root))
+            return false;
+    if (!embed)
+        return true;
+
+    // Signed nesting depths give the final order of outgoing edges
+    for (size_t e = 0; e < edgeSlots; e++)
+        if (activeEdge[e])
+            nesting[e] *= sign(e);
+    sortOutEdges();
+
+    cw.assign(2 * edgeSlots, -1);
+    ccw.assign(2 * edgeSlots, -1);
+    firstHalf.assign(n, -1);
+    leftRef.assign(n, -1);
+    rightRef.assign(n, -1);
+    for (int v = 0; v < n; v++)
+    {
+        int prev = -1;
+        for (int i = outOffsets[v]; i < outOffsets[v + 1]; i++)
+        {
+            addHalfEdgeCw(v, 2 * outEdges[i], prev);
+            prev = 2 * outEdges[i];
+        }
+    }
+
+    cursor.assign(outOffsets.begin(), outOffsets.end() - 1);
+    for (int root : roots)
+        embedding(root);
+
+    // Flatten the circular lists
+    rotOffsets.assign(n + 1, 0);
+    rotNeighbors.clear();
+    for (int v = 0; v < n; v++)
+    {
+        int h = firstHalf[v];
+        if (h != -1)
+        {
+            do
+            {
+                rotNeighbors.push_back(halfTarget(h));
+                h = cw[h];
+            } while (h != firstHalf[v]);
+        }
+        rotOffsets[v + 1] = rotNeighbors.size();
+    }
+    return true;
+}
+
+/*!
+ * @function Planarity
+ * @abstract Construct an empty Planarity-type object to be reused
+ *           through test()
+ */
+Planarity::Planarity() : n(0), denseIds(true), _isPlanar(true) {}
+
+/*!
+ * @function Planarity
+ * @abstract Construct Planarity-type object based on an
+ * undirected graph.
+ * @param target undirected graph used as input
+ */
+Planarity::Planarity(const Graph &target) : n(0), denseIds(true), _isPlanar(true) { test(target); }
+
+/*!
+ * @function test
+ * @abstract Test another graph, reusing the buffers of this object
+ * @param target undirected graph used as input
+ * @return true if target is planar, false otherwise
+ */
+bool Planarity::test(const Graph &target)
+{
+    const std::vector<Node> &vertices = target.getVertices();
+    n = vertices.size();
+
+    // Ids 0 to n - 1 in order need no lookup table
+    ids.clear();
+    denseIds = true;
+    for (int v = 0; v < n; v++)
+    {
+        ids.push_back(vertices[v].getId());
+        denseIds = denseIds && ids[v] == v;
+    }
+    idIndex.clear();
+    if (!denseIds)
+    {
+        for (int v = 0; v < n; v++)
+            idIndex.push_back({ids[v], v});
+        std::sort(idIndex.begin(), idIndex.end());
+    }
+
+    // Keep one copy of every undirected edge, skipping self-loops
+    edges.clear();
+    for (int v = 0; v < n; v++)
+    {
+        for (const Edge &e : vertices[v].edges())
+        {
+            int w = target.indexOf(e.getTo());
+            if (v < w)
+                edges.push_back({v, w});
+        }
+    }
+    activeEdge.assign(edges.size(), 1);
+
+    rotOffsets.assign(n + 1, 0);
+    rotNeighbors.clear();
+    _isPlanar = lrTest(true);
+    return _isPlanar;
+}
+
+/*!
+ * @function isPlanar
+ * @abstract Checks if the last tested graph is planar
+ * @return true if the graph is planar, false otherwise
+ */
+bool Planarity::isPlanar() const { return _isPlanar; }
+
+/*!
+ * @function rotation
+ * @abstract Returns the neighbors of v in clockwise order of a planar
+ *           embedding. Empty if the graph is not planar.
+ * @param v the queried vertex
+ * @return neighbors of v in clockwise order
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+std::vector<int> Planarity::rotation(int v) const
+{
+    int idx = indexOf(v);
+    if (idx == -1)
+        throw std::out_of_range("Planarity: vertex " + std::to_string(v) + " is not in graph");
+
+    std::vector<int> order;
+    if (!_isPlanar)
+        return order;
+    for (int i = rotOffsets[idx]; i < rotOffsets[idx + 1]; i++)
+        order.push_back(ids[rotNeighbors[i]]);
+    return order;
+}
+
+/*!
+ * @function kuratowskiSubgraph
+ * @abstract Returns the edges of a subdivision of K5 or K3,3 contained
+ *           in a non-planar graph. Runs one planarity test per edge.
+ * @return edges of the Kuratowski subgraph, empty if the graph is planar
+ */
+std::vector<std::pair<int, int>> Planarity::kuratowskiSubgraph()
+{
+    std::vector<std::pair<int, int>> subgraph;
+    if (_isPlanar)
+        return subgraph;
+
+    // An edge whose removal keeps the graph non-planar is not needed.
+    // What is left is minimally non-planar, i.e. a Kuratowski subdivision.
+    activeEdge.assign(edges.size(), 1);
+    for (size_t e = 0; e < edges.size(); e++)
+    {
+        activeEdge[e] = 0;
+        if (lrTest(false))
+            activeEdge[e] = 1;
+    }
+
+    for (size_t e = 0; e < edges.size(); e++)
+        if (activeEdge[e])
+            subgraph.push_back({ids[edges[e].first], ids[edges[e].second]});
+    return subgraph;
+}
@@ -0,0 +1,163 @@
+/**planarity.hpp
+ *
+ * A graph is planar if it can be drawn in the plane without any two
+ * edges crossing. A planar drawing is described combinatorially by a
+ * rotation system: the clockwise order of the neighbors around each
+ * vertex. By Kuratowski's theorem a graph is non-planar exactly when it
+ * contains a subdivision of K5 or K3,3.
+ *
+ * This routine runs the left-right planarity test in O(V + E) after
+ * rejecting graphs with E > 3V - 6 outright. Vertex ids other than 0 to
+ * V - 1 in order are indexed by sorting them, which adds O(V log V). Planar graphs come with a
+ * rotation system; for non-planar graphs a Kuratowski subgraph can be
+ * extracted on demand by repeatedly dropping edges that are not needed
+ * for non-planarity, which costs one test per edge.
+ *
+ * All buffers are kept between calls to test(), so one Planarity object
+ * can check many graphs without reallocating once it has seen the
+ * largest of them. Self-loops do not affect planarity and are ignored.
+ */
+
+#ifndef PLANARITY
+#define PLANARITY
+
+#include <utility>
+#include <vector>
+#include "graph/graph.hpp"
+
+class Planarity
+{
+private:
+    // Conflict pairs of return-edge intervals, -1 marks an empty end
+    struct Interval
+    {
+        int low;
+        int high;
+    };
+    struct ConflictPair
+    {
+        Interval left;
+        Interval right;
+    };
+
+    // Input in dense indices
+    int n;
+    std::vector<int> ids;
+    std::vector<std::pair<int, int>> idIndex;
+    bool denseIds;
+    std::vector<std::pair<int, int>> edges;
+    std::vector<char> activeEdge;
+    bool _isPlanar;
+
+    // Incidence lists of active edges
+    std::vector<int> incOffsets;
+    std::vector<int> incidence;
+
+    // Per-vertex DFS state
+    std::vector<int> height;
+    std::vector<int> parentEdge;
+    std::vector<int> cursor;
+    std::vector<int> roots;
+    std::vector<int> dfsStack;
+
+    // Per-edge state; each edge is oriented from tail to head by the DFS
+    std::vector<int> tail;
+    std::vector<int> head;
+    std::vector<int> lowpt;
+    std::vector<int> lowpt2;
+    std::vector<int> nesting;
+    std::vector<int> ref;
+    std::vector<int> side;
+    std::vector<int> lowptEdge;
+    std::vector<size_t> stackBottom;
+    std::vector<char> skipInit;
+    std::vector<ConflictPair> conflicts;
+
+    // Oriented outgoing edges of each vertex ordered by nesting depth,
+    // bucketed by depth first
+    std::vector<int> depthOffsets;
+    std::vector<int> depthOrder;
+    std::vector<int> outOffsets;
+    std::vector<int> outEdges;
+
+    // Rotation system as circular lists of half-edges; half-edge 2e lives
+    // at tail[e] and 2e + 1 at head[e]
+    std::vector<int> cw;
+    std::vector<int> ccw;
+    std::vector<int> firstHalf;
+    std::vector<int> leftRef;
+    std::vector<int> rightRef;
+    std::vector<int> rotOffsets;
+    std::vector<int> rotNeighbors;
+
+    // Left-right test over the active edges, optionally building the rotation system
+    bool lrTest(bool embed);
+
+    // Phases of the left-right algorithm
+    void orient();
+    void sortOutEdges();
+    bool testing(int root);
+    bool addConstraints(int ei, int e);
+    void removeBackEdges(int e);
+    int sign(int e);
+    void embedding(int root);
+
+    // Rotation system primitives
+    void addHalfEdgeCw(int v, int h, int reference);
+    void addHalfEdgeCcw(int v, int h, int reference);
+    int halfTarget(int h) const;
+
+    // Dense index of vertex id v, -1 if absent
+    int indexOf(int v) const;
+
+public:
+    /*!
+     * @function Planarity
+     * @abstract Construct an empty Planarity-type object to be reused
+     *           through test()
+     */
+    Planarity();
+
+    /*!
+     * @function Planarity
+     * @abstract Construct Planarity-type object based on an
+     * undirected graph.
+     * @param target undirected graph used as input
+     */
+    Planarity(const Graph &target);
+
+    /*!
+     * @function test
+     * @abstract Test another graph, reusing the buffers of this object
+     * @param target undirected graph used as input
+     * @return true if target is planar, false otherwise
+     */
+    bool test(const Graph &target);
+
+    /*!
+     * @function isPlanar
+     * @abstract Checks if the last tested graph is planar
+     * @return true if the graph is planar, false otherwise
+     */
+    bool isPlanar() const;
+
+    /*!
+     * @function rotation
+     * @abstract Returns the neighbors of v in clockwise order of a planar
+     *           embedding. Empty if the graph is not planar.
+     * @param v the queried vertex
+     * @return neighbors of v in clockwise order
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    std::vector<int> rotation(int v) const;
+
+    /*!
+     * @function kuratowskiSubgraph
+     * @abstract Returns the edges of a subdivision of K5 or K3,3 contained
+     *           in a non-planar graph. Runs one planarity test per edge.
+     * @return edges of the Kuratowski subgraph, empty if the graph is planar
+     */
+    std::vector<std::pair<int, int>> kuratowskiSubgraph();
+};
+
+#endif /*PLANARITY*/
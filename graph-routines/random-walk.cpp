@@ -0,0 +1,291 @@
+/**random-walk.cpp
+ *
+ * Uniform, weighted and node2vec random walks with alias tables,
+ * rejection sampling and per-walk generator seeding.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "random-walk.hpp"
+#include "graph/compact-digraph.hpp"
+#include "utils/parallel.hpp"
+
+// Small, fast generator that is cheap to reseed for every walk
+struct SplitMix64
+{
+    uint64_t state;
+
+    uint64_t next()
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Uniform in [0, n) by multiply-shift, for n below 2^32
+    size_t below(size_t n) { return ((next() >> 32) * n) >> 32; }
+};
+
+// Reject invalid walk counts and lengths
+static void checkWalkArguments(int walksPerVertex, int length)
+{
+    if (walksPerVertex < 0)
+        throw std::invalid_argument("Random walk: walksPerVertex must not be negative");
+    if (length <= 0)
+        throw std::invalid_argument("Random walk: length must be positive");
+}
+
+// Write walk i of the given length to out, padding a stopped walk with -1
+void RandomWalk::walk(size_t i, int length, uint64_t seed, int *out) const
+{
+    SplitMix64 rng{seed << 32 ^ i * 0xd1b54a32d192ed03ull};
+    int v = i % ids.size(), prev = -1;
+    out[0] = v;
+    for (int k = 1; k < length; k++)
+    {
+        size_t begin = offsets[v], deg = offsets[v + 1] - begin;
+        if (deg == 0)
+        {
+            std::fill(out + k, out + length, -1);
+            return;
+        }
+
+        int next;
+        while (true)
+        {
+            size_t e = begin + rng.below(deg);
+            if (!aliasProb.empty() && rng.uniform() >= aliasProb[e])
+                e = begin + aliasIndex[e];
+            next = targets[e];
+            if (prev == -1 || (returnBias == 1 && outBias == 1))
+                break;
+
+            // Accept by the second-order bias relative to its maximum
+            double bias = next == prev ? returnBias
+                          : std::binary_search(targets.begin() + offsets[prev], targets.begin() + offsets[prev + 1], next)
+                              ? 1
+                              : outBias;
+            if (rng.uniform() * maxBias < bias)
+                break;
+        }
+        prev = v;
+        v = next;
+        out[k] = v;
+    }
+}
+
+// Fill buffer with walks first to first + count - 1
+void RandomWalk::generate(size_t first, size_t count, int length, unsigned int seed, int numThreads,
+                          std::vector<int> &buffer) const
+{
+    buffer.resize(count * length);
+    parallelFor(0, count, [&](size_t i, int)
+                { walk(first + i, length, seed, &buffer[i * length]); },
+                numThreads, 64);
+}
+
+/*!
+ * @function RandomWalk
+ * @abstract Construct RandomWalk-type object based on a directed graph
+ *           and precompute its sampling tables.
+ * @param target directed graph used as input
+ * @param weighted step with probability proportional to edge weights
+ * @param p node2vec return parameter
+ * @param q node2vec in-out parameter; p = q = 1 gives first-order walks
+ * @exception throws std::invalid_argument if p or q is not positive,
+ *            or if weighted and some edge weight is not positive
+ */
+RandomWalk::RandomWalk(const DiGraph &target, bool weighted, double p, double q)
+    : returnBias(1 / p), outBias(1 / q), maxBias(std::max({1.0, 1 / p, 1 / q}))
+{
+    if (!(p > 0) || !(q > 0))
+        throw std::invalid_argument("Random walk: p and q must be positive");
+    CompactDiGraph g(target);
+    int V = g.V();
+    ids.resize(V);
+    for (int v = 0; v < V; v++)
+        ids[v] = g.id(v);
+    offsets = g.getOffsets();
+    targets = g.getTargets();
+    std::vector<double> weights = g.getWeights();
+    if (weighted)
+        for (double w : weights)
+            if (!(w > 0))
+                throw std::invalid_argument("Random walk: edge weight " + std::to_string(w) + " is not positive");
+
+    // Sort every row by target for the node2vec edge test
+    std::vector<std::pair<int, double>> row;
+    for (int v = 0; v < V; v++)
+    {
+        row.clear();
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+            row.push_back({targets[e], weights[e]});
+        std::sort(row.begin(), row.end());
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+        {
+            targets[e] = row[e - offsets[v]].first;
+            weights[e] = row[e - offsets[v]].second;
+        }
+    }
+    if (!weighted)
+        return;
+
+    // Vose's alias method per row
+    aliasProb.resize(targets.size());
+    aliasIndex.resize(targets.size());
+    std::vector<int> small, large;
+    for (int v = 0; v < V; v++)
+    {
+        size_t begin = offsets[v], deg = offsets[v + 1] - begin;
+        double total = 0;
+        for (size_t e = begin; e < begin + deg; e++)
+            total += weights[e];
+        small.clear();
+        large.clear();
+        for (size_t j = 0; j < deg; j++)
+        {
+            aliasProb[begin + j] = weights[begin + j] * deg / total;
+            aliasIndex[begin + j] = j;
+            (aliasProb[begin + j] < 1 ? small : large).push_back(j);
+        }
+        while (!small.empty() && !large.empty())
+        {
+            int s = small.back(), l = large.back();
+            small.pop_back();
+            aliasIndex[begin + s] = l;
+            aliasProb[begin + l] -= 1 - aliasProb[begin + s];
+            if (aliasProb[begin + l] < 1)
+            {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // Entries left over are 1 up to rounding
+        for (int j : small)
+            aliasProb[begin + j] = 1;
+        for (int j : large)
+            aliasProb[begin + j] = 1;
+    }
+}
+
+/*!
+ * @function RandomWalk
+ * @abstract Copy constructor for RandomWalk-type object.
+ * @param other another RandomWalk-type object
+ */
+RandomWalk::RandomWalk(const RandomWalk &other)
+    : ids(other.ids), offsets(other.offsets), targets(other.targets), aliasProb(other.aliasProb),
+      aliasIndex(other.aliasIndex), returnBias(other.returnBias), outBias(other.outBias), maxBias(other.maxBias) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for RandomWalk-type object.
+ * @param other another RandomWalk-type object
+ */
+RandomWalk &RandomWalk::operator=(const RandomWalk &other)
+{
+    RandomWalk newCopy(other);
+    std::swap(this->ids, newCopy.ids);
+    std::swap(this->offsets, newCopy.offsets);
+    std::swap(this->targets, newCopy.targets);
+    std::swap(this->aliasProb, newCopy.aliasProb);
+    std::swap(this->aliasIndex, newCopy.aliasIndex);
+    std::swap(this->returnBias, newCopy.returnBias);
+    std::swap(this->outBias, newCopy.outBias);
+    std::swap(this->maxBias, newCopy.maxBias);
+    return *this;
+}
+
+/*!
+ * @function walks
+ * @abstract Generate walksPerVertex walks from every vertex into one
+ *           contiguous buffer
+ * @param walksPerVertex number of walks started at each vertex
+ * @param length number of vertices per walk, including the start
+ * @param seed seed for the walks
+ * @param useParallel generate walks with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @return walk i in entries i * length to (i + 1) * length - 1 as
+ *         positions in DiGraph::getVertices(), padded with -1 after a
+ *         vertex without out-edges
+ * @exception throws std::invalid_argument if walksPerVertex is
+ *            negative or length is not positive
+ */
+std::vector<int> RandomWalk::walks(int walksPerVertex, int length, unsigned int seed,
+                                   bool useParallel, int numThreads) const
+{
+    checkWalkArguments(walksPerVertex, length);
+    std::vector<int> buffer;
+    generate(0, static_cast<size_t>(walksPerVertex) * ids.size(), length, seed,
+             useParallel ? resolveThreads(numThreads) : 1, buffer);
+    return buffer;
+}
+
+/*!
+ * @function writeWalks
+ * @abstract Generate the same walks as walks() and write them to a
+ *           text file, one walk per line with vertex ids separated by
+ *           spaces. Walks are generated and written in blocks, so
+ *           memory use does not grow with the number of walks.
+ * @param path the file to create or overwrite
+ * @param walksPerVertex number of walks started at each vertex
+ * @param length number of vertices per walk, including the start
+ * @param seed seed for the walks
+ * @param useParallel generate walks with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if the arguments are invalid
+ *            as for walks() or the file cannot be written
+ */
+void RandomWalk::writeWalks(const std::string &path, int walksPerVertex, int length, unsigned int seed,
+                            bool useParallel, int numThreads) const
+{
+    checkWalkArguments(walksPerVertex, length);
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        throw std::invalid_argument("Random walk: cannot write " + path);
+
+    int threads = useParallel ? resolveThreads(numThreads) : 1;
+    size_t total = static_cast<size_t>(walksPerVertex) * ids.size();
+    size_t block = std::max<size_t>(1, (1 << 20) / length);
+    std::vector<int> buffer;
+    std::string text;
+    char digits[16];
+    for (size_t first = 0; first < total; first += block)
+    {
+        size_t count = std::min(block, total - first);
+        generate(first, count, length, seed, threads, buffer);
+        text.clear();
+        for (size_t i = 0; i < count; i++)
+        {
+            const int *w = &buffer[i * length];
+            for (int k = 0; k < length && w[k] != -1; k++)
+            {
+                if (k > 0)
+                    text += ' ';
+                // Format the id backwards into digits
+                int id = ids[w[k]];
+                unsigned int x = id < 0 ? -static_cast<unsigned int>(id) : id;
+                char *end = digits + sizeof(digits), *p = end;
+                do
+                    *--p = '0' + x % 10;
+                while (x /= 10);
+                if (id < 0)
+                    *--p = '-';
+                text.append(p, end);
+            }
+            text += '\n';
+        }
+        out.write(text.data(), text.size());
+    }
+    if (!out)
+        throw std::invalid_argument("Random walk: cannot write " + path);
+}
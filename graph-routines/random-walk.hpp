@@ -0,0 +1,118 @@
+/**random-walk.hpp
+ *
+ * Random walk generator for graph embeddings such as DeepWalk and
+ * node2vec. A walk follows out-edges, either uniformly or with
+ * probability proportional to the edge weight, and stops early at a
+ * vertex without out-edges.
+ *
+ * Weighted steps draw from an alias table per vertex (Vose's method), so
+ * every step costs O(1) after O(E) preprocessing. The second-order
+ * node2vec bias with return parameter p and in-out parameter q is
+ * applied by rejection sampling as in KnightKing: a neighbor x of the
+ * current vertex is drawn from the first-order distribution and accepted
+ * with probability proportional to 1 / p if x is the previous vertex t,
+ * 1 if t has an edge to x and 1 / q otherwise. Rows are sorted by target
+ * so the edge test is a binary search.
+ *
+ * Walk i starts at the vertex at position i mod V of
+ * DiGraph::getVertices(). Threads claim walks dynamically, and each
+ * thread reseeds its own generator from the seed and the walk index, so
+ * the output does not depend on the number of threads.
+ */
+
+#ifndef RANDOM_WALK
+#define RANDOM_WALK
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "graph/digraph.hpp"
+
+class RandomWalk
+{
+private:
+    std::vector<int> ids;
+    // Out-edges of v are targets[offsets[v]] to targets[offsets[v + 1] - 1]
+    // in increasing order
+    std::vector<size_t> offsets;
+    std::vector<int> targets;
+    // Alias table over the row of every vertex; empty when unweighted
+    std::vector<double> aliasProb;
+    std::vector<int> aliasIndex;
+    double returnBias, outBias, maxBias;
+
+    // Write walk i of the given length to out, padding a stopped walk with -1
+    void walk(size_t i, int length, uint64_t seed, int *out) const;
+
+    // Fill buffer with walks first to first + count - 1
+    void generate(size_t first, size_t count, int length, unsigned int seed, int numThreads,
+                  std::vector<int> &buffer) const;
+
+public:
+    /*!
+     * @function RandomWalk
+     * @abstract Construct RandomWalk-type object based on a directed graph
+     *           and precompute its sampling tables.
+     * @param target directed graph used as input
+     * @param weighted step with probability proportional to edge weights
+     * @param p node2vec return parameter
+     * @param q node2vec in-out parameter; p = q = 1 gives first-order walks
+     * @exception throws std::invalid_argument if p or q is not positive,
+     *            or if weighted and some edge weight is not positive
+     */
+    RandomWalk(const DiGraph &target, bool weighted = false, double p = 1, double q = 1);
+
+    /*!
+     * @function RandomWalk
+     * @abstract Copy constructor for RandomWalk-type object.
+     * @param other another RandomWalk-type object
+     */
+    RandomWalk(const RandomWalk &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for RandomWalk-type object.
+     * @param other another RandomWalk-type object
+     */
+    RandomWalk &operator=(const RandomWalk &other);
+
+    /*!
+     * @function walks
+     * @abstract Generate walksPerVertex walks from every vertex into one
+     *           contiguous buffer
+     * @param walksPerVertex number of walks started at each vertex
+     * @param length number of vertices per walk, including the start
+     * @param seed seed for the walks
+     * @param useParallel generate walks with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @return walk i in entries i * length to (i + 1) * length - 1 as
+     *         positions in DiGraph::getVertices(), padded with -1 after a
+     *         vertex without out-edges
+     * @exception throws std::invalid_argument if walksPerVertex is
+     *            negative or length is not positive
+     */
+    std::vector<int> walks(int walksPerVertex, int length, unsigned int seed = 0,
+                           bool useParallel = false, int numThreads = 0) const;
+
+    /*!
+     * @function writeWalks
+     * @abstract Generate the same walks as walks() and write them to a
+     *           text file, one walk per line with vertex ids separated by
+     *           spaces. Walks are generated and written in blocks, so
+     *           memory use does not grow with the number of walks.
+     * @param path the file to create or overwrite
+     * @param walksPerVertex number of walks started at each vertex
+     * @param length number of vertices per walk, including the start
+     * @param seed seed for the walks
+     * @param useParallel generate walks with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if the arguments are invalid
+     *            as for walks() or the file cannot be written
+     */
+    void writeWalks(const std::string &path, int walksPerVertex, int length, unsigned int seed = 0,
+                    bool useParallel = false, int numThreads = 0) const;
+};
+
+#endif /*RANDOM_WALK*/
@@ -0,0 +1,389 @@
+/**reachability-index.cpp
+ *
+ * Reachability index over the condensation DAG with topological levels,
+ * GRAIL interval labels from randomized traversals and a pruned
+ * depth-first fallback.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "reachability-index.hpp"
+#include "strong-connectivity.hpp"
+#include "utils/parallel.hpp"
+
+static const char MAGIC[4] = {'V', 'V', 'R', 'I'};
+static const uint32_t VERSION = 1;
+
+// Upper bound on the number of traversals, which also bounds the label
+// array a header can ask load() to allocate
+static const int MAX_DIMENSIONS = 1 << 10;
+
+// Write the elements of a vector as raw bytes
+template <typename T>
+static void writeArray(std::ostream &out, const std::vector<T> &data)
+{
+    out.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(T));
+}
+
+// Read n elements written by writeArray, growing data only as far as the
+// stream delivers so a truncated stream cannot force a large allocation
+template <typename T>
+static void readArray(std::istream &in, std::vector<T> &data, uint64_t n)
+{
+    const uint64_t chunk = (1 << 20) / sizeof(T);
+    data.clear();
+    for (uint64_t done = 0; done < n;)
+    {
+        uint64_t count = std::min(chunk, n - done);
+        data.resize(done + count);
+        in.read(reinterpret_cast<char *>(data.data() + done), count * sizeof(T));
+        if (!in)
+            throw std::invalid_argument("Reachability index: stream ends before the index does");
+        done += count;
+    }
+}
+
+// Bytes following the header of an index with the given counts; the
+// header bounds keep every term far from overflowing
+static uint64_t bodyBytes(uint64_t V, uint64_t n, uint64_t E, uint64_t k)
+{
+    return 2 * V * sizeof(int) + (n + 1) * sizeof(uint64_t) + E * sizeof(int) +
+           2 * n * sizeof(int) + 2 * n * k * sizeof(int);
+}
+
+// Visited marks and stack of the fallback search on one thread
+struct FallbackScratch
+{
+    std::vector<unsigned> mark;
+    std::vector<int> stack;
+    unsigned epoch = 0;
+};
+
+// Empty index filled by load()
+ReachabilityIndex::ReachabilityIndex() : k(0) {}
+
+// One randomized post-order traversal writing interval i
+void ReachabilityIndex::traverse(int i, unsigned int seed)
+{
+    int n = level.size();
+    std::mt19937 rng(seed + 0x9e3779b9u * (i + 1));
+    std::vector<int> roots(n);
+    std::iota(roots.begin(), roots.end(), 0);
+    std::shuffle(roots.begin(), roots.end(), rng);
+
+    // Children are scanned from a random start position, wrapping around,
+    // so every traversal explores them in a different order
+    std::vector<size_t> start(n), step(n, 0);
+    std::vector<char> visited(n, 0);
+    std::vector<int> stack, size(i == 0 ? n : 0, 1);
+    int rank = 0;
+    auto low = [&](int c) -> int & { return labels[2 * (static_cast<size_t>(c) * k + i)]; };
+    auto post = [&](int c) -> int & { return labels[2 * (static_cast<size_t>(c) * k + i) + 1]; };
+
+    auto open = [&](int c)
+    {
+        visited[c] = 1;
+        size_t deg = offsets[c + 1] - offsets[c];
+        start[c] = deg == 0 ? 0 : rng() % deg;
+        stack.push_back(c);
+    };
+
+    for (int root : roots)
+    {
+        if (visited[root])
+            continue;
+        open(root);
+        while (!stack.empty())
+        {
+            int c = stack.back();
+            size_t deg = offsets[c + 1] - offsets[c];
+            if (step[c] < deg)
+            {
+                int d = targets[offsets[c] + (start[c] + step[c]++) % deg];
+                if (!visited[d])
+                    open(d);
+                continue;
+            }
+
+            // Every child is finished, so its interval is final
+            stack.pop_back();
+            post(c) = rank++;
+            low(c) = post(c);
+            for (size_t e = offsets[c]; e < offsets[c + 1]; e++)
+                low(c) = std::min(low(c), low(targets[e]));
+            if (i == 0)
+            {
+                treeLow[c] = post(c) - size[c] + 1;
+                if (!stack.empty())
+                    size[stack.back()] += size[c];
+            }
+        }
+    }
+}
+
+// Interval containment and level checks; false proves c cannot reach d
+bool ReachabilityIndex::mayReach(int c, int d) const
+{
+    if (level[c] >= level[d])
+        return false;
+    const int *lc = &labels[2 * static_cast<size_t>(c) * k];
+    const int *ld = &labels[2 * static_cast<size_t>(d) * k];
+    for (int i = 0; i < 2 * k; i += 2)
+        if (ld[i] < lc[i] || ld[i + 1] > lc[i + 1])
+            return false;
+    return true;
+}
+
+// Subtree containment in the first traversal; true proves c reaches d
+bool ReachabilityIndex::treeReaches(int c, int d) const
+{
+    int postD = labels[2 * static_cast<size_t>(d) * k + 1];
+    return treeLow[c] <= postD && postD <= labels[2 * static_cast<size_t>(c) * k + 1];
+}
+
+/*!
+ * @function ReachabilityIndex
+ * @abstract Construct ReachabilityIndex-type object based on a
+ *           directed graph.
+ * @param target directed graph used as input
+ * @param dimensions number of randomized traversals, each adding one
+ *                   interval per component
+ * @param seed seed for the traversal orders
+ * @param useParallel build traversals with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ * @exception throws std::invalid_argument if dimensions is not in
+ *            [1, 1024]
+ */
+ReachabilityIndex::ReachabilityIndex(const DiGraph &target, int dimensions, unsigned int seed,
+                                     bool useParallel, int numThreads)
+    : k(dimensions)
+{
+    if (dimensions <= 0 || dimensions > MAX_DIMENSIONS)
+        throw std::invalid_argument("Reachability index: dimensions must be in [1, " +
+                                    std::to_string(MAX_DIMENSIONS) + "]");
+    int threads = useParallel ? resolveThreads(numThreads) : 1;
+
+    StrongConnectivity scc(target, useParallel, numThreads);
+    comp = scc.ids();
+    const std::vector<Node> &vertices = target.getVertices();
+    ids.reserve(vertices.size());
+    for (size_t v = 0; v < vertices.size(); v++)
+    {
+        ids.push_back(vertices[v].getId());
+        idToIndex[ids.back()] = v;
+    }
+    CompactDiGraph dag = scc.condensation();
+    offsets = dag.getOffsets();
+    targets = dag.getTargets();
+
+    // Longest-path levels by Kahn's algorithm
+    int n = scc.count();
+    std::vector<int> indeg(n, 0), queue;
+    for (int d : targets)
+        indeg[d]++;
+    for (int c = 0; c < n; c++)
+        if (indeg[c] == 0)
+            queue.push_back(c);
+    level.assign(n, 0);
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        int c = queue[head];
+        for (size_t e = offsets[c]; e < offsets[c + 1]; e++)
+        {
+            int d = targets[e];
+            level[d] = std::max(level[d], level[c] + 1);
+            if (--indeg[d] == 0)
+                queue.push_back(d);
+        }
+    }
+
+    treeLow.assign(n, 0);
+    labels.assign(2 * static_cast<size_t>(n) * k, 0);
+    parallelFor(0, k, [&](size_t i, int)
+                { traverse(i, seed); },
+                threads, 1);
+}
+
+/*!
+ * @function ReachabilityIndex
+ * @abstract Copy constructor for ReachabilityIndex-type object.
+ * @param other another ReachabilityIndex-type object
+ */
+ReachabilityIndex::ReachabilityIndex(const ReachabilityIndex &other)
+    : ids(other.ids), idToIndex(other.idToIndex), comp(other.comp), offsets(other.offsets),
+      targets(other.targets), level(other.level), treeLow(other.treeLow), labels(other.labels), k(other.k) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for ReachabilityIndex-type object.
+ * @param other another ReachabilityIndex-type object
+ */
+ReachabilityIndex &ReachabilityIndex::operator=(const ReachabilityIndex &other)
+{
+    ReachabilityIndex newCopy(other);
+    std::swap(this->ids, newCopy.ids);
+    std::swap(this->idToIndex, newCopy.idToIndex);
+    std::swap(this->comp, newCopy.comp);
+    std::swap(this->offsets, newCopy.offsets);
+    std::swap(this->targets, newCopy.targets);
+    std::swap(this->level, newCopy.level);
+    std::swap(this->treeLow, newCopy.treeLow);
+    std::swap(this->labels, newCopy.labels);
+    std::swap(this->k, newCopy.k);
+    return *this;
+}
+
+/*!
+ * @function reaches
+ * @abstract Checks if there is a directed path from u to v. Every
+ *           vertex reaches itself.
+ * @param u the start vertex
+ * @param v the end vertex
+ * @exception throws std::out_of_range if u or v is not in the graph
+ */
+bool ReachabilityIndex::reaches(int u, int v) const
+{
+    for (int x : {u, v})
+        if (idToIndex.find(x) == idToIndex.end())
+            throw std::out_of_range("Reachability index: vertex " + std::to_string(x) + " is not in graph");
+    int c = comp[idToIndex.at(u)], d = comp[idToIndex.at(v)];
+    if (c == d)
+        return true;
+    if (!mayReach(c, d))
+        return false;
+    if (treeReaches(c, d))
+        return true;
+
+    // Depth-first search entering only components that may still reach d.
+    // Visited marks are stamped with a per-thread epoch and reused across
+    // queries, so a query allocates nothing once the scratch has grown.
+    static thread_local FallbackScratch scratch;
+    if (scratch.mark.size() < level.size())
+        scratch.mark.resize(level.size(), 0);
+    if (++scratch.epoch == 0)
+    {
+        std::fill(scratch.mark.begin(), scratch.mark.end(), 0);
+        scratch.epoch = 1;
+    }
+    std::vector<int> &stack = scratch.stack;
+    stack.assign(1, c);
+    while (!stack.empty())
+    {
+        int x = stack.back();
+        stack.pop_back();
+        for (size_t e = offsets[x]; e < offsets[x + 1]; e++)
+        {
+            int y = targets[e];
+            if (y == d)
+                return true;
+            if (!mayReach(y, d) || scratch.mark[y] == scratch.epoch)
+                continue;
+            scratch.mark[y] = scratch.epoch;
+            if (treeReaches(y, d))
+                return true;
+            stack.push_back(y);
+        }
+    }
+    return false;
+}
+
+// Return number of intervals per component
+int ReachabilityIndex::dimensions() const { return k; }
+
+// Return number of strongly connected components
+int ReachabilityIndex::components() const { return level.size(); }
+
+/*!
+ * @function save
+ * @abstract Write the index to a binary stream
+ * @param out stream opened in binary mode
+ * @exception throws std::invalid_argument if writing fails
+ */
+void ReachabilityIndex::save(std::ostream &out) const
+{
+    uint64_t header[4] = {ids.size(), level.size(), targets.size(), static_cast<uint64_t>(k)};
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    writeArray(out, ids);
+    writeArray(out, comp);
+    std::vector<uint64_t> wideOffsets(offsets.begin(), offsets.end());
+    writeArray(out, wideOffsets);
+    writeArray(out, targets);
+    writeArray(out, level);
+    writeArray(out, treeLow);
+    writeArray(out, labels);
+    if (!out)
+        throw std::invalid_argument("Reachability index: writing the index failed");
+}
+
+/*!
+ * @function load
+ * @abstract Read an index written by save()
+ * @param in stream opened in binary mode
+ * @return the loaded index
+ * @exception throws std::invalid_argument if the stream does not hold
+ *            a valid index
+ */
+ReachabilityIndex ReachabilityIndex::load(std::istream &in)
+{
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    uint64_t header[4];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    in.read(reinterpret_cast<char *>(header), sizeof(header));
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::invalid_argument("Reachability index: stream does not hold an index");
+    if (version != VERSION)
+        throw std::invalid_argument("Reachability index: unsupported version " + std::to_string(version));
+    uint64_t V = header[0], n = header[1], E = header[2], k = header[3];
+    if (V > INT32_MAX || n > V || E > INT32_MAX || k == 0 || k > static_cast<uint64_t>(MAX_DIMENSIONS))
+        throw std::invalid_argument("Reachability index: corrupt header");
+
+    // Compare the declared size with what the stream holds before allocating
+    std::streampos here = in.tellg();
+    if (here != std::streampos(-1))
+    {
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(here);
+        if (!in || end < here || static_cast<uint64_t>(end - here) < bodyBytes(V, n, E, k))
+            throw std::invalid_argument("Reachability index: stream ends before the index does");
+    }
+
+    ReachabilityIndex index;
+    index.k = k;
+    readArray(in, index.ids, V);
+    readArray(in, index.comp, V);
+    std::vector<uint64_t> wideOffsets;
+    readArray(in, wideOffsets, n + 1);
+    readArray(in, index.targets, E);
+    readArray(in, index.level, n);
+    readArray(in, index.treeLow, n);
+    readArray(in, index.labels, 2 * n * k);
+
+    // Reject values that would index out of bounds in queries
+    if (wideOffsets[0] != 0 || wideOffsets[n] != E ||
+        !std::is_sorted(wideOffsets.begin(), wideOffsets.end()))
+        throw std::invalid_argument("Reachability index: corrupt condensation");
+    index.offsets.assign(wideOffsets.begin(), wideOffsets.end());
+    for (int c : index.comp)
+        if (c < 0 || static_cast<uint64_t>(c) >= n)
+            throw std::invalid_argument("Reachability index: corrupt component ids");
+    for (int d : index.targets)
+        if (d < 0 || static_cast<uint64_t>(d) >= n)
+            throw std::invalid_argument("Reachability index: corrupt condensation");
+    for (uint64_t v = 0; v < V; v++)
+        if (!index.idToIndex.emplace(index.ids[v], v).second)
+            throw std::invalid_argument("Reachability index: duplicate vertex " + std::to_string(index.ids[v]));
+    return index;
+}
@@ -0,0 +1,129 @@
+/**reachability-index.hpp
+ *
+ * Precomputed index answering whether a directed path leads from u to v
+ * without a full traversal per query. Strongly connected components are
+ * contracted first, so the index works on the condensation DAG and any
+ * two vertices of one component reach each other.
+ *
+ * Every component keeps its topological level and, following GRAIL, one
+ * interval per randomized depth-first traversal: [low, post] where post
+ * is the post-order rank and low the smallest rank among its
+ * descendants. If u reaches v, the interval of v is contained in that of
+ * u in every traversal and the level of v is larger, so any failed check
+ * proves unreachability. The first traversal also keeps the post-order
+ * range of its DFS subtree, whose containment proves reachability. Only
+ * queries passing all filters fall back to a depth-first search that is
+ * pruned by the same checks at every component.
+ *
+ * The traversals are independent and built in parallel. The index can be
+ * written to a stream in a native-endian binary format and loaded back
+ * without the graph.
+ */
+
+#ifndef REACHABILITY_INDEX
+#define REACHABILITY_INDEX
+
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include "graph/digraph.hpp"
+
+class ReachabilityIndex
+{
+private:
+    std::vector<int> ids;
+    std::unordered_map<int, int> idToIndex;
+    // Component of every vertex
+    std::vector<int> comp;
+    // Condensation DAG in CSR form
+    std::vector<size_t> offsets;
+    std::vector<int> targets;
+    std::vector<int> level;
+    // Smallest post-order rank in the DFS subtree of the first traversal
+    std::vector<int> treeLow;
+    // Interval i of component c is labels[2 * (c * k + i)] (low) and
+    // labels[2 * (c * k + i) + 1] (post)
+    std::vector<int> labels;
+    int k;
+
+    // Empty index filled by load()
+    ReachabilityIndex();
+
+    // One randomized post-order traversal writing interval i
+    void traverse(int i, unsigned int seed);
+
+    // Interval containment and level checks; false proves c cannot reach d
+    bool mayReach(int c, int d) const;
+
+    // Subtree containment in the first traversal; true proves c reaches d
+    bool treeReaches(int c, int d) const;
+
+public:
+    /*!
+     * @function ReachabilityIndex
+     * @abstract Construct ReachabilityIndex-type object based on a
+     *           directed graph.
+     * @param target directed graph used as input
+     * @param dimensions number of randomized traversals, each adding one
+     *                   interval per component
+     * @param seed seed for the traversal orders
+     * @param useParallel build traversals with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     * @exception throws std::invalid_argument if dimensions is not in
+     *            [1, 1024]
+     */
+    ReachabilityIndex(const DiGraph &target, int dimensions = 3, unsigned int seed = 0,
+                      bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function ReachabilityIndex
+     * @abstract Copy constructor for ReachabilityIndex-type object.
+     * @param other another ReachabilityIndex-type object
+     */
+    ReachabilityIndex(const ReachabilityIndex &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for ReachabilityIndex-type object.
+     * @param other another ReachabilityIndex-type object
+     */
+    ReachabilityIndex &operator=(const ReachabilityIndex &other);
+
+    /*!
+     * @function reaches
+     * @abstract Checks if there is a directed path from u to v. Every
+     *           vertex reaches itself.
+     * @param u the start vertex
+     * @param v the end vertex
+     * @exception throws std::out_of_range if u or v is not in the graph
+     */
+    bool reaches(int u, int v) const;
+
+    // Return number of intervals per component
+    int dimensions() const;
+
+    // Return number of strongly connected components
+    int components() const;
+
+    /*!
+     * @function save
+     * @abstract Write the index to a binary stream
+     * @param out stream opened in binary mode
+     * @exception throws std::invalid_argument if writing fails
+     */
+    void save(std::ostream &out) const;
+
+    /*!
+     * @function load
+     * @abstract Read an index written by save()
+     * @param in stream opened in binary mode
+     * @return the loaded index
+     * @exception throws std::invalid_argument if the stream does not hold
+     *            a valid index
+     */
+    static ReachabilityIndex load(std::istream &in);
+};
+
+#endif /*REACHABILITY_INDEX*/
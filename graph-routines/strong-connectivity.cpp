@@ -0,0 +1,492 @@
+/**strong-connectivity.cpp
+ *
+ * Two vertices of a directed graph are strongly connected if there is a
+ * directed path from each one to the other. Strongly connected components
+ * (SCCs) are the maximal sets of mutually strongly connected vertices.
+ *
+ * This routine labels every vertex with a dense component id in the range
+ * 0 to count() - 1 and builds the condensation DAG on those ids. The
+ * sequential mode runs an iterative Tarjan, so graph depth is bounded by
+ * heap memory rather than the call stack. The parallel mode trims trivial
+ * SCCs, peels the giant SCC with a forward-backward search and resolves
+ * the remainder by color propagation before finishing small leftovers
+ * with Tarjan.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "strong-connectivity.hpp"
+#include "utils/parallel.hpp"
+
+// Below this many unresolved vertices the parallel mode hands over to Tarjan
+static const size_t SERIAL_CUTOFF = 4096;
+
+// Raise target to value if it is smaller, return true if it was raised
+static bool atomicMax(std::atomic<int> &target, int value)
+{
+    int cur = target.load(std::memory_order_relaxed);
+    while (cur < value)
+        if (target.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+            return true;
+    return false;
+}
+
+// Iterative Tarjan over the active vertices; labels each SCC with its
+// root index and appends roots to completed in reverse topological order
+void StrongConnectivity::tarjan(const std::vector<char> &active, std::vector<int> &label, std::vector<int> &completed)
+{
+    int V = g.V();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
+
+    std::vector<int> index(V, -1);
+    std::vector<int> low(V, 0);
+    std::vector<int> sccStack;
+    std::vector<std::pair<int, size_t>> callStack; // (vertex, next edge offset)
+    int counter = 0;
+
+    for (int src = 0; src < V; src++)
+    {
+        if (!active[src] || index[src] != -1)
+            continue;
+
+        index[src] = low[src] = counter++;
+        sccStack.push_back(src);
+        callStack.push_back({src, offsets[src]});
+
+        while (!callStack.empty())
+        {
+            int v = callStack.back().first;
+            size_t e = callStack.back().second;
+
+            if (e < offsets[v + 1])
+            {
+                callStack.back().second++;
+                int w = targets[e];
+                if (!active[w])
+                    continue;
+
+                if (index[w] == -1)
+                {
+                    // Descend into w
+                    index[w] = low[w] = counter++;
+                    sccStack.push_back(w);
+                    callStack.push_back({w, offsets[w]});
+                }
+                else if (label[w] == -1) // w is still on the SCC stack
+                    low[v] = std::min(low[v], index[w]);
+                continue;
+            }
+
+            // All edges of v are done, return to the parent
+            callStack.pop_back();
+            if (!callStack.empty())
+            {
+                int parent = callStack.back().first;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+
+            // v is the root of an SCC: pop the whole component
+            if (low[v] == index[v])
+            {
+                int w;
+                do
+                {
+                    w = sccStack.back();
+                    sccStack.pop_back();
+                    label[w] = v;
+                } while (w != v);
+                completed.push_back(v);
+            }
+        }
+    }
+}
+
+// Trimming, forward-backward and coloring phases of the parallel mode
+void StrongConnectivity::parallelSCC(int numThreads)
+{
+    int V = g.V();
+    numThreads = resolveThreads(numThreads);
+
+    CompactDiGraph rg = g.reverse();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
+    const std::vector<size_t> &rOffsets = rg.getOffsets();
+    const std::vector<int> &rTargets = rg.getTargets();
+
+    std::vector<int> label(V, -1);
+    std::vector<char> active(V, 1);
+    std::vector<std::vector<int>> local(numThreads);
+    std::vector<int> frontier;
+
+    /**
+     * Trim: vertices without incoming or outgoing edges are trivial SCCs,
+     * and removing them may expose more trivial SCCs
+     */
+    std::vector<std::atomic<int>> inDeg(V);
+    std::vector<std::atomic<int>> outDeg(V);
+    std::vector<std::atomic<char>> trimmed(V);
+    parallelFor(0, V, [&](size_t v, int t)
+                {
+                    inDeg[v].store(rOffsets[v + 1] - rOffsets[v], std::memory_order_relaxed);
+                    outDeg[v].store(offsets[v + 1] - offsets[v], std::memory_order_relaxed);
+                    bool trivial = inDeg[v].load(std::memory_order_relaxed) == 0 ||
+                                   outDeg[v].load(std::memory_order_relaxed) == 0;
+                    trimmed[v].store(trivial, std::memory_order_relaxed);
+                    if (trivial)
+                        local[t].push_back(v); },
+                numThreads);
+    gather(local, frontier);
+
+    while (!frontier.empty())
+    {
+        parallelFor(0, frontier.size(), [&](size_t i, int t)
+                    {
+                        int v = frontier[i];
+                        label[v] = v;
+                        active[v] = 0;
+                        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+                        {
+                            int w = targets[e];
+                            if (inDeg[w].fetch_sub(1, std::memory_order_relaxed) == 1 && !trimmed[w].exchange(1))
+                                local[t].push_back(w);
+                        }
+                        for (size_t e = rOffsets[v]; e < rOffsets[v + 1]; e++)
+                        {
+                            int w = rTargets[e];
+                            if (outDeg[w].fetch_sub(1, std::memory_order_relaxed) == 1 && !trimmed[w].exchange(1))
+                                local[t].push_back(w);
+                        } },
+                    numThreads, 256);
+        gather(local, frontier);
+    }
+
+    /**
+     * Forward-backward: the SCC of a high-degree pivot is the intersection
+     * of its forward and backward reachable sets, which usually peels off
+     * the giant component in two parallel BFS passes
+     */
+    std::vector<long long> bestScore(numThreads, -1);
+    std::vector<int> bestVertex(numThreads, -1);
+    parallelFor(0, V, [&](size_t v, int t)
+                {
+                    if (!active[v])
+                        return;
+                    long long score = static_cast<long long>(inDeg[v].load(std::memory_order_relaxed)) *
+                                      outDeg[v].load(std::memory_order_relaxed);
+                    if (score > bestScore[t])
+                    {
+                        bestScore[t] = score;
+                        bestVertex[t] = v;
+                    } },
+                numThreads);
+    int pivot = -1;
+    long long pivotScore = -1;
+    for (int t = 0; t < numThreads; t++)
+    {
+        if (bestScore[t] > pivotScore || (bestScore[t] == pivotScore && bestVertex[t] < pivot))
+        {
+            pivotScore = bestScore[t];
+            pivot = bestVertex[t];
+        }
+    }
+
+    if (pivot != -1)
+    {
+        std::vector<std::atomic<char>> forward(V);
+        std::vector<std::atomic<char>> backward(V);
+        parallelFor(0, V, [&](size_t v, int)
+                    {
+                        forward[v].store(0, std::memory_order_relaxed);
+                        backward[v].store(0, std::memory_order_relaxed); },
+                    numThreads);
+
+        auto reach = [&](const std::vector<size_t> &off, const std::vector<int> &tgt, std::vector<std::atomic<char>> &seen)
+        {
+            seen[pivot].store(1);
+            frontier.assign(1, pivot);
+            while (!frontier.empty())
+            {
+                parallelFor(0, frontier.size(), [&](size_t i, int t)
+                            {
+                                int v = frontier[i];
+                                for (size_t e = off[v]; e < off[v + 1]; e++)
+                                {
+                                    int w = tgt[e];
+                                    if (active[w] && !seen[w].load(std::memory_order_relaxed) && !seen[w].exchange(1))
+                                        local[t].push_back(w);
+                                } },
+                            numThreads, 256);
+                gather(local, frontier);
+            }
+        };
+        reach(offsets, targets, forward);
+        reach(rOffsets, rTargets, backward);
+
+        parallelFor(0, V, [&](size_t v, int)
+                    {
+                        if (forward[v].load(std::memory_order_relaxed) && backward[v].load(std::memory_order_relaxed))
+                        {
+                            label[v] = pivot;
+                            active[v] = 0;
+                        } },
+                    numThreads);
+    }
+
+    /**
+     * Coloring: propagate the largest vertex index forward until stable.
+     * Every vertex whose color is its own index is the root of an SCC made
+     * of the same-colored vertices that reach it backwards.
+     */
+    std::vector<int> remaining;
+    parallelFor(0, V, [&](size_t v, int t)
+                {
+                    if (active[v])
+                        local[t].push_back(v); },
+                numThreads);
+    gather(local, remaining);
+
+    std::vector<std::atomic<int>> color(V);
+    std::vector<std::atomic<char>> queued(V);
+    std::vector<int> roots;
+    parallelFor(0, V, [&](size_t v, int)
+                {
+                    color[v].store(-1, std::memory_order_relaxed);
+                    queued[v].store(0, std::memory_order_relaxed); },
+                numThreads);
+    while (remaining.size() > SERIAL_CUTOFF)
+    {
+        parallelFor(0, remaining.size(), [&](size_t i, int)
+                    {
+                        int v = remaining[i];
+                        color[v].store(v, std::memory_order_relaxed); },
+                    numThreads);
+
+        frontier = remaining;
+        while (!frontier.empty())
+        {
+            parallelFor(0, frontier.size(), [&](size_t i, int t)
+                        {
+                            int v = frontier[i];
+                            int c = color[v].load(std::memory_order_relaxed);
+                            for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+                            {
+                                int w = targets[e];
+                                if (active[w] && atomicMax(color[w], c) && !queued[w].exchange(1))
+                                    local[t].push_back(w);
+                            } },
+                        numThreads, 256);
+            gather(local, frontier);
+            parallelFor(0, frontier.size(), [&](size_t i, int)
+                        { queued[frontier[i]].store(0, std::memory_order_relaxed); },
+                        numThreads);
+        }
+
+        parallelFor(0, remaining.size(), [&](size_t i, int t)
+                    {
+                        int v = remaining[i];
+                        if (color[v].load(std::memory_order_relaxed) == v)
+                            local[t].push_back(v); },
+                    numThreads);
+        gather(local, roots);
+
+        // Each root owns its color class, so the backward searches are disjoint
+        parallelFor(0, roots.size(), [&](size_t i, int)
+                    {
+                        int r = roots[i];
+                        std::vector<int> stack(1, r);
+                        label[r] = r;
+                        while (!stack.empty())
+                        {
+                            int v = stack.back();
+                            stack.pop_back();
+                            for (size_t e = rOffsets[v]; e < rOffsets[v + 1]; e++)
+                            {
+                                int w = rTargets[e];
+                                if (color[w].load(std::memory_order_relaxed) == r && active[w] && label[w] == -1)
+                                {
+                                    label[w] = r;
+                                    stack.push_back(w);
+                                }
+                            }
+                        } },
+                    numThreads, 1);
+
+        parallelFor(0, remaining.size(), [&](size_t i, int t)
+                    {
+                        int v = remaining[i];
+                        if (label[v] != -1)
+                            active[v] = 0;
+                        else
+                            local[t].push_back(v); },
+                    numThreads);
+        gather(local, remaining);
+    }
+
+    // Small leftovers are cheaper to finish sequentially
+    std::vector<int> completed;
+    if (!remaining.empty())
+        tarjan(active, label, completed);
+
+    // Relabel representatives to dense ids in order of first appearance
+    std::vector<int> denseId(V, -1);
+    _count = 0;
+    for (int v = 0; v < V; v++)
+    {
+        int rep = label[v];
+        if (denseId[rep] == -1)
+            denseId[rep] = _count++;
+        compId[v] = denseId[rep];
+    }
+}
+
+/*!
+ * @function StrongConnectivity
+ * @abstract Construct StrongConnectivity-type object based on a
+ *           directed graph.
+ * @param target directed graph used as input
+ * @param useParallel use the multithreaded algorithm instead of Tarjan
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+StrongConnectivity::StrongConnectivity(const DiGraph &target, bool useParallel, int numThreads)
+    : g(target), compId(target.V(), -1), _count(0)
+{
+    if (useParallel)
+    {
+        parallelSCC(numThreads);
+        return;
+    }
+
+    int V = g.V();
+    std::vector<char> active(V, 1);
+    std::vector<int> label(V, -1);
+    std::vector<int> completed;
+    completed.reserve(V);
+    tarjan(active, label, completed);
+
+    // Number components in the order Tarjan completes them
+    std::vector<int> denseId(V, -1);
+    for (int rep : completed)
+        denseId[rep] = _count++;
+    for (int v = 0; v < V; v++)
+        compId[v] = denseId[label[v]];
+}
+
+/*!
+ * @function StrongConnectivity
+ * @abstract Copy constructor for StrongConnectivity-type object.
+ * @param other another StrongConnectivity-type object
+ */
+StrongConnectivity::StrongConnectivity(const StrongConnectivity &other)
+    : g(other.g), compId(other.compId), _count(other._count) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for StrongConnectivity-type object.
+ * @param other another StrongConnectivity-type object
+ */
+StrongConnectivity &StrongConnectivity::operator=(const StrongConnectivity &other)
+{
+    StrongConnectivity newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->compId, newCopy.compId);
+    std::swap(this->_count, newCopy._count);
+    return *this;
+}
+
+/*!
+ * @function count
+ * @abstract Return the number of strongly connected components
+ * @return the number of strongly connected components
+ */
+int StrongConnectivity::count() const { return _count; }
+
+/*!
+ * @function id
+ * @abstract Return the component id of the queried vertex. Ids are dense
+ *           in [0, count()). With the sequential algorithm the ids are
+ *           in reverse topological order of the condensation.
+ * @param v the queried vertex id
+ * @return the strongly connected component id of v
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int StrongConnectivity::id(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Strong Connectivity: vertex " + std::to_string(v) + " is not in graph");
+    return compId[g.index(v)];
+}
+
+/*!
+ * @function ids
+ * @abstract Return component ids of all vertices, indexed by the
+ *           position of the vertex in DiGraph::getVertices()
+ * @return const reference to the dense component id array
+ */
+const std::vector<int> &StrongConnectivity::ids() const { return compId; }
+
+/*!
+ * @function isStronglyConnected
+ * @abstract Indicates if two vertices are in the same strongly connected
+ *           component. This function has the same effect as id[v] == id[w].
+ * @param v the first queried vertex
+ * @param w the second queried vertex
+ * @return true if v and w are strongly connected, false otherwise
+ * @exception throws std::out_of_range if v or w is not in the graph
+ */
+bool StrongConnectivity::isStronglyConnected(int v, int w) const { return id(v) == id(w); }
+
+/*!
+ * @function condensation
+ * @abstract Build the condensation DAG in which vertex c is component c
+ *           and there is one edge of weight 1 between two components
+ *           whenever any edge of the graph connects them.
+ * @return the condensation as a CompactDiGraph over component ids
+ */
+CompactDiGraph StrongConnectivity::condensation() const
+{
+    int V = g.V();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
+
+    // Group vertices by component with a counting sort
+    std::vector<size_t> memberStart(_count + 1, 0);
+    for (int c : compId)
+        memberStart[c + 1]++;
+    for (int c = 0; c < _count; c++)
+        memberStart[c + 1] += memberStart[c];
+    std::vector<int> members(V);
+    std::vector<size_t> cursor(memberStart.begin(), memberStart.end() - 1);
+    for (int v = 0; v < V; v++)
+        members[cursor[compId[v]]++] = v;
+
+    // Emit each distinct inter-component edge once
+    std::vector<size_t> dagOffsets(_count + 1, 0);
+    std::vector<int> dagTargets;
+    std::vector<int> lastSource(_count, -1);
+    for (int c = 0; c < _count; c++)
+    {
+        for (size_t m = memberStart[c]; m < memberStart[c + 1]; m++)
+        {
+            int v = members[m];
+            for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+            {
+                int d = compId[targets[e]];
+                if (d != c && lastSource[d] != c)
+                {
+                    lastSource[d] = c;
+                    dagTargets.push_back(d);
+                }
+            }
+        }
+        dagOffsets[c + 1] = dagTargets.size();
+    }
+
+    std::vector<double> dagWeights(dagTargets.size(), 1);
+    return CompactDiGraph(std::move(dagOffsets), std::move(dagTargets), std::move(dagWeights));
+}
@@ -1,4 +1,110 @@
-/**
- * Kosaraju
- * Tarjan
- */
\ No newline at end of file
+/**strong-connectivity.hpp
+ *
+ * Two vertices of a directed graph are strongly connected if there is a
+ * directed path from each one to the other. Strongly connected components
+ * (SCCs) are the maximal sets of mutually strongly connected vertices.
+ *
+ * This routine labels every vertex with a dense component id in the range
+ * 0 to count() - 1 and builds the condensation DAG on those ids. The
+ * sequential mode runs an iterative Tarjan, so graph depth is bounded by
+ * heap memory rather than the call stack. The parallel mode trims trivial
+ * SCCs, peels the giant SCC with a forward-backward search and resolves
+ * the remainder by color propagation before finishing small leftovers
+ * with Tarjan.
+ */
+
+#ifndef STRONG_CONNECTIVITY
+#define STRONG_CONNECTIVITY
+
+#include <vector>
+#include "graph/digraph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class StrongConnectivity
+{
+private:
+    CompactDiGraph g;
+    std::vector<int> compId;
+    int _count;
+
+    // Iterative Tarjan over the active vertices; labels each SCC with its
+    // root index and appends roots to completed in reverse topological order
+    void tarjan(const std::vector<char> &active, std::vector<int> &label, std::vector<int> &completed);
+
+    // Trimming, forward-backward and coloring phases of the parallel mode
+    void parallelSCC(int numThreads);
+
+public:
+    /*!
+     * @function StrongConnectivity
+     * @abstract Construct StrongConnectivity-type object based on a
+     *           directed graph.
+     * @param target directed graph used as input
+     * @param useParallel use the multithreaded algorithm instead of Tarjan
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    StrongConnectivity(const DiGraph &target, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function StrongConnectivity
+     * @abstract Copy constructor for StrongConnectivity-type object.
+     * @param other another StrongConnectivity-type object
+     */
+    StrongConnectivity(const StrongConnectivity &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for StrongConnectivity-type object.
+     * @param other another StrongConnectivity-type object
+     */
+    StrongConnectivity &operator=(const StrongConnectivity &other);
+
+    /*!
+     * @function count
+     * @abstract Return the number of strongly connected components
+     * @return the number of strongly connected components
+     */
+    int count() const;
+
+    /*!
+     * @function id
+     * @abstract Return the component id of the queried vertex. Ids are dense
+     *           in [0, count()). With the sequential algorithm the ids are
+     *           in reverse topological order of the condensation.
+     * @param v the queried vertex id
+     * @return the strongly connected component id of v
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int id(int v) const;
+
+    /*!
+     * @function ids
+     * @abstract Return component ids of all vertices, indexed by the
+     *           position of the vertex in DiGraph::getVertices()
+     * @return const reference to the dense component id array
+     */
+    const std::vector<int> &ids() const;
+
+    /*!
+     * @function isStronglyConnected
+     * @abstract Indicates if two vertices are in the same strongly connected
+     *           component. This function has the same effect as id[v] == id[w].
+     * @param v the first queried vertex
+     * @param w the second queried vertex
+     * @return true if v and w are strongly connected, false otherwise
+     * @exception throws std::out_of_range if v or w is not in the graph
+     */
+    bool isStronglyConnected(int v, int w) const;
+
+    /*!
+     * @function condensation
+     * @abstract Build the condensation DAG in which vertex c is component c
+     *           and there is one edge of weight 1 between two components
+     *           whenever any edge of the graph connects them.
+     * @return the condensation as a CompactDiGraph over component ids
+     */
+    CompactDiGraph condensation() const;
+};
+
+#endif /*STRONG_CONNECTIVITY*/
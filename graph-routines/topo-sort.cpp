@@ -0,0 +1,210 @@
+/**topo-sort.cpp
+ *
+ * A topological order of a directed acyclic graph (DAG) is a linear
+ * ordering of its vertices such that for every edge v -> w, v comes
+ * before w. Only DAGs have a topological order.
+ *
+ * This routine runs Kahn's algorithm one level at a time, so besides the
+ * order it partitions the vertices into levels by longest-path depth:
+ * level 0 holds the sources and every vertex of level k has a predecessor
+ * in level k - 1. All vertices of one level are mutually independent and
+ * can be scheduled together. The parallel mode processes each level with
+ * atomic in-degree counters.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "topo-sort.hpp"
+#include "utils/parallel.hpp"
+
+// Level-synchronous Kahn; fills _order with dense indices level by level
+void TopologicalSort::kahnLevels(bool useParallel, int numThreads)
+{
+    int V = g.V();
+    const std::vector<size_t> &offsets = g.getOffsets();
+    const std::vector<int> &targets = g.getTargets();
+    numThreads = useParallel ? resolveThreads(numThreads) : 1;
+
+    std::vector<std::atomic<int>> inDeg(V);
+    std::vector<std::vector<int>> local(numThreads);
+    _order.reserve(V);
+    levelOffsets.assign(1, 0);
+
+    // In-degrees and sources
+    parallelFor(0, V, [&](size_t v, int)
+                { inDeg[v].store(0, std::memory_order_relaxed); },
+                numThreads);
+    parallelFor(0, V, [&](size_t v, int)
+                {
+                    for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+                        inDeg[targets[e]].fetch_add(1, std::memory_order_relaxed); },
+                numThreads);
+    for (int v = 0; v < V; v++)
+        if (inDeg[v].load(std::memory_order_relaxed) == 0)
+            _order.push_back(v);
+
+    // Each pass releases the vertices whose last predecessor was in the
+    // previous level, so a vertex lands on its longest-path depth
+    size_t levelBegin = 0;
+    while (levelBegin < _order.size())
+    {
+        size_t levelEnd = _order.size();
+        levelOffsets.push_back(levelEnd);
+        parallelFor(levelBegin, levelEnd, [&](size_t i, int t)
+                    {
+                        int v = _order[i];
+                        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+                        {
+                            int w = targets[e];
+                            if (inDeg[w].fetch_sub(1, std::memory_order_relaxed) == 1)
+                                local[t].push_back(w);
+                        } },
+                    numThreads, 256);
+
+        // Keep the output independent of thread scheduling
+        for (std::vector<int> &buf : local)
+        {
+            _order.insert(_order.end(), buf.begin(), buf.end());
+            buf.clear();
+        }
+        std::sort(_order.begin() + levelEnd, _order.end());
+        levelBegin = levelEnd;
+    }
+
+    _isDAG = _order.size() == static_cast<size_t>(V);
+    if (!_isDAG)
+    {
+        _order.clear();
+        levelOffsets.assign(1, 0);
+        return;
+    }
+
+    depth.resize(V);
+    for (size_t k = 0; k + 1 < levelOffsets.size(); k++)
+        for (size_t i = levelOffsets[k]; i < levelOffsets[k + 1]; i++)
+            depth[_order[i]] = k;
+}
+
+/*!
+ * @function TopologicalSort
+ * @abstract Construct TopologicalSort-type object based on a
+ *           directed graph.
+ * @param target directed graph used as input
+ * @param useParallel process each level with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+TopologicalSort::TopologicalSort(const DiGraph &target, bool useParallel, int numThreads)
+    : g(target), _isDAG(true)
+{
+    kahnLevels(useParallel, numThreads);
+}
+
+/*!
+ * @function TopologicalSort
+ * @abstract Copy constructor for TopologicalSort-type object.
+ * @param other another TopologicalSort-type object
+ */
+TopologicalSort::TopologicalSort(const TopologicalSort &other)
+    : g(other.g), _order(other._order), levelOffsets(other.levelOffsets),
+      depth(other.depth), _isDAG(other._isDAG) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for TopologicalSort-type object.
+ * @param other another TopologicalSort-type object
+ */
+TopologicalSort &TopologicalSort::operator=(const TopologicalSort &other)
+{
+    TopologicalSort newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->_order, newCopy._order);
+    std::swap(this->levelOffsets, newCopy.levelOffsets);
+    std::swap(this->depth, newCopy.depth);
+    std::swap(this->_isDAG, newCopy._isDAG);
+    return *this;
+}
+
+/*!
+ * @function isDAG
+ * @abstract Checks whether the graph has a topological order
+ * @return true if the graph is acyclic, false otherwise
+ */
+bool TopologicalSort::isDAG() const { return _isDAG; }
+
+/*!
+ * @function order
+ * @abstract Returns the vertices in topological order, level by level.
+ *           Within a level vertices follow DiGraph::getVertices().
+ * @return vertex ids in topological order, empty if the graph is cyclic
+ */
+std::vector<int> TopologicalSort::order() const
+{
+    std::vector<int> ids;
+    ids.reserve(_order.size());
+    for (int idx : _order)
+        ids.push_back(g.id(idx));
+    return ids;
+}
+
+/*!
+ * @function levelCount
+ * @abstract Returns the number of levels, i.e. the number of vertices
+ *           on the longest path of the DAG
+ * @return number of levels, 0 if the graph is empty or cyclic
+ */
+int TopologicalSort::levelCount() const { return levelOffsets.size() - 1; }
+
+/*!
+ * @function level
+ * @abstract Returns the vertices whose longest incoming path has k edges
+ * @param k the level to query
+ * @return vertex ids of level k
+ * @exception throws std::out_of_range if k is not in [0, levelCount())
+ */
+std::vector<int> TopologicalSort::level(int k) const
+{
+    if (k < 0 || k >= levelCount())
+        throw std::out_of_range("Topological sort: level " + std::to_string(k) + " does not exist");
+
+    std::vector<int> ids;
+    ids.reserve(levelOffsets[k + 1] - levelOffsets[k]);
+    for (size_t i = levelOffsets[k]; i < levelOffsets[k + 1]; i++)
+        ids.push_back(g.id(_order[i]));
+    return ids;
+}
+
+/*!
+ * @function levels
+ * @abstract Returns all level sets in increasing depth
+ * @return one vector of vertex ids per level, empty if the graph is cyclic
+ */
+std::vector<std::vector<int>> TopologicalSort::levels() const
+{
+    std::vector<std::vector<int>> sets;
+    sets.reserve(levelCount());
+    for (int k = 0; k < levelCount(); k++)
+        sets.push_back(level(k));
+    return sets;
+}
+
+/*!
+ * @function levelOf
+ * @abstract Returns the level of vertex v
+ * @param v the queried vertex id
+ * @return level of v
+ * @exception throws std::out_of_range if v is not in the graph
+ * @exception throws std::logic_error if the graph is cyclic
+ */
+int TopologicalSort::levelOf(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Topological sort: vertex " + std::to_string(v) + " is not in graph");
+    if (!_isDAG)
+        throw std::logic_error("Topological sort: graph is cyclic");
+    return depth[g.index(v)];
+}
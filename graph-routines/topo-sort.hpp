@@ -0,0 +1,110 @@
+/**topo-sort.hpp
+ *
+ * A topological order of a directed acyclic graph (DAG) is a linear
+ * ordering of its vertices such that for every edge v -> w, v comes
+ * before w. Only DAGs have a topological order.
+ *
+ * This routine runs Kahn's algorithm one level at a time, so besides the
+ * order it partitions the vertices into levels by longest-path depth:
+ * level 0 holds the sources and every vertex of level k has a predecessor
+ * in level k - 1. All vertices of one level are mutually independent and
+ * can be scheduled together. The parallel mode processes each level with
+ * atomic in-degree counters.
+ */
+
+#ifndef TOPO_SORT
+#define TOPO_SORT
+
+#include <vector>
+#include "graph/digraph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class TopologicalSort
+{
+private:
+    CompactDiGraph g;
+    std::vector<int> _order;
+    std::vector<size_t> levelOffsets;
+    std::vector<int> depth;
+    bool _isDAG;
+
+    // Level-synchronous Kahn; fills _order with dense indices level by level
+    void kahnLevels(bool useParallel, int numThreads);
+
+public:
+    /*!
+     * @function TopologicalSort
+     * @abstract Construct TopologicalSort-type object based on a
+     *           directed graph.
+     * @param target directed graph used as input
+     * @param useParallel process each level with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    TopologicalSort(const DiGraph &target, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function TopologicalSort
+     * @abstract Copy constructor for TopologicalSort-type object.
+     * @param other another TopologicalSort-type object
+     */
+    TopologicalSort(const TopologicalSort &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for TopologicalSort-type object.
+     * @param other another TopologicalSort-type object
+     */
+    TopologicalSort &operator=(const TopologicalSort &other);
+
+    /*!
+     * @function isDAG
+     * @abstract Checks whether the graph has a topological order
+     * @return true if the graph is acyclic, false otherwise
+     */
+    bool isDAG() const;
+
+    /*!
+     * @function order
+     * @abstract Returns the vertices in topological order, level by level.
+     *           Within a level vertices follow DiGraph::getVertices().
+     * @return vertex ids in topological order, empty if the graph is cyclic
+     */
+    std::vector<int> order() const;
+
+    /*!
+     * @function levelCount
+     * @abstract Returns the number of levels, i.e. the number of vertices
+     *           on the longest path of the DAG
+     * @return number of levels, 0 if the graph is empty or cyclic
+     */
+    int levelCount() const;
+
+    /*!
+     * @function level
+     * @abstract Returns the vertices whose longest incoming path has k edges
+     * @param k the level to query
+     * @return vertex ids of level k
+     * @exception throws std::out_of_range if k is not in [0, levelCount())
+     */
+    std::vector<int> level(int k) const;
+
+    /*!
+     * @function levels
+     * @abstract Returns all level sets in increasing depth
+     * @return one vector of vertex ids per level, empty if the graph is cyclic
+     */
+    std::vector<std::vector<int>> levels() const;
+
+    /*!
+     * @function levelOf
+     * @abstract Returns the level of vertex v
+     * @param v the queried vertex id
+     * @return level of v
+     * @exception throws std::out_of_range if v is not in the graph
+     * @exception throws std::logic_error if the graph is cyclic
+     */
+    int levelOf(int v) const;
+};
+
+#endif /*TOPO_SORT*/
@@ -0,0 +1,189 @@
+/**transitive-closure.cpp
+ *
+ * Transitive closure as one bitset row per strongly connected component,
+ * filled in reverse topological order of the condensation.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "transitive-closure.hpp"
+#include "strong-connectivity.hpp"
+#include "utils/parallel.hpp"
+
+// dst |= src over the given number of words
+static void orRow(uint64_t *__restrict dst, const uint64_t *__restrict src, size_t words)
+{
+    for (size_t i = 0; i < words; i++)
+        dst[i] |= src[i];
+}
+
+// Position of v in DiGraph::getVertices(), or -1 if v is missing
+int TransitiveClosure::indexOf(int v) const
+{
+    if (idToIndex.empty())
+        return v >= 0 && v < static_cast<int>(ids.size()) ? v : -1;
+    auto it = idToIndex.find(v);
+    return it == idToIndex.end() ? -1 : it->second;
+}
+
+/*!
+ * @function TransitiveClosure
+ * @abstract Construct TransitiveClosure-type object based on a
+ *           directed graph and compute its closure.
+ * @param target directed graph used as input
+ * @param useParallel fill rows with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+TransitiveClosure::TransitiveClosure(const DiGraph &target, bool useParallel, int numThreads)
+{
+    const std::vector<Node> &vertices = target.getVertices();
+    int V = vertices.size();
+    ids.resize(V);
+    bool identity = true;
+    for (int v = 0; v < V; v++)
+    {
+        ids[v] = vertices[v].getId();
+        identity = identity && ids[v] == v;
+    }
+    if (!identity)
+        for (int v = 0; v < V; v++)
+            idToIndex[ids[v]] = v;
+
+    StrongConnectivity scc(target, useParallel, numThreads);
+    comp = scc.ids();
+    CompactDiGraph dag = scc.condensation();
+    int n = scc.count();
+
+    // Height above the sinks; components are visited in reverse topological
+    // order from the out-degree counts, so successors come first
+    std::vector<int> height(n, 0), pending(n), order;
+    std::vector<std::vector<int>> predecessors(n);
+    order.reserve(n);
+    for (int c = 0; c < n; c++)
+    {
+        pending[c] = dag.end(c) - dag.begin(c);
+        for (size_t e = dag.begin(c); e < dag.end(c); e++)
+            predecessors[dag.target(e)].push_back(c);
+        if (pending[c] == 0)
+            order.push_back(c);
+    }
+    for (size_t head = 0; head < order.size(); head++)
+    {
+        int d = order[head];
+        for (int c : predecessors[d])
+        {
+            height[c] = std::max(height[c], height[d] + 1);
+            if (--pending[c] == 0)
+                order.push_back(c);
+        }
+    }
+
+    // Bucket components by height
+    int maxHeight = 0;
+    for (int h : height)
+        maxHeight = std::max(maxHeight, h);
+    std::vector<size_t> bucketStart(maxHeight + 2, 0);
+    for (int h : height)
+        bucketStart[h + 1]++;
+    for (int h = 0; h <= maxHeight; h++)
+        bucketStart[h + 1] += bucketStart[h];
+    std::vector<int> byHeight(n);
+    std::vector<size_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (int c = 0; c < n; c++)
+        byHeight[fill[height[c]]++] = c;
+
+    words = (n + 63) / 64;
+    bits.assign(static_cast<size_t>(n) * words, 0);
+    int threads = useParallel ? resolveThreads(numThreads) : 1;
+    std::vector<std::vector<int>> successors(threads);
+    for (int h = 0; h <= maxHeight; h++)
+    {
+        parallelFor(bucketStart[h], bucketStart[h + 1], [&](size_t i, int t)
+                    {
+                        int c = byHeight[i];
+                        uint64_t *row = &bits[c * words];
+                        row[c / 64] |= uint64_t(1) << (c % 64);
+
+                        // Nearest successors first, so rows they already
+                        // cover are skipped
+                        std::vector<int> &next = successors[t];
+                        next.clear();
+                        for (size_t e = dag.begin(c); e < dag.end(c); e++)
+                            next.push_back(dag.target(e));
+                        std::sort(next.begin(), next.end(), [&height](int a, int b)
+                                  { return height[a] > height[b]; });
+                        for (int d : next)
+                            if (!(row[d / 64] >> (d % 64) & 1))
+                                orRow(row, &bits[d * words], words);
+                    },
+                    threads, 64);
+    }
+}
+
+/*!
+ * @function TransitiveClosure
+ * @abstract Copy constructor for TransitiveClosure-type object.
+ * @param other another TransitiveClosure-type object
+ */
+TransitiveClosure::TransitiveClosure(const TransitiveClosure &other)
+    : ids(other.ids), idToIndex(other.idToIndex), comp(other.comp), bits(other.bits), words(other.words) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for TransitiveClosure-type object.
+ * @param other another TransitiveClosure-type object
+ */
+TransitiveClosure &TransitiveClosure::operator=(const TransitiveClosure &other)
+{
+    TransitiveClosure newCopy(other);
+    std::swap(this->ids, newCopy.ids);
+    std::swap(this->idToIndex, newCopy.idToIndex);
+    std::swap(this->comp, newCopy.comp);
+    std::swap(this->bits, newCopy.bits);
+    std::swap(this->words, newCopy.words);
+    return *this;
+}
+
+/*!
+ * @function reaches
+ * @abstract Checks if there is a directed path from u to v. Every
+ *           vertex reaches itself.
+ * @param u the start vertex
+ * @param v the end vertex
+ * @exception throws std::out_of_range if u or v is not in the graph
+ */
+bool TransitiveClosure::reaches(int u, int v) const
+{
+    int iu = indexOf(u), iv = indexOf(v);
+    if (iu == -1 || iv == -1)
+        throw std::out_of_range("Transitive closure: vertex " + std::to_string(iu == -1 ? u : v) + " is not in graph");
+    size_t c = comp[iu], d = comp[iv];
+    return bits[c * words + d / 64] >> (d % 64) & 1;
+}
+
+/*!
+ * @function reachableFrom
+ * @abstract Returns every vertex reachable from u, including u
+ * @param u the start vertex
+ * @return vertices ordered as in DiGraph::getVertices()
+ * @exception throws std::out_of_range if u is not in the graph
+ */
+std::vector<int> TransitiveClosure::reachableFrom(int u) const
+{
+    int iu = indexOf(u);
+    if (iu == -1)
+        throw std::out_of_range("Transitive closure: vertex " + std::to_string(u) + " is not in graph");
+    const uint64_t *row = &bits[comp[iu] * words];
+    std::vector<int> reached;
+    for (size_t v = 0; v < ids.size(); v++)
+        if (row[comp[v] / 64] >> (comp[v] % 64) & 1)
+            reached.push_back(ids[v]);
+    return reached;
+}
+
+// Return number of strongly connected components
+int TransitiveClosure::components() const { return words == 0 ? 0 : bits.size() / words; }
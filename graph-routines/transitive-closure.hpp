@@ -0,0 +1,91 @@
+/**transitive-closure.hpp
+ *
+ * Materialized transitive closure of a directed graph for graphs small
+ * enough to afford one bit per pair of strongly connected components.
+ * After construction every reachability query is a single bit test.
+ *
+ * Vertices of one strongly connected component reach exactly the same
+ * vertices, so the closure keeps one packed row of 64-bit words per
+ * component of the condensation DAG. Rows are filled from the sinks
+ * upwards: a component's row is its own bit OR-ed with the rows of its
+ * successors, word by word in a loop the compiler vectorizes.
+ * Successors are merged nearest first, and one whose bit is already set
+ * is skipped because its row is contained in the result.
+ *
+ * Components with the same height above the sinks do not depend on each
+ * other, so the parallel mode fills every height in parallel.
+ */
+
+#ifndef TRANSITIVE_CLOSURE
+#define TRANSITIVE_CLOSURE
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "graph/digraph.hpp"
+
+class TransitiveClosure
+{
+private:
+    std::vector<int> ids;
+    // Empty when every vertex id equals its position
+    std::unordered_map<int, int> idToIndex;
+    // Component of every vertex
+    std::vector<int> comp;
+    // Row of component c is bits[c * words] to bits[(c + 1) * words - 1]
+    std::vector<uint64_t> bits;
+    size_t words;
+
+    // Position of v in DiGraph::getVertices(), or -1 if v is missing
+    int indexOf(int v) const;
+
+public:
+    /*!
+     * @function TransitiveClosure
+     * @abstract Construct TransitiveClosure-type object based on a
+     *           directed graph and compute its closure.
+     * @param target directed graph used as input
+     * @param useParallel fill rows with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    TransitiveClosure(const DiGraph &target, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function TransitiveClosure
+     * @abstract Copy constructor for TransitiveClosure-type object.
+     * @param other another TransitiveClosure-type object
+     */
+    TransitiveClosure(const TransitiveClosure &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for TransitiveClosure-type object.
+     * @param other another TransitiveClosure-type object
+     */
+    TransitiveClosure &operator=(const TransitiveClosure &other);
+
+    /*!
+     * @function reaches
+     * @abstract Checks if there is a directed path from u to v. Every
+     *           vertex reaches itself.
+     * @param u the start vertex
+     * @param v the end vertex
+     * @exception throws std::out_of_range if u or v is not in the graph
+     */
+    bool reaches(int u, int v) const;
+
+    /*!
+     * @function reachableFrom
+     * @abstract Returns every vertex reachable from u, including u
+     * @param u the start vertex
+     * @return vertices ordered as in DiGraph::getVertices()
+     * @exception throws std::out_of_range if u is not in the graph
+     */
+    std::vector<int> reachableFrom(int u) const;
+
+    // Return number of strongly connected components
+    int components() const;
+};
+
+#endif /*TRANSITIVE_CLOSURE*/
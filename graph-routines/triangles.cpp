@@ -0,0 +1,248 @@
+/**triangles.cpp
+ *
+ * A triangle is a set of three mutually adjacent vertices of an
+ * undirected graph. Every triangle is found once as the intersection of
+ * two sorted out-neighbor arrays of the degree-ordered orientation.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "triangles.hpp"
+#include "utils/parallel.hpp"
+
+// Invoke onMatch(x) for every x present in both sorted arrays a and b
+template <typename Func>
+static void intersect(const int *a, size_t na, const int *b, size_t nb, Func onMatch)
+{
+    size_t i = 0, j = 0;
+#ifdef __SSE2__
+    // Compare four elements of a against all rotations of four elements of
+    // b, then advance whichever block ends with the smaller value
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(hit));
+        for (int k = 0; mask != 0; k++, mask >>= 1)
+            if (mask & 1)
+                onMatch(a[i + k]);
+
+        int aLast = a[i + 3], bLast = b[j + 3];
+        if (aLast <= bLast)
+            i += 4;
+        if (bLast <= aLast)
+            j += 4;
+    }
+#endif
+    while (i < na && j < nb)
+    {
+        if (a[i] < b[j])
+            i++;
+        else if (b[j] < a[i])
+            j++;
+        else
+        {
+            onMatch(a[i]);
+            i++;
+            j++;
+        }
+    }
+}
+
+// Count triangles on the degree-ordered orientation of g
+void TriangleCount::countTriangles(int numThreads)
+{
+    int V = g.V();
+    std::vector<int> degree(V, 0);
+    for (int v = 0; v < V; v++)
+        for (size_t e = g.begin(v); e < g.end(v); e++)
+            degree[v] += g.target(e) != v;
+
+    // rank[v] is the position of v when sorted by degree, then index
+    std::vector<int> byDegree(V), rank(V);
+    std::iota(byDegree.begin(), byDegree.end(), 0);
+    std::sort(byDegree.begin(), byDegree.end(), [&degree](int a, int b)
+              { return degree[a] != degree[b] ? degree[a] < degree[b] : a < b; });
+    for (int r = 0; r < V; r++)
+        rank[byDegree[r]] = r;
+
+    // Out-neighbors of each rank, keeping only edges to higher ranks
+    std::vector<size_t> offsets(V + 1, 0);
+    for (int v = 0; v < V; v++)
+        for (size_t e = g.begin(v); e < g.end(v); e++)
+            if (rank[g.target(e)] > rank[v])
+                offsets[rank[v] + 1]++;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int> out(offsets[V]);
+    parallelFor(0, V, [&](size_t v, int)
+                {
+                    size_t pos = offsets[rank[v]];
+                    for (size_t e = g.begin(v); e < g.end(v); e++)
+                        if (rank[g.target(e)] > rank[v])
+                            out[pos++] = rank[g.target(e)];
+                    std::sort(out.begin() + offsets[rank[v]], out.begin() + pos); },
+                numThreads, 256);
+
+    // Triangle (u, v, w) with u < v < w in rank order is found at edge u -> v
+    std::vector<std::atomic<long long>> byRank(V);
+    parallelFor(0, V, [&](size_t r, int)
+                { byRank[r].store(0, std::memory_order_relaxed); },
+                numThreads);
+    parallelFor(0, V, [&](size_t u, int)
+                {
+                    const int *outU = out.data() + offsets[u];
+                    size_t degU = offsets[u + 1] - offsets[u];
+                    long long atU = 0;
+                    for (size_t k = 0; k < degU; k++)
+                    {
+                        int v = outU[k];
+                        long long atV = 0;
+                        intersect(outU, degU, out.data() + offsets[v], offsets[v + 1] - offsets[v], [&](int w)
+                                  {
+                                      atV++;
+                                      byRank[w].fetch_add(1, std::memory_order_relaxed); });
+                        if (atV > 0)
+                            byRank[v].fetch_add(atV, std::memory_order_relaxed);
+                        atU += atV;
+                    }
+                    if (atU > 0)
+                        byRank[u].fetch_add(atU, std::memory_order_relaxed); },
+                numThreads, 64);
+
+    // Every triangle is credited to its three corners
+    perVertex.resize(V);
+    long long corners = 0;
+    for (int v = 0; v < V; v++)
+    {
+        perVertex[v] = byRank[rank[v]].load(std::memory_order_relaxed);
+        corners += perVertex[v];
+    }
+    total = corners / 3;
+}
+
+/*!
+ * @function TriangleCount
+ * @abstract Construct TriangleCount-type object based on an
+ *           undirected graph. Self-loops are ignored.
+ * @param target undirected graph used as input
+ * @param useParallel intersect neighbor arrays with multiple threads
+ * @param numThreads number of threads for the parallel mode, 0 selects
+ *                   all hardware threads
+ */
+TriangleCount::TriangleCount(const Graph &target, bool useParallel, int numThreads)
+    : g(target), total(0)
+{
+    countTriangles(useParallel ? resolveThreads(numThreads) : 1);
+}
+
+/*!
+ * @function TriangleCount
+ * @abstract Copy constructor for TriangleCount-type object.
+ * @param other another TriangleCount-type object
+ */
+TriangleCount::TriangleCount(const TriangleCount &other)
+    : g(other.g), perVertex(other.perVertex), total(other.total) {}
+
+/*!
+ * @function operator=
+ * @abstract Copy-assignment operator for TriangleCount-type object.
+ * @param other another TriangleCount-type object
+ */
+TriangleCount &TriangleCount::operator=(const TriangleCount &other)
+{
+    TriangleCount newCopy(other);
+    std::swap(this->g, newCopy.g);
+    std::swap(this->perVertex, newCopy.perVertex);
+    std::swap(this->total, newCopy.total);
+    return *this;
+}
+
+// Return number of triangles in the graph
+long long TriangleCount::count() const { return total; }
+
+/*!
+ * @function count
+ * @abstract Returns the number of triangles containing v
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+long long TriangleCount::count(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Triangle count: vertex " + std::to_string(v) + " is not in graph");
+    return perVertex[g.index(v)];
+}
+
+/*!
+ * @function counts
+ * @abstract Returns the number of triangles containing each vertex,
+ *           ordered as in Graph::getVertices()
+ * @return triangles per vertex
+ */
+const std::vector<long long> &TriangleCount::counts() const { return perVertex; }
+
+/*!
+ * @function localClustering
+ * @abstract Returns the fraction of pairs of neighbors of v that are
+ *           adjacent, 0 if v has fewer than two neighbors
+ * @param v the queried vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+double TriangleCount::localClustering(int v) const
+{
+    if (!g.contains(v))
+        throw std::out_of_range("Triangle count: vertex " + std::to_string(v) + " is not in graph");
+    int idx = g.index(v);
+    long long deg = g.simpleDegree(idx);
+    return deg < 2 ? 0 : 2.0 * perVertex[idx] / (deg * (deg - 1));
+}
+
+/*!
+ * @function averageClustering
+ * @abstract Returns the mean local clustering coefficient over all vertices
+ * @return average clustering, 0 for an empty graph
+ */
+double TriangleCount::averageClustering() const
+{
+    if (g.V() == 0)
+        return 0;
+    double sum = 0;
+    for (int idx = 0; idx < static_cast<int>(g.V()); idx++)
+    {
+        long long deg = g.simpleDegree(idx);
+        if (deg >= 2)
+            sum += 2.0 * perVertex[idx] / (deg * (deg - 1));
+    }
+    return sum / g.V();
+}
+
+/*!
+ * @function globalClustering
+ * @abstract Returns three times the number of triangles divided by the
+ *           number of paths of length two
+ * @return transitivity of the graph, 0 if there are no such paths
+ */
+double TriangleCount::globalClustering() const
+{
+    long long wedges = 0;
+    for (int idx = 0; idx < static_cast<int>(g.V()); idx++)
+    {
+        long long deg = g.simpleDegree(idx);
+        wedges += deg * (deg - 1) / 2;
+    }
+    return wedges == 0 ? 0 : 3.0 * total / wedges;
+}
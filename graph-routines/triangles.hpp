@@ -0,0 +1,105 @@
+/**triangles.hpp
+ *
+ * A triangle is a set of three mutually adjacent vertices of an
+ * undirected graph. The local clustering coefficient of v is the fraction
+ * of pairs of neighbors of v that are adjacent, and the global clustering
+ * coefficient (transitivity) is three times the number of triangles over
+ * the number of paths of length two.
+ *
+ * This routine orients every edge from its endpoint of lower degree to
+ * the one of higher degree, breaking ties by index, so that each vertex
+ * keeps at most O(sqrt(E)) out-neighbors. Vertices are relabeled by that
+ * order and every triangle is found exactly once as the intersection of
+ * two sorted out-neighbor arrays, giving O(E^1.5) time. Intersections use
+ * SSE2 block comparisons when available and the vertex loop can be split
+ * across threads.
+ */
+
+#ifndef TRIANGLES
+#define TRIANGLES
+
+#include <vector>
+#include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
+
+class TriangleCount
+{
+private:
+    CompactDiGraph g;
+    std::vector<long long> perVertex;
+    long long total;
+
+    // Count triangles on the degree-ordered orientation of g
+    void countTriangles(int numThreads);
+
+public:
+    /*!
+     * @function TriangleCount
+     * @abstract Construct TriangleCount-type object based on an
+     *           undirected graph. Self-loops are ignored.
+     * @param target undirected graph used as input
+     * @param useParallel intersect neighbor arrays with multiple threads
+     * @param numThreads number of threads for the parallel mode, 0 selects
+     *                   all hardware threads
+     */
+    TriangleCount(const Graph &target, bool useParallel = false, int numThreads = 0);
+
+    /*!
+     * @function TriangleCount
+     * @abstract Copy constructor for TriangleCount-type object.
+     * @param other another TriangleCount-type object
+     */
+    TriangleCount(const TriangleCount &other);
+
+    /*!
+     * @function operator=
+     * @abstract Copy-assignment operator for TriangleCount-type object.
+     * @param other another TriangleCount-type object
+     */
+    TriangleCount &operator=(const TriangleCount &other);
+
+    // Return number of triangles in the graph
+    long long count() const;
+
+    /*!
+     * @function count
+     * @abstract Returns the number of triangles containing v
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    long long count(int v) const;
+
+    /*!
+     * @function counts
+     * @abstract Returns the number of triangles containing each vertex,
+     *           ordered as in Graph::getVertices()
+     * @return triangles per vertex
+     */
+    const std::vector<long long> &counts() const;
+
+    /*!
+     * @function localClustering
+     * @abstract Returns the fraction of pairs of neighbors of v that are
+     *           adjacent, 0 if v has fewer than two neighbors
+     * @param v the queried vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    double localClustering(int v) const;
+
+    /*!
+     * @function averageClustering
+     * @abstract Returns the mean local clustering coefficient over all vertices
+     * @return average clustering, 0 for an empty graph
+     */
+    double averageClustering() const;
+
+    /*!
+     * @function globalClustering
+     * @abstract Returns three times the number of triangles divided by the
+     *           number of paths of length two
+     * @return transitivity of the graph, 0 if there are no such paths
+     */
+    double globalClustering() const;
+};
+
+#endif /*TRIANGLES*/
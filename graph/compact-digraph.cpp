@@ -0,0 +1,238 @@
+/**compact-digraph.cpp
+ *
+ * Read-only compressed sparse row (CSR) snapshot of a weighted directed
+ * graph. Vertices are relabeled to dense indices 0 to V - 1 following
+ * the order of DiGraph::getVertices(), and all outgoing edges are stored
+ * contiguously so that routines can run over plain index arrays.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "compact-digraph.hpp"
+
+/**
+ * Constructors
+ */
+
+// Constructor: create empty snapshot
+CompactDiGraph::CompactDiGraph() : offsets(1, 0) {}
+
+// Constructor: snapshot the current state of a directed graph
+CompactDiGraph::CompactDiGraph(const DiGraph &target)
+{
+    const std::vector<Node> &vertices = target.getVertices();
+    size_t V = vertices.size();
+
+    ids.reserve(V);
+    idToIndex.reserve(V);
+    for (size_t i = 0; i < V; i++)
+    {
+        ids.push_back(vertices[i].getId());
+        idToIndex[vertices[i].getId()] = i;
+    }
+
+    // Count edges from the lists themselves rather than trusting outDegree
+    offsets.resize(V + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < V; i++)
+    {
+        const std::forward_list<Edge> &edges = vertices[i].edges();
+        offsets[i + 1] = offsets[i] + std::distance(edges.begin(), edges.end());
+    }
+
+    targets.resize(offsets[V]);
+    weights.resize(offsets[V]);
+    for (size_t i = 0; i < V; i++)
+    {
+        size_t e = offsets[i];
+        for (const Edge &edge : vertices[i].edges())
+        {
+            targets[e] = idToIndex.at(edge.getTo());
+            weights[e] = edge.getWeight();
+            e++;
+        }
+    }
+}
+
+/*!
+ * @function CompactDiGraph
+ * @abstract Construct a snapshot directly from CSR arrays. Vertex ids
+ *           are set to the dense indices 0 to V - 1.
+ * @param offsets Edge offsets of size V + 1, offsets[0] must be 0
+ * @param targets Dense index of the destination of each edge
+ * @param weights Weight of each edge, same size as targets
+ * @exception throws std::invalid_argument if the arrays are inconsistent
+ */
+CompactDiGraph::CompactDiGraph(std::vector<size_t> offsets, std::vector<int> targets, std::vector<double> weights)
+    : offsets(std::move(offsets)), targets(std::move(targets)), weights(std::move(weights))
+{
+    if (this->offsets.empty() || this->offsets.front() != 0 || this->offsets.back() != this->targets.size())
+        throw std::invalid_argument("CompactDiGraph: offsets do not match edge count");
+    if (this->weights.size() != this->targets.size())
+        throw std::invalid_argument("CompactDiGraph: weights do not match edge count");
+
+    size_t V = this->offsets.size() - 1;
+    for (int t : this->targets)
+        if (t < 0 || static_cast<size_t>(t) >= V)
+            throw std::invalid_argument("CompactDiGraph: edge target " + std::to_string(t) + " is out of range");
+
+    ids.reserve(V);
+    idToIndex.reserve(V);
+    for (size_t i = 0; i < V; i++)
+    {
+        ids.push_back(i);
+        idToIndex[i] = i;
+    }
+}
+
+/**
+ * Accessors
+ */
+
+// Return number of vertices
+size_t CompactDiGraph::V() const { return ids.size(); }
+// Return number of directed edges
+size_t CompactDiGraph::E() const { return targets.size(); }
+
+// Check if the snapshot contains vertex id v
+bool CompactDiGraph::contains(int v) const { return idToIndex.find(v) != idToIndex.end(); }
+
+/*!
+ * @function index
+ * @abstract Return the dense index of vertex id v
+ * @param v The query vertex id
+ * @exception throws std::out_of_range if v is not in the snapshot
+ */
+int CompactDiGraph::index(int v) const
+{
+    auto it = idToIndex.find(v);
+    if (it == idToIndex.end())
+        throw std::out_of_range("CompactDiGraph: vertex " + std::to_string(v) + " is not in graph");
+    return it->second;
+}
+
+// Return the vertex id at dense index idx
+int CompactDiGraph::id(int idx) const { return ids[idx]; }
+
+// Return the outdegree of the vertex at dense index idx
+int CompactDiGraph::outdegree(int idx) const { return offsets[idx + 1] - offsets[idx]; }
+
+// Return the number of edges of idx to other vertices, skipping self-loops
+int CompactDiGraph::simpleDegree(int idx) const
+{
+    int deg = 0;
+    for (size_t e = offsets[idx]; e < offsets[idx + 1]; e++)
+        deg += targets[e] != idx;
+    return deg;
+}
+
+// Offset of the first outgoing edge of idx; edges of idx are [begin, end)
+size_t CompactDiGraph::begin(int idx) const { return offsets[idx]; }
+size_t CompactDiGraph::end(int idx) const { return offsets[idx + 1]; }
+
+// Destination index and weight of the edge stored at offset e
+int CompactDiGraph::target(size_t e) const { return targets[e]; }
+double CompactDiGraph::weight(size_t e) const { return weights[e]; }
+
+// Raw CSR arrays
+const std::vector<size_t> &CompactDiGraph::getOffsets() const { return offsets; }
+const std::vector<int> &CompactDiGraph::getTargets() const { return targets; }
+const std::vector<double> &CompactDiGraph::getWeights() const { return weights; }
+
+// Return the snapshot with every edge reversed, keeping vertex ids
+CompactDiGraph CompactDiGraph::reverse() const
+{
+    size_t V = ids.size();
+    CompactDiGraph rev;
+    rev.ids = ids;
+    rev.idToIndex = idToIndex;
+    rev.offsets.assign(V + 1, 0);
+    rev.targets.resize(targets.size());
+    rev.weights.resize(weights.size());
+
+    // Counting sort of edges by destination
+    for (int t : targets)
+        rev.offsets[t + 1]++;
+    for (size_t i = 0; i < V; i++)
+        rev.offsets[i + 1] += rev.offsets[i];
+
+    std::vector<size_t> cursor(rev.offsets.begin(), rev.offsets.end() - 1);
+    for (size_t v = 0; v < V; v++)
+    {
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+        {
+            size_t pos = cursor[targets[e]]++;
+            rev.targets[pos] = v;
+            rev.weights[pos] = weights[e];
+        }
+    }
+    return rev;
+}
+
+/*!
+ * @function peelOrder
+ * @abstract Repeatedly remove a vertex of minimum simple degree among
+ *           the remaining ones, using the bucket algorithm of Batagelj
+ *           and Zaversnik in O(V + E). Meant for snapshots of undirected
+ *           graphs, whose edges are stored in both directions.
+ * @param removalDegree set to the degree of every vertex when it was
+ *                      removed, which is its core number
+ * @return dense indices in removal order
+ */
+std::vector<int> CompactDiGraph::peelOrder(std::vector<int> &removalDegree) const
+{
+    int V = ids.size();
+    std::vector<int> &deg = removalDegree;
+    deg.assign(V, 0);
+    int maxDeg = 0;
+    for (int v = 0; v < V; v++)
+    {
+        deg[v] = simpleDegree(v);
+        maxDeg = std::max(maxDeg, deg[v]);
+    }
+
+    // vert holds vertices sorted by degree, bin[d] the start of degree d
+    std::vector<int> bin(maxDeg + 2, 0), vert(V), pos(V);
+    for (int v = 0; v < V; v++)
+        bin[deg[v] + 1]++;
+    for (int d = 1; d <= maxDeg + 1; d++)
+        bin[d] += bin[d - 1];
+    for (int v = 0; v < V; v++)
+    {
+        pos[v] = bin[deg[v]]++;
+        vert[pos[v]] = v;
+    }
+    for (int d = maxDeg + 1; d > 0; d--)
+        bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    // The vertex at position i has minimum degree among the rest. Each
+    // neighbor of higher degree moves down one bucket by swapping with the
+    // first vertex of its bucket.
+    for (int i = 0; i < V; i++)
+    {
+        int v = vert[i];
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+        {
+            int w = targets[e];
+            if (deg[w] > deg[v])
+            {
+                int dw = deg[w], pw = pos[w];
+                int first = bin[dw], u = vert[first];
+                if (u != w)
+                {
+                    std::swap(vert[pw], vert[first]);
+                    pos[u] = pw;
+                    pos[w] = first;
+                }
+                bin[dw]++;
+                deg[w]--;
+            }
+        }
+    }
+    return vert;
+}
@@ -0,0 +1,109 @@
+/**compact-digraph.hpp
+ *
+ * Read-only compressed sparse row (CSR) snapshot of a weighted directed
+ * graph. Vertices are relabeled to dense indices 0 to V - 1 following
+ * the order of DiGraph::getVertices(), and all outgoing edges are stored
+ * contiguously so that routines can run over plain index arrays.
+ *
+ * An undirected Graph is stored with both directions of every edge, so
+ * E() counts each undirected edge twice.
+ */
+
+#ifndef COMPACT_DIGRAPH
+#define COMPACT_DIGRAPH
+
+#include <unordered_map>
+#include <vector>
+
+#include "digraph.hpp"
+
+class CompactDiGraph
+{
+private:
+    std::vector<int> ids;
+    std::unordered_map<int, int> idToIndex;
+    std::vector<size_t> offsets;
+    std::vector<int> targets;
+    std::vector<double> weights;
+
+public:
+    /**
+     * Constructors
+     */
+
+    // Constructor: create empty snapshot
+    CompactDiGraph();
+
+    // Constructor: snapshot the current state of a directed graph
+    CompactDiGraph(const DiGraph &target);
+
+    /*!
+     * @function CompactDiGraph
+     * @abstract Construct a snapshot directly from CSR arrays. Vertex ids
+     *           are set to the dense indices 0 to V - 1.
+     * @param offsets Edge offsets of size V + 1, offsets[0] must be 0
+     * @param targets Dense index of the destination of each edge
+     * @param weights Weight of each edge, same size as targets
+     * @exception throws std::invalid_argument if the arrays are inconsistent
+     */
+    CompactDiGraph(std::vector<size_t> offsets, std::vector<int> targets, std::vector<double> weights);
+
+    /**
+     * Accessors
+     */
+
+    // Return number of vertices
+    size_t V() const;
+    // Return number of directed edges
+    size_t E() const;
+
+    // Check if the snapshot contains vertex id v
+    bool contains(int v) const;
+
+    /*!
+     * @function index
+     * @abstract Return the dense index of vertex id v
+     * @param v The query vertex id
+     * @exception throws std::out_of_range if v is not in the snapshot
+     */
+    int index(int v) const;
+
+    // Return the vertex id at dense index idx
+    int id(int idx) const;
+
+    // Return the outdegree of the vertex at dense index idx
+    int outdegree(int idx) const;
+
+    // Return the number of edges of idx to other vertices, skipping self-loops
+    int simpleDegree(int idx) const;
+
+    // Offset of the first outgoing edge of idx; edges of idx are [begin, end)
+    size_t begin(int idx) const;
+    size_t end(int idx) const;
+
+    // Destination index and weight of the edge stored at offset e
+    int target(size_t e) const;
+    double weight(size_t e) const;
+
+    // Raw CSR arrays
+    const std::vector<size_t> &getOffsets() const;
+    const std::vector<int> &getTargets() const;
+    const std::vector<double> &getWeights() const;
+
+    // Return the snapshot with every edge reversed, keeping vertex ids
+    CompactDiGraph reverse() const;
+
+    /*!
+     * @function peelOrder
+     * @abstract Repeatedly remove a vertex of minimum simple degree among
+     *           the remaining ones, using the bucket algorithm of Batagelj
+     *           and Zaversnik in O(V + E). Meant for snapshots of undirected
+     *           graphs, whose edges are stored in both directions.
+     * @param removalDegree set to the degree of every vertex when it was
+     *                      removed, which is its core number
+     * @return dense indices in removal order
+     */
+    std::vector<int> peelOrder(std::vector<int> &removalDegree) const;
+};
+
+#endif /*COMPACT_DIGRAPH*/
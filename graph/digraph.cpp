@@ -77,6 +77,21 @@ const std::vector<Node> &DiGraph::getVertices() const { return vertices; }
 // Check if the graph contains v
 bool DiGraph::contains(int v) const { return idToIndex.find(v) != idToIndex.end(); }
 
+/*!
+ * @function indexOf
+ * @abstract Return the position of vertex v in getVertices(). Positions
+ *           shift when a vertex before v is erased.
+ * @param v The query vertex
+ * @exception throws std::out_of_range if v is not in the graph
+ */
+int DiGraph::indexOf(int v) const
+{
+    auto it = idToIndex.find(v);
+    if (it == idToIndex.end())
+        throw std::out_of_range("Index query error: vertex " + std::to_string(v) + " is not in graph");
+    return it->second;
+}
+
 // Serialization of the graph
 std::string DiGraph::toString(std::string delim, bool doSort, int weightPrecision)
 {
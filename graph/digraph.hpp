@@ -56,6 +56,15 @@ public:
     // Check if the graph contains v
     bool contains(int v) const;
 
+    /*!
+     * @function indexOf
+     * @abstract Return the position of vertex v in getVertices(). Positions
+     *           shift when a vertex before v is erased.
+     * @param v The query vertex
+     * @exception throws std::out_of_range if v is not in the graph
+     */
+    int indexOf(int v) const;
+
     // Serialization of the graph
     std::string toString(std::string delim = ",", bool doSort = false, int weightPrecision = 2);
 
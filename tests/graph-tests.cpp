@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include "graph/digraph.hpp"
 #include "graph/graph.hpp"
+#include "graph/compact-digraph.hpp"
 
 constexpr unsigned int STRESS_TEST_SAMPLE_COUNT = 10000;
 
@@ -139,6 +140,19 @@ TEST(DiGraphTest, EraseVertex)
     EXPECT_EQ(g.toString(",", true), expected);
 }
 
+TEST(DiGraphTest, IndexOf)
+{
+    DiGraph g({5, -2, 9});
+    EXPECT_EQ(g.indexOf(5), 0);
+    EXPECT_EQ(g.indexOf(9), 2);
+    EXPECT_THROW(g.indexOf(0), std::out_of_range);
+
+    g.eraseVertex(5);
+    EXPECT_EQ(g.indexOf(-2), 0);
+    EXPECT_EQ(g.indexOf(9), 1);
+    EXPECT_EQ(g.getVertices()[g.indexOf(9)].getId(), 9);
+}
+
 TEST(DiGraphTest, MixedOpsWithIntializerList)
 {
     DiGraph g = {0, 2, 4, 6, 8, 10};
@@ -599,3 +613,83 @@ TEST(GraphTest, ConstructFromDirectedGraph)
     EXPECT_EQ(g.V(), 5);
     EXPECT_EQ(g.E(), 4);
 }
+
+/**
+ * Compact Graph Tests
+ */
+
+TEST(CompactDiGraphTest, EmptySnapshot)
+{
+    CompactDiGraph g((DiGraph()));
+    EXPECT_EQ(g.V(), 0);
+    EXPECT_EQ(g.E(), 0);
+    EXPECT_TRUE(!g.contains(0));
+    EXPECT_THROW(g.index(0), std::out_of_range);
+}
+
+TEST(CompactDiGraphTest, SnapshotAndReverse)
+{
+    DiGraph dg({10, -3, 7});
+    dg.insertEdge(10, -3, 2.5);
+    dg.insertEdge(10, 7);
+    dg.insertEdge(7, 10);
+
+    CompactDiGraph g(dg);
+    EXPECT_EQ(g.V(), 3);
+    EXPECT_EQ(g.E(), 3);
+    EXPECT_EQ(g.index(10), 0);
+    EXPECT_EQ(g.index(-3), 1);
+    EXPECT_EQ(g.id(2), 7);
+    EXPECT_EQ(g.outdegree(0), 2);
+    EXPECT_EQ(g.outdegree(1), 0);
+    EXPECT_THROW(g.index(0), std::out_of_range);
+
+    double toMinus3 = -1;
+    for (size_t e = g.begin(0); e < g.end(0); e++)
+        if (g.target(e) == 1)
+            toMinus3 = g.weight(e);
+    EXPECT_EQ(toMinus3, 2.5);
+
+    CompactDiGraph rev = g.reverse();
+    EXPECT_EQ(rev.E(), 3);
+    EXPECT_EQ(rev.outdegree(0), 1);
+    EXPECT_EQ(rev.outdegree(1), 1);
+    EXPECT_EQ(rev.outdegree(2), 1);
+    EXPECT_EQ(rev.target(rev.begin(1)), 0);
+    EXPECT_EQ(rev.weight(rev.begin(1)), 2.5);
+    EXPECT_EQ(rev.index(7), 2);
+}
+
+TEST(CompactDiGraphTest, UndirectedSnapshotStoresBothDirections)
+{
+    Graph ug(4);
+    ug.insertEdge({{0, 1}, {1, 2}, {2, 3}});
+    CompactDiGraph g(ug);
+    EXPECT_EQ(g.E(), 2 * ug.E());
+    EXPECT_EQ(g.outdegree(1), 2);
+}
+
+TEST(CompactDiGraphTest, SimpleDegreeAndPeelOrder)
+{
+    // Triangle 0, 1, 2 with a pendant 3 on 2 and a self-loop on 1
+    Graph ug(4);
+    ug.insertEdge({{0, 1}, {1, 2}, {2, 0}, {2, 3}, {1, 1}});
+    CompactDiGraph g(ug);
+    EXPECT_EQ(g.simpleDegree(1), 2);
+    EXPECT_EQ(g.simpleDegree(2), 3);
+
+    std::vector<int> removalDegree;
+    std::vector<int> order = g.peelOrder(removalDegree);
+    EXPECT_EQ(order.front(), 3);
+    EXPECT_EQ(removalDegree, std::vector<int>({2, 2, 2, 1}));
+}
+
+TEST(CompactDiGraphTest, ConstructFromArrays)
+{
+    CompactDiGraph g({0, 1, 2, 2}, {1, 2}, {1, 1});
+    EXPECT_EQ(g.V(), 3);
+    EXPECT_EQ(g.E(), 2);
+    EXPECT_EQ(g.index(2), 2);
+    EXPECT_THROW(CompactDiGraph({0, 1}, {1}, {1}), std::invalid_argument);
+    EXPECT_THROW(CompactDiGraph({0, 2}, {0}, {1}), std::invalid_argument);
+}
@@ -6,13 +6,56 @@
 #include <gtest/gtest.h>
 #include <stdexcept>
 #include <set>
+#include <map>
+#include <cmath>
+#include <limits>
+#include <array>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <cstdio>
+#include <fstream>
 
 #include "graph/graph.hpp"
 #include "graph/digraph.hpp"
 
 #include "graph-routines/bipartite.hpp"
+#include "graph-routines/online-bipartite.hpp"
 #include "graph-routines/connected-component.hpp"
 #include "graph-routines/cycle.hpp"
+#include "graph-routines/strong-connectivity.hpp"
+#include "graph-routines/topo-sort.hpp"
+#include "graph-routines/dynamic-topo-order.hpp"
+#include "graph-routines/traversal.hpp"
+#include "graph-routines/eulerian.hpp"
+#include "graph-routines/planarity.hpp"
+#include "graph-routines/mst.hpp"
+#include "graph-routines/pagerank.hpp"
+#include "graph-routines/betweenness.hpp"
+#include "graph-routines/triangles.hpp"
+#include "graph-routines/k-core.hpp"
+#include "graph-routines/louvain.hpp"
+#include "graph-routines/label-propagation.hpp"
+#include "graph-routines/max-flow.hpp"
+#include "graph-routines/matching.hpp"
+#include "graph-routines/assignment.hpp"
+#include "graph-routines/global-min-cut.hpp"
+#include "graph-routines/biconnectivity.hpp"
+#include "graph-routines/coloring.hpp"
+#include "graph-routines/reachability-index.hpp"
+#include "graph-routines/transitive-closure.hpp"
+#include "graph-routines/distance-oracle.hpp"
+#include "graph-routines/eccentricity.hpp"
+#include "graph-routines/random-walk.hpp"
+#include "utils/parallel.hpp"
+
+// Advance the linear congruential generator shared by the randomized
+// tests and return a value below bound
+static unsigned int nextRandom(unsigned int &seed, unsigned int bound)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % bound;
+}
 
 /**
  * Bipartite
@@ -58,15 +101,17 @@ TEST_F(BipartiteTest, SmallGraphQuery)
     std::set<int> part2 = {4, 5, 6, 7};
 
     // Check partition
-    if (b.getPart1() == part1)
+    std::set<int> got1(b.getPart1().begin(), b.getPart1().end());
+    std::set<int> got2(b.getPart2().begin(), b.getPart2().end());
+    if (got1 == part1)
     {
-        EXPECT_EQ(b.getPart1(), part1);
-        EXPECT_EQ(b.getPart2(), part2);
+        EXPECT_EQ(got1, part1);
+        EXPECT_EQ(got2, part2);
     }
     else
     {
-        EXPECT_EQ(b.getPart1(), part2);
-        EXPECT_EQ(b.getPart2(), part1);
+        EXPECT_EQ(got1, part2);
+        EXPECT_EQ(got2, part1);
     }
 
     // Check same set query
@@ -96,15 +141,17 @@ TEST_F(BipartiteTest, LargeGraphQuery)
     }
 
     // Check partition
-    if (b.getPart1() == part1)
+    std::set<int> got1(b.getPart1().begin(), b.getPart1().end());
+    std::set<int> got2(b.getPart2().begin(), b.getPart2().end());
+    if (got1 == part1)
     {
-        EXPECT_EQ(b.getPart1(), part1);
-        EXPECT_EQ(b.getPart2(), part2);
+        EXPECT_EQ(got1, part1);
+        EXPECT_EQ(got2, part2);
     }
     else
     {
-        EXPECT_EQ(b.getPart1(), part2);
-        EXPECT_EQ(b.getPart2(), part1);
+        EXPECT_EQ(got1, part2);
+        EXPECT_EQ(got2, part1);
     }
 
     // Check same set query
@@ -146,6 +193,158 @@ TEST_F(BipartiteTest, StressTestUndirectedGraph)
     ASSERT_TRUE(b.isBipartite());
 }
 
+// Check that cycle is a closed walk of odd length over edges of g
+static void expectOddCycle(const Graph &g, const std::vector<int> &cycle)
+{
+    ASSERT_GE(cycle.size(), 2);
+    EXPECT_EQ(cycle.front(), cycle.back());
+    EXPECT_EQ((cycle.size() - 1) % 2, 1);
+    for (size_t i = 0; i + 1 < cycle.size(); i++)
+        EXPECT_TRUE(g.getVertices()[g.indexOf(cycle[i])].hasEdgeTo(cycle[i + 1]));
+}
+
+TEST_F(BipartiteTest, OddCycleWitness)
+{
+    Bipartite b(largeGraph);
+    EXPECT_TRUE(b.oddCycle().empty());
+
+    // Close a 7-cycle with a chord of the even 50-cycle
+    largeGraph.insertEdge(10, 16);
+    Graph g(largeGraph);
+    b = Bipartite(g);
+    ASSERT_TRUE(!b.isBipartite());
+    EXPECT_TRUE(b.getPart1().empty());
+    EXPECT_TRUE(b.getPart2().empty());
+    EXPECT_TRUE(!b.sameSet(0, 2));
+    expectOddCycle(g, b.oddCycle());
+
+    // Self-loop is the shortest odd cycle
+    Graph loop(2);
+    loop.insertEdge({{0, 1}, {1, 1}});
+    Bipartite c(loop);
+    ASSERT_TRUE(!c.isBipartite());
+    EXPECT_EQ(c.oddCycle(), std::vector<int>({1, 1}));
+}
+
+TEST_F(BipartiteTest, ParallelMatchesSequential)
+{
+    // Many grid components with negative ids, then break the last one
+    int side = 60, blocks = 5;
+    Graph g;
+    for (int v = 0; v < side * side * blocks; v++)
+        g.insertVertex(-v);
+    for (int k = 0; k < blocks; k++)
+    {
+        for (int r = 0; r < side; r++)
+        {
+            for (int c = 0; c < side; c++)
+            {
+                int v = k * side * side + r * side + c;
+                if (c + 1 < side)
+                    g.insertEdge(-v, -(v + 1));
+                if (r + 1 < side)
+                    g.insertEdge(-v, -(v + side));
+            }
+        }
+    }
+
+    Bipartite seq(g);
+    Bipartite par(g, true, 4);
+    ASSERT_TRUE(seq.isBipartite());
+    ASSERT_TRUE(par.isBipartite());
+    EXPECT_EQ(seq.getPart1(), par.getPart1());
+    EXPECT_EQ(seq.getPart2(), par.getPart2());
+    EXPECT_EQ(seq.getPart1().size() + seq.getPart2().size(), g.V());
+    for (int v = 1; v < 200; v++)
+        EXPECT_EQ(par.sameSet(0, -v), seq.sameSet(0, -v));
+
+    int base = (blocks - 1) * side * side;
+    g.insertEdge(-base, -(base + side + 1));
+    Bipartite oddSeq(g);
+    Bipartite oddPar(g, true, 4);
+    ASSERT_TRUE(!oddSeq.isBipartite());
+    ASSERT_TRUE(!oddPar.isBipartite());
+    expectOddCycle(g, oddSeq.oddCycle());
+    expectOddCycle(g, oddPar.oddCycle());
+}
+
+/**
+ * Online Bipartite
+ */
+
+TEST(OnlineBipartiteTest, StreamUntilOddCycle)
+{
+    OnlineBipartite ob;
+    for (int v = 0; v < 6; v++)
+        ob.insertVertex(v);
+    EXPECT_THROW(ob.insertEdge(0, 6), std::out_of_range);
+    EXPECT_THROW(ob.firstOddEdge(), std::logic_error);
+
+    // Path 0 - 1 - 2 - 3 and an even cycle closing it
+    EXPECT_TRUE(ob.insertEdge(0, 1));
+    EXPECT_TRUE(ob.insertEdge(1, 2));
+    EXPECT_TRUE(ob.insertEdge(2, 3));
+    EXPECT_TRUE(ob.insertEdge(3, 0));
+    EXPECT_TRUE(ob.sameSet(0, 2));
+    EXPECT_TRUE(!ob.sameSet(0, 3));
+    EXPECT_TRUE(!ob.sameSet(0, 4));
+    EXPECT_TRUE(!ob.isConnected(0, 4));
+
+    EXPECT_TRUE(ob.insertEdge(4, 5));
+    EXPECT_TRUE(ob.insertEdge(5, 1));
+    EXPECT_TRUE(ob.sameSet(5, 0));
+    EXPECT_TRUE(!ob.sameSet(4, 0));
+    EXPECT_TRUE(ob.isConnected(3, 4));
+
+    // Triangle 0 - 1 - 2 is odd, later edges do not replace the report
+    EXPECT_TRUE(!ob.insertEdge(0, 2));
+    EXPECT_TRUE(!ob.insertEdge(3, 3));
+    EXPECT_TRUE(!ob.isBipartite());
+    EXPECT_EQ(ob.firstOddEdge(), std::make_pair(0, 2));
+    EXPECT_TRUE(!ob.sameSet(0, 4));
+    EXPECT_EQ(ob.V(), 6);
+    EXPECT_EQ(ob.E(), 8);
+}
+
+TEST(OnlineBipartiteTest, MatchesBipartite)
+{
+    // Random streams over many small components, checked against recoloring
+    unsigned int seed = 7;
+    for (int round = 0; round < 20; round++)
+    {
+        int n = 60;
+        Graph g(n);
+        OnlineBipartite ob(g);
+        bool wasBipartite = true;
+        for (int i = 0; i < 45; i++)
+        {
+            int v = nextRandom(seed, n);
+            int w = nextRandom(seed, n);
+            if (v == w || g.getVertices()[v].hasEdgeTo(w))
+                continue;
+            g.insertEdge(v, w);
+            bool result = ob.insertEdge(v, w);
+            Bipartite b(g);
+            ASSERT_EQ(result, b.isBipartite());
+            if (wasBipartite && !result)
+            {
+                EXPECT_EQ(ob.firstOddEdge(), std::make_pair(v, w));
+            }
+            wasBipartite = result;
+            if (result)
+            {
+                for (int x = 0; x < n; x += 7)
+                    EXPECT_EQ(ob.sameSet(0, x), ob.isConnected(0, x) && b.sameSet(0, x));
+            }
+        }
+
+        // Rebuilding from the final graph agrees
+        OnlineBipartite rebuilt(g);
+        EXPECT_EQ(rebuilt.isBipartite(), ob.isBipartite());
+        EXPECT_EQ(rebuilt.E(), g.E());
+    }
+}
+
 /**
  * Connected Component
  */
@@ -470,3 +669,2422 @@ TEST(CycleTest, StressTest)
     g.insertEdge(graphSize - 1, 5000);
     EXPECT_TRUE(isCyclic(g));
 }
+
+// Check that cycle is closed and made of edges of g
+static void expectValidCycle(const DiGraph &g, const std::vector<int> &cycle)
+{
+    ASSERT_GE(cycle.size(), 2);
+    EXPECT_EQ(cycle.front(), cycle.back());
+    for (size_t i = 0; i + 1 < cycle.size(); i++)
+    {
+        bool hasEdge = false;
+        for (const Edge &e : g.adj(cycle[i]))
+            hasEdge = hasEdge || e.getTo() == cycle[i + 1];
+        EXPECT_TRUE(hasEdge);
+    }
+}
+
+TEST(CycleTest, FindCycleDiGraph)
+{
+    DiGraph g;
+    EXPECT_TRUE(findCycle(g).empty());
+
+    g = DiGraph({10, 20, 30, 40});
+    g.insertEdge({{10, 20}, {20, 30}, {10, 30}, {30, 40}});
+    EXPECT_TRUE(findCycle(g).empty());
+
+    g.insertEdge(40, 20);
+    std::vector<int> cycle = findCycle(g);
+    expectValidCycle(g, cycle);
+    EXPECT_EQ(cycle.size(), 4);
+    EXPECT_EQ(std::set<int>(cycle.begin(), cycle.end()), std::set<int>({20, 30, 40}));
+
+    g.eraseEdge(40, 20);
+    g.insertEdge(40, 40);
+    EXPECT_EQ(findCycle(g), std::vector<int>({40, 40}));
+}
+
+TEST(CycleTest, FindCycleGraph)
+{
+    Graph g(6);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 3}, {4, 5}});
+    EXPECT_TRUE(findCycle(g).empty());
+
+    g.insertEdge(3, 1);
+    std::vector<int> cycle = findCycle(g);
+    expectValidCycle(g, cycle);
+    EXPECT_EQ(cycle.size(), 4);
+    EXPECT_EQ(std::set<int>(cycle.begin(), cycle.end()), std::set<int>({1, 2, 3}));
+}
+
+TEST(CycleTest, FindCycleDeepGraph)
+{
+    // Long paths must not overflow the call stack
+    int n = 200000;
+    DiGraph g(n);
+    for (int i = 0; i < n - 1; ++i)
+        g.insertEdge(i, i + 1);
+    EXPECT_TRUE(findCycle(g).empty());
+
+    g.insertEdge(n - 1, 5000);
+    std::vector<int> cycle = findCycle(g);
+    expectValidCycle(g, cycle);
+    EXPECT_EQ(cycle.size(), n - 5000 + 1);
+
+    Graph ug(n);
+    for (int i = 0; i < n - 1; ++i)
+        ug.insertEdge(i, i + 1);
+    EXPECT_TRUE(findCycle(ug).empty());
+    ug.insertEdge(0, n - 1);
+    expectValidCycle(ug, findCycle(ug));
+}
+
+/**
+ * Strong connectivity
+ */
+
+class StrongConnectivityTest : public ::testing::Test
+{
+protected:
+    DiGraph tinyGraph;
+    DiGraph blockGraph;
+
+    void SetUp() override
+    {
+        // Five SCCs: {1}, {0, 2, 3, 4, 5}, {9, 10, 11, 12}, {6, 8}, {7}
+        tinyGraph = DiGraph(13);
+        tinyGraph.insertEdge({{4, 2}, {2, 3}, {3, 2}, {6, 0}, {0, 1}, {2, 0}, {11, 12}, {12, 9}, {9, 10}, {9, 11}, {7, 9}, {10, 12}, {11, 4}, {4, 3}, {3, 5}, {6, 8}, {8, 6}, {5, 4}, {0, 5}, {6, 4}, {6, 9}, {7, 6}});
+
+        // 4000 directed 5-cycles linked by pseudo-random forward edges
+        int n = 20000;
+        blockGraph = DiGraph(n);
+        unsigned int seed = 12345;
+        for (int v = 0; v < n; v++)
+        {
+            blockGraph.insertEdge(v, v % 5 == 4 ? v - 4 : v + 1);
+            int w = v + 5 + nextRandom(seed, 100);
+            if (w < n)
+                blockGraph.insertEdge(v, w);
+        }
+    }
+
+    // Check that two labelings describe the same partition
+    void expectSamePartition(const StrongConnectivity &a, const StrongConnectivity &b)
+    {
+        ASSERT_EQ(a.count(), b.count());
+        ASSERT_EQ(a.ids().size(), b.ids().size());
+        std::vector<int> aToB(a.count(), -1);
+        for (size_t v = 0; v < a.ids().size(); v++)
+        {
+            int ca = a.ids()[v];
+            int cb = b.ids()[v];
+            if (aToB[ca] == -1)
+                aToB[ca] = cb;
+            EXPECT_EQ(aToB[ca], cb);
+        }
+    }
+};
+
+TEST_F(StrongConnectivityTest, EmptyGraph)
+{
+    DiGraph g;
+    StrongConnectivity scc(g);
+    EXPECT_EQ(scc.count(), 0);
+    EXPECT_EQ(scc.condensation().V(), 0);
+    EXPECT_THROW(scc.id(0), std::out_of_range);
+    EXPECT_THROW(scc.isStronglyConnected(0, 1), std::out_of_range);
+
+    StrongConnectivity parallelScc(g, true, 4);
+    EXPECT_EQ(parallelScc.count(), 0);
+}
+
+TEST_F(StrongConnectivityTest, TinyGraphQuery)
+{
+    for (bool useParallel : {false, true})
+    {
+        StrongConnectivity scc(tinyGraph, useParallel, 4);
+        EXPECT_EQ(scc.count(), 5);
+
+        EXPECT_TRUE(scc.isStronglyConnected(0, 2));
+        EXPECT_TRUE(scc.isStronglyConnected(3, 5));
+        EXPECT_TRUE(scc.isStronglyConnected(4, 0));
+        EXPECT_TRUE(scc.isStronglyConnected(9, 12));
+        EXPECT_TRUE(scc.isStronglyConnected(10, 11));
+        EXPECT_TRUE(scc.isStronglyConnected(6, 8));
+        EXPECT_TRUE(!scc.isStronglyConnected(0, 1));
+        EXPECT_TRUE(!scc.isStronglyConnected(6, 7));
+        EXPECT_TRUE(!scc.isStronglyConnected(9, 4));
+        EXPECT_THROW(scc.id(13), std::out_of_range);
+
+        for (int c : scc.ids())
+        {
+            EXPECT_GE(c, 0);
+            EXPECT_LT(c, scc.count());
+        }
+    }
+}
+
+TEST_F(StrongConnectivityTest, CondensationIsReverseTopological)
+{
+    StrongConnectivity scc(tinyGraph);
+    CompactDiGraph dag = scc.condensation();
+    EXPECT_EQ(dag.V(), 5);
+    EXPECT_EQ(dag.E(), 6);
+
+    // Tarjan numbers sinks first, so every edge points to a smaller id
+    for (size_t c = 0; c < dag.V(); c++)
+        for (size_t e = dag.begin(c); e < dag.end(c); e++)
+            EXPECT_LT(dag.target(e), (int)c);
+
+    // Component of 6 reaches components of 0, 4 and 9 but not 7
+    int six = scc.id(6);
+    std::set<int> reached;
+    for (size_t e = dag.begin(six); e < dag.end(six); e++)
+        reached.insert(dag.target(e));
+    EXPECT_EQ(reached, std::set<int>({scc.id(0), scc.id(9)}));
+}
+
+TEST_F(StrongConnectivityTest, ParallelMatchesSequential)
+{
+    StrongConnectivity sequential(blockGraph);
+    StrongConnectivity parallelScc(blockGraph, true, 4);
+    EXPECT_EQ(sequential.count(), 4000);
+    expectSamePartition(sequential, parallelScc);
+    EXPECT_TRUE(parallelScc.isStronglyConnected(0, 4));
+    EXPECT_TRUE(!parallelScc.isStronglyConnected(4, 5));
+}
+
+TEST_F(StrongConnectivityTest, DeepCycleDoesNotOverflow)
+{
+    int n = 200000;
+    DiGraph g(n);
+    for (int v = 0; v < n; v++)
+        g.insertEdge(v, (v + 1) % n);
+    g.insertVertex(n);
+    g.insertEdge(n, 0);
+
+    for (bool useParallel : {false, true})
+    {
+        StrongConnectivity scc(g, useParallel);
+        EXPECT_EQ(scc.count(), 2);
+        EXPECT_TRUE(scc.isStronglyConnected(0, n - 1));
+        EXPECT_TRUE(!scc.isStronglyConnected(0, n));
+        EXPECT_EQ(scc.condensation().E(), 1);
+    }
+}
+
+/**
+ * Topological sort
+ */
+
+TEST(TopologicalSortTest, EmptyGraph)
+{
+    DiGraph g;
+    TopologicalSort ts(g);
+    EXPECT_TRUE(ts.isDAG());
+    EXPECT_TRUE(ts.order().empty());
+    EXPECT_EQ(ts.levelCount(), 0);
+    EXPECT_THROW(ts.level(0), std::out_of_range);
+    EXPECT_THROW(ts.levelOf(0), std::out_of_range);
+}
+
+TEST(TopologicalSortTest, SmallDAGLevels)
+{
+    // Build tasks: 0 and 1 are sources, 4 waits on the longest chain 0 -> 2 -> 3
+    DiGraph g(6);
+    g.insertEdge({{0, 2}, {1, 2}, {2, 3}, {3, 4}, {0, 4}, {1, 5}});
+
+    for (bool useParallel : {false, true})
+    {
+        TopologicalSort ts(g, useParallel, 4);
+        ASSERT_TRUE(ts.isDAG());
+        EXPECT_EQ(ts.order(), std::vector<int>({0, 1, 2, 5, 3, 4}));
+        EXPECT_EQ(ts.levelCount(), 4);
+        EXPECT_EQ(ts.level(0), std::vector<int>({0, 1}));
+        EXPECT_EQ(ts.level(1), std::vector<int>({2, 5}));
+        EXPECT_EQ(ts.level(2), std::vector<int>({3}));
+        EXPECT_EQ(ts.level(3), std::vector<int>({4}));
+        EXPECT_EQ(ts.levels().size(), 4);
+        EXPECT_EQ(ts.levelOf(4), 3);
+        EXPECT_EQ(ts.levelOf(5), 1);
+        EXPECT_THROW(ts.level(4), std::out_of_range);
+    }
+}
+
+TEST(TopologicalSortTest, CyclicGraph)
+{
+    DiGraph g(5);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 3}, {3, 1}, {3, 4}});
+    TopologicalSort ts(g);
+    EXPECT_TRUE(!ts.isDAG());
+    EXPECT_TRUE(ts.order().empty());
+    EXPECT_EQ(ts.levelCount(), 0);
+    EXPECT_THROW(ts.levelOf(0), std::logic_error);
+}
+
+TEST(TopologicalSortTest, StressTest)
+{
+    // Layered DAG with pseudo-random edges to later vertices
+    int n = 20000;
+    DiGraph g(n);
+    unsigned int seed = 7;
+    for (int v = 0; v < n; v++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            int w = v + 1 + nextRandom(seed, 500);
+            if (w < n)
+                g.insertEdge(v, w);
+        }
+    }
+
+    TopologicalSort sequential(g);
+    TopologicalSort parallelTs(g, true, 4);
+    ASSERT_TRUE(sequential.isDAG());
+    EXPECT_EQ(sequential.order(), parallelTs.order());
+    EXPECT_EQ(sequential.levelCount(), parallelTs.levelCount());
+
+    // Every edge goes to a strictly deeper level
+    std::vector<int> order = sequential.order();
+    ASSERT_EQ(order.size(), n);
+    for (int v = 0; v < n; v++)
+        for (const Edge &e : g.adj(v))
+            EXPECT_LT(sequential.levelOf(v), sequential.levelOf(e.getTo()));
+}
+
+/**
+ * Dynamic topological order
+ */
+
+TEST(DynamicTopologicalOrderTest, InsertAndReorder)
+{
+    DynamicTopologicalOrder dto;
+    for (int v = 0; v < 5; v++)
+        dto.insertVertex(v);
+    EXPECT_EQ(dto.order(), std::vector<int>({0, 1, 2, 3, 4}));
+
+    // Edges against the current order force reordering of the affected region
+    EXPECT_TRUE(dto.insertEdge(4, 2));
+    EXPECT_TRUE(dto.insertEdge(3, 1));
+    EXPECT_TRUE(dto.insertEdge(2, 3));
+    EXPECT_TRUE(dto.insertEdge(2, 3)); // Duplicate edge is ignored
+    EXPECT_EQ(dto.E(), 3);
+    EXPECT_TRUE(dto.precedes(4, 2));
+    EXPECT_TRUE(dto.precedes(2, 3));
+    EXPECT_TRUE(dto.precedes(3, 1));
+    EXPECT_TRUE(dto.lastCycle().empty());
+    EXPECT_THROW(dto.insertEdge(0, 5), std::out_of_range);
+    EXPECT_THROW(dto.precedes(-1, 0), std::out_of_range);
+}
+
+TEST(DynamicTopologicalOrderTest, RejectCycleWithPath)
+{
+    DiGraph g(5);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 3}});
+    DynamicTopologicalOrder dto(g);
+    EXPECT_EQ(dto.E(), 3);
+
+    EXPECT_TRUE(!dto.insertEdge(3, 0));
+    EXPECT_EQ(dto.lastCycle(), std::vector<int>({3, 0, 1, 2, 3}));
+    EXPECT_EQ(dto.E(), 3);
+
+    EXPECT_TRUE(!dto.insertEdge(4, 4));
+    EXPECT_EQ(dto.lastCycle(), std::vector<int>({4, 4}));
+
+    // Removing an edge of the cycle makes the insertion legal
+    dto.eraseEdge(1, 2);
+    EXPECT_TRUE(dto.insertEdge(3, 0));
+    EXPECT_TRUE(dto.lastCycle().empty());
+    EXPECT_TRUE(dto.precedes(2, 3));
+    EXPECT_TRUE(dto.precedes(3, 0));
+    EXPECT_TRUE(dto.precedes(0, 1));
+}
+
+TEST(DynamicTopologicalOrderTest, CyclicInitialGraph)
+{
+    DiGraph g(3);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 0}});
+    EXPECT_THROW(DynamicTopologicalOrder dto(g), std::invalid_argument);
+}
+
+TEST(DynamicTopologicalOrderTest, StressTest)
+{
+    // Compare against a full reachability check for each insertion
+    int n = 300;
+    DiGraph mirror(n);
+    DynamicTopologicalOrder dto(mirror);
+    unsigned int seed = 99;
+    int rejected = 0;
+    for (int i = 0; i < 3000; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, n);
+
+        bool createsCycle = v == w || GraphPaths(mirror, w).hasPathTo(v);
+        bool inserted = dto.insertEdge(v, w);
+        ASSERT_EQ(inserted, !createsCycle);
+        if (inserted)
+            mirror.insertEdge(v, w);
+        else
+        {
+            // The reported cycle must consist of existing edges plus v -> w
+            rejected++;
+            const std::vector<int> &cycle = dto.lastCycle();
+            ASSERT_GE(cycle.size(), 2);
+            EXPECT_EQ(cycle.front(), v);
+            EXPECT_EQ(cycle[1], w);
+            EXPECT_EQ(cycle.back(), v);
+            for (size_t k = 1; k + 1 < cycle.size(); k++)
+                EXPECT_TRUE(mirror.getVertices()[cycle[k]].hasEdgeTo(cycle[k + 1]));
+        }
+    }
+    EXPECT_GT(rejected, 0);
+    EXPECT_EQ(dto.E(), mirror.E());
+
+    // The maintained order is a valid topological order
+    for (int v = 0; v < n; v++)
+        for (const Edge &e : mirror.adj(v))
+            EXPECT_TRUE(dto.precedes(v, e.getTo()));
+}
+
+/**
+ * Eulerian path
+ */
+
+// Check that path walks every edge of g exactly once
+static void expectEulerianPath(const DiGraph &g, const std::vector<int> &path)
+{
+    ASSERT_EQ(path.size(), g.E() + 1);
+    std::set<std::pair<int, int>> used;
+    for (size_t i = 0; i + 1 < path.size(); i++)
+    {
+        std::pair<int, int> edge = {path[i], path[i + 1]};
+        EXPECT_TRUE(g.getVertices()[g.indexOf(edge.first)].hasEdgeTo(edge.second));
+        EXPECT_TRUE(used.insert(edge).second);
+    }
+}
+
+// Check that path walks every undirected edge of g exactly once
+static void expectEulerianPath(const Graph &g, const std::vector<int> &path)
+{
+    ASSERT_EQ(path.size(), g.E() + 1);
+    std::set<std::pair<int, int>> used;
+    for (size_t i = 0; i + 1 < path.size(); i++)
+    {
+        std::pair<int, int> edge = std::minmax(path[i], path[i + 1]);
+        EXPECT_TRUE(g.getVertices()[g.indexOf(edge.first)].hasEdgeTo(edge.second));
+        EXPECT_TRUE(used.insert(edge).second);
+    }
+}
+
+TEST(EulerianTest, EmptyGraph)
+{
+    DiGraph g(3);
+    Eulerian eu(g);
+    EXPECT_TRUE(!eu.hasEulerianPath());
+    EXPECT_TRUE(!eu.hasEulerianCycle());
+    EXPECT_TRUE(eu.getPath().empty());
+}
+
+TEST(EulerianTest, PathAndCycle)
+{
+    DiGraph g({7, 8, 9, 10});
+    g.insertEdge({{7, 8}, {8, 9}, {9, 7}, {7, 10}});
+    Eulerian path(g);
+    EXPECT_TRUE(path.hasEulerianPath());
+    EXPECT_TRUE(!path.hasEulerianCycle());
+    EXPECT_EQ(path.getPath(), std::vector<int>({7, 8, 9, 7, 10}));
+
+    g.insertEdge(10, 7);
+    Eulerian cycle(g);
+    EXPECT_TRUE(cycle.hasEulerianPath());
+    EXPECT_TRUE(cycle.hasEulerianCycle());
+    expectEulerianPath(g, cycle.getPath());
+    EXPECT_EQ(cycle.getPath().front(), cycle.getPath().back());
+}
+
+TEST(EulerianTest, NoPath)
+{
+    // Two vertices with surplus out-degree
+    DiGraph unbalanced(4);
+    unbalanced.insertEdge({{0, 1}, {0, 2}, {3, 1}});
+    EXPECT_TRUE(!Eulerian(unbalanced).hasEulerianPath());
+
+    // Balanced but disconnected
+    DiGraph disconnected(4);
+    disconnected.insertEdge({{0, 1}, {1, 0}, {2, 3}, {3, 2}});
+    Eulerian eu(disconnected);
+    EXPECT_TRUE(!eu.hasEulerianPath());
+    EXPECT_TRUE(!eu.hasEulerianCycle());
+}
+
+TEST(EulerianTest, StreamIntoBuffer)
+{
+    DiGraph g(3);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 0}});
+    std::vector<int> buffer(g.E() + 1, -1);
+    EXPECT_EQ(Eulerian::writePath(g, buffer.data(), buffer.size()), 4);
+    expectEulerianPath(g, buffer);
+    EXPECT_THROW(Eulerian::writePath(g, buffer.data(), 3), std::length_error);
+}
+
+TEST(EulerianTest, UndirectedGraph)
+{
+    Graph edge(2);
+    edge.insertEdge(0, 1);
+    Eulerian single(edge);
+    EXPECT_TRUE(single.hasEulerianPath());
+    EXPECT_TRUE(!single.hasEulerianCycle());
+    expectEulerianPath(edge, single.getPath());
+
+    Graph triangle(3);
+    triangle.insertEdge({{0, 1}, {1, 2}, {2, 0}});
+    Eulerian cycle(triangle);
+    EXPECT_TRUE(cycle.hasEulerianCycle());
+    expectEulerianPath(triangle, cycle.getPath());
+
+    // Path 0 - 1 - 2 with a self-loop at 1 still has 0 and 2 as ends
+    Graph loop(3);
+    loop.insertEdge({{0, 1}, {1, 1}, {1, 2}});
+    Eulerian looped(loop);
+    EXPECT_TRUE(looped.hasEulerianPath());
+    expectEulerianPath(loop, looped.getPath());
+    std::pair<int, int> ends = std::minmax(looped.getPath().front(), looped.getPath().back());
+    EXPECT_EQ(ends, std::make_pair(0, 2));
+
+    // A star with three leaves has four vertices of odd degree
+    Graph star(4);
+    star.insertEdge({{0, 1}, {0, 2}, {0, 3}});
+    EXPECT_TRUE(!Eulerian(star).hasEulerianPath());
+
+    // Viewed as a DiGraph, every edge is walked once in each direction
+    Eulerian twice(static_cast<const DiGraph &>(star));
+    EXPECT_TRUE(twice.hasEulerianCycle());
+    EXPECT_EQ(twice.getPath().size(), 2 * star.E() + 1);
+
+    // Torus grid: every vertex has degree 4
+    int side = 30;
+    Graph torus(side * side);
+    for (int r = 0; r < side; r++)
+        for (int c = 0; c < side; c++)
+            torus.insertEdge({{r * side + c, r * side + (c + 1) % side}, {r * side + c, (r + 1) % side * side + c}});
+    Eulerian grid(torus);
+    ASSERT_TRUE(grid.hasEulerianCycle());
+    expectEulerianPath(torus, grid.getPath());
+
+    std::vector<int> buffer(triangle.E() + 1, -1);
+    EXPECT_EQ(Eulerian::writePath(triangle, buffer.data(), buffer.size()), 4);
+    expectEulerianPath(triangle, buffer);
+    EXPECT_THROW(Eulerian::writePath(triangle, buffer.data(), 3), std::length_error);
+}
+
+TEST(EulerianTest, DeBruijnStressTest)
+{
+    // de Bruijn graph B(2, 17): 2^16 vertices, 2^17 edges, one long circuit
+    int k = 17;
+    int V = 1 << (k - 1);
+    DiGraph g(V);
+    for (int v = 0; v < V; v++)
+        for (int b = 0; b < 2; b++)
+            g.insertEdge(v, (2 * v + b) % V);
+
+    Eulerian eu(g);
+    ASSERT_TRUE(eu.hasEulerianCycle());
+    expectEulerianPath(g, eu.getPath());
+}
+
+/**
+ * Planarity
+ */
+
+// Count faces of the rotation system and check Euler's formula V - E + F = 1 + C
+static void expectValidEmbedding(const Graph &g, Planarity &p)
+{
+    std::map<std::pair<int, int>, bool> visited;
+    std::map<int, std::vector<int>> rot;
+    for (const Node &node : g.getVertices())
+    {
+        rot[node.getId()] = p.rotation(node.getId());
+        EXPECT_EQ(rot[node.getId()].size(), std::distance(node.edges().begin(), node.edges().end()));
+        for (int w : rot[node.getId()])
+            visited[{node.getId(), w}] = false;
+    }
+
+    // The face after half-edge v -> w continues with w -> (neighbor before v around w)
+    int faces = 0;
+    for (auto &entry : visited)
+    {
+        if (entry.second)
+            continue;
+        faces++;
+        std::pair<int, int> h = entry.first;
+        while (!visited[h])
+        {
+            visited[h] = true;
+            const std::vector<int> &around = rot[h.second];
+            size_t i = std::find(around.begin(), around.end(), h.first) - around.begin();
+            ASSERT_LT(i, around.size());
+            h = {h.second, around[(i + around.size() - 1) % around.size()]};
+        }
+    }
+
+    int isolated = 0;
+    for (auto &entry : rot)
+        isolated += entry.second.empty();
+    ConnectedComponent cc(g);
+    int nonTrivial = cc.count() - isolated;
+    EXPECT_EQ((int)(g.V() - isolated) - (int)g.E() + faces, 1 + nonTrivial);
+}
+
+TEST(PlanarityTest, SmallGraphs)
+{
+    Graph k4(4);
+    for (int v = 0; v < 4; v++)
+        for (int w = v + 1; w < 4; w++)
+            k4.insertEdge(v, w);
+    Planarity p(k4);
+    EXPECT_TRUE(p.isPlanar());
+    expectValidEmbedding(k4, p);
+    EXPECT_TRUE(p.kuratowskiSubgraph().empty());
+    EXPECT_THROW(p.rotation(4), std::out_of_range);
+
+    Graph k5(5);
+    for (int v = 0; v < 5; v++)
+        for (int w = v + 1; w < 5; w++)
+            k5.insertEdge(v, w);
+    EXPECT_TRUE(!p.test(k5));
+    EXPECT_TRUE(p.rotation(0).empty());
+    EXPECT_EQ(p.kuratowskiSubgraph().size(), 10);
+
+    Graph k33(6);
+    for (int v = 0; v < 3; v++)
+        for (int w = 3; w < 6; w++)
+            k33.insertEdge(v, w);
+    EXPECT_TRUE(!p.test(k33));
+    EXPECT_EQ(p.kuratowskiSubgraph().size(), 9);
+
+    EXPECT_TRUE(p.test(Graph()));
+}
+
+TEST(PlanarityTest, GridIsPlanar)
+{
+    // Triangulated grid with arbitrary ids plus an isolated vertex
+    int side = 30;
+    Graph g;
+    for (int i = 0; i < side * side; i++)
+        g.insertVertex(3 * i + 1);
+    g.insertVertex(-5);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int v = 3 * (r * side + c) + 1;
+            if (c + 1 < side)
+                g.insertEdge(v, v + 3);
+            if (r + 1 < side)
+                g.insertEdge(v, v + 3 * side);
+            if (r + 1 < side && c + 1 < side)
+                g.insertEdge(v, v + 3 * side + 3);
+        }
+    }
+    Planarity p(g);
+    ASSERT_TRUE(p.isPlanar());
+    expectValidEmbedding(g, p);
+    EXPECT_TRUE(p.rotation(-5).empty());
+}
+
+TEST(PlanarityTest, PetersenKuratowskiSubgraph)
+{
+    // Petersen graph contains a subdivision of K3,3 but no K5 minor-free drawing
+    Graph g(10);
+    for (int i = 0; i < 5; i++)
+    {
+        g.insertEdge(i, (i + 1) % 5);
+        g.insertEdge(i, i + 5);
+        g.insertEdge(5 + i, 5 + (i + 2) % 5);
+    }
+    Planarity p(g);
+    ASSERT_TRUE(!p.isPlanar());
+
+    std::vector<std::pair<int, int>> kuratowski = p.kuratowskiSubgraph();
+    Graph sub(10);
+    for (const std::pair<int, int> &e : kuratowski)
+        sub.insertEdge(e.first, e.second);
+    EXPECT_TRUE(!Planarity(sub).isPlanar());
+
+    // Minimal: dropping any single edge makes it planar
+    for (const std::pair<int, int> &e : kuratowski)
+    {
+        Graph smaller(sub);
+        smaller.eraseEdge(e.first, e.second);
+        EXPECT_TRUE(Planarity(smaller).isPlanar());
+    }
+
+    // Branch vertices of a K3,3 subdivision: six vertices of degree 3
+    int branch = 0;
+    for (int v = 0; v < 10; v++)
+    {
+        int deg = std::distance(sub.adj(v).begin(), sub.adj(v).end());
+        EXPECT_TRUE(deg == 0 || deg == 2 || deg == 3);
+        branch += deg == 3;
+    }
+    EXPECT_EQ(branch, 6);
+}
+
+TEST(PlanarityTest, RandomGraphsReuseWorkspace)
+{
+    // Maximal planar graphs stay planar; one extra edge breaks them
+    Planarity p;
+    unsigned int seed = 2024;
+    for (int round = 0; round < 50; round++)
+    {
+        // Stacked triangulation: each new vertex goes inside a random face
+        int n = 8 + round % 17;
+        Graph g(n);
+        g.insertEdge({{0, 1}, {1, 2}, {2, 0}});
+        std::vector<std::array<int, 3>> faces = {{0, 1, 2}, {0, 2, 1}};
+        for (int v = 3; v < n; v++)
+        {
+            size_t f = nextRandom(seed, faces.size());
+            std::array<int, 3> face = faces[f];
+            g.insertEdge({{v, face[0]}, {v, face[1]}, {v, face[2]}});
+            faces[f] = {face[0], face[1], v};
+            faces.push_back({face[1], face[2], v});
+            faces.push_back({face[2], face[0], v});
+        }
+        ASSERT_EQ(g.E(), 3 * n - 6);
+        ASSERT_TRUE(p.test(g));
+        expectValidEmbedding(g, p);
+
+        for (int v = 0; v < n; v++)
+        {
+            for (int w = v + 1; w < n; w++)
+            {
+                if (g.getVertices()[v].hasEdgeTo(w))
+                    continue;
+                g.insertEdge(v, w);
+                EXPECT_TRUE(!p.test(g));
+                v = w = n;
+            }
+        }
+    }
+}
+
+/**
+ * Minimum Spanning Tree
+ */
+
+static const MinimumSpanningTree::Algorithm MST_ALGORITHMS[] = {
+    MinimumSpanningTree::Algorithm::Kruskal,
+    MinimumSpanningTree::Algorithm::FilterKruskal,
+    MinimumSpanningTree::Algorithm::Boruvka};
+
+TEST(MinimumSpanningTreeTest, EmptyGraph)
+{
+    for (MinimumSpanningTree::Algorithm algorithm : MST_ALGORITHMS)
+    {
+        MinimumSpanningTree mst(Graph(), algorithm);
+        EXPECT_TRUE(mst.edges().empty());
+        EXPECT_EQ(mst.weight(), 0);
+        EXPECT_EQ(mst.components(), 0);
+    }
+}
+
+TEST(MinimumSpanningTreeTest, TinyEdgeWeightedGraph)
+{
+    // Sedgewick's tinyEWG plus an isolated vertex and a self-loop
+    Graph g(9);
+    g.insertEdge(4, 5, 0.35);
+    g.insertEdge(4, 7, 0.37);
+    g.insertEdge(5, 7, 0.28);
+    g.insertEdge(0, 7, 0.16);
+    g.insertEdge(1, 5, 0.32);
+    g.insertEdge(0, 4, 0.38);
+    g.insertEdge(2, 3, 0.17);
+    g.insertEdge(1, 7, 0.19);
+    g.insertEdge(0, 2, 0.26);
+    g.insertEdge(1, 2, 0.36);
+    g.insertEdge(1, 3, 0.29);
+    g.insertEdge(2, 7, 0.34);
+    g.insertEdge(6, 2, 0.40);
+    g.insertEdge(3, 6, 0.52);
+    g.insertEdge(6, 0, 0.58);
+    g.insertEdge(6, 4, 0.93);
+    g.insertEdge(5, 5, 0.01);
+
+    for (MinimumSpanningTree::Algorithm algorithm : MST_ALGORITHMS)
+    {
+        MinimumSpanningTree mst(g, algorithm);
+        EXPECT_NEAR(mst.weight(), 1.81, 1e-9);
+        EXPECT_EQ(mst.components(), 2);
+        ASSERT_EQ(mst.edges().size(), 7);
+        EXPECT_EQ(mst.edges().front().getWeight(), 0.16);
+        EXPECT_EQ(mst.edges().back().getWeight(), 0.40);
+        for (const Edge &e : mst.edges())
+            EXPECT_TRUE(g.getVertices()[e.getFrom()].hasEdgeTo(e.getTo()));
+    }
+}
+
+TEST(MinimumSpanningTreeTest, AlgorithmsAgree)
+{
+    // Random sparse graph with few distinct weights to exercise tie-breaking
+    int n = 3000;
+    Graph g(n);
+    unsigned int seed = 99;
+    for (int i = 0; i < 6 * n; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, n);
+        double weight = nextRandom(seed, 16);
+        if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+            g.insertEdge(v, w, weight);
+    }
+
+    MinimumSpanningTree reference(g, MinimumSpanningTree::Algorithm::Kruskal);
+    ConnectedComponent cc(g);
+    EXPECT_EQ(reference.components(), cc.count());
+    EXPECT_EQ(reference.edges().size(), n - cc.count());
+
+    for (MinimumSpanningTree::Algorithm algorithm : MST_ALGORITHMS)
+    {
+        for (bool useParallel : {false, true})
+        {
+            MinimumSpanningTree mst(g, algorithm, useParallel, 4);
+            EXPECT_EQ(mst.weight(), reference.weight());
+            EXPECT_EQ(mst.components(), reference.components());
+            EXPECT_EQ(mst.edges(), reference.edges());
+        }
+    }
+
+    MinimumSpanningTree copy(reference);
+    copy = MinimumSpanningTree(Graph(3));
+    EXPECT_EQ(copy.components(), 3);
+    EXPECT_EQ(reference.components(), cc.count());
+}
+
+TEST(MinimumSpanningTreeTest, ParallelSortMatchesSort)
+{
+    // Uneven slice counts exercise the odd merge at the end of each round
+    std::vector<int> values(100003);
+    unsigned int seed = 5;
+    for (int &x : values)
+    {
+        x = nextRandom(seed, 1000);
+    }
+    for (int threads : {2, 3, 5, 8})
+    {
+        std::vector<int> expected(values), actual(values);
+        std::sort(expected.begin(), expected.end());
+        parallelSort(actual.begin(), actual.end(), std::less<int>(), threads, 16);
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+/**
+ * PageRank
+ */
+
+// Dense power iteration; restarts go to source, or spread uniformly if source is -1
+static std::vector<double> densePageRank(const DiGraph &g, double damping, int source)
+{
+    int n = g.V();
+    std::vector<double> x(n, 1.0 / n), y(n);
+    for (int it = 0; it < 2000; it++)
+    {
+        std::fill(y.begin(), y.end(), 0);
+        double jump = 0;
+        for (int u = 0; u < n; u++)
+        {
+            const Node &node = g.getVertices()[u];
+            int deg = std::distance(node.edges().begin(), node.edges().end());
+            jump += (1 - damping) * x[u] + (deg == 0 ? damping * x[u] : 0);
+            for (const Edge &e : node.edges())
+                y[g.indexOf(e.getTo())] += damping * x[u] / deg;
+        }
+        for (int v = 0; v < n; v++)
+            y[v] += source == -1 ? jump / n : (v == source ? jump : 0);
+        std::swap(x, y);
+    }
+    return x;
+}
+
+// Random digraph with some dangling vertices and non-contiguous ids
+static DiGraph randomRankGraph(int n, int edges, unsigned int seed)
+{
+    DiGraph g;
+    for (int v = 0; v < n; v++)
+        g.insertVertex(10 * v);
+    for (int i = 0; i < edges; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, n);
+        if (v % 7 != 3 && !g.getVertices()[v].hasEdgeTo(10 * w))
+            g.insertEdge(10 * v, 10 * w);
+    }
+    return g;
+}
+
+TEST(PageRankTest, EmptyGraphAndArguments)
+{
+    PageRank pr((DiGraph()));
+    EXPECT_TRUE(pr.ranks().empty());
+    EXPECT_TRUE(pr.converged());
+    EXPECT_THROW(pr.rank(0), std::out_of_range);
+    EXPECT_THROW(PageRank(DiGraph(2), 1.0), std::invalid_argument);
+
+    DiGraph g(2);
+    g.insertEdge(0, 1);
+    PageRank small(g);
+    EXPECT_THROW(small.personalized(0, 0), std::invalid_argument);
+    EXPECT_THROW(small.personalized(2), std::out_of_range);
+}
+
+TEST(PageRankTest, MatchesDenseIteration)
+{
+    DiGraph g = randomRankGraph(300, 1500, 11);
+    std::vector<double> expected = densePageRank(g, 0.85, -1);
+
+    PageRank seq(g);
+    PageRank par(g, 0.85, 1e-10, 100, true, 4);
+    ASSERT_TRUE(seq.converged());
+    ASSERT_TRUE(par.converged());
+    EXPECT_LT(seq.iterations(), 100);
+
+    double sum = 0;
+    for (int v = 0; v < 300; v++)
+    {
+        EXPECT_NEAR(seq.ranks()[v], expected[v], 1e-9);
+        EXPECT_NEAR(par.ranks()[v], seq.ranks()[v], 1e-12);
+        EXPECT_EQ(seq.rank(10 * v), seq.ranks()[v]);
+        sum += seq.ranks()[v];
+    }
+    EXPECT_NEAR(sum, 1, 1e-9);
+
+    // Iteration cap is honored
+    PageRank capped(g, 0.85, 0, 3);
+    EXPECT_EQ(capped.iterations(), 3);
+    EXPECT_TRUE(!capped.converged());
+}
+
+TEST(PageRankTest, PersonalizedPush)
+{
+    DiGraph g = randomRankGraph(200, 700, 23);
+    PageRank pr(g, 0.8);
+    int source = 5;
+    std::vector<double> exact = densePageRank(g, 0.8, source);
+
+    std::vector<std::pair<int, double>> approx = pr.personalized(10 * source, 1e-7);
+    ASSERT_TRUE(!approx.empty());
+    double total = 0;
+    for (size_t i = 0; i < approx.size(); i++)
+    {
+        int v = approx[i].first / 10;
+        EXPECT_LE(approx[i].second, exact[v] + 1e-12);
+        EXPECT_NEAR(approx[i].second, exact[v], 1e-4);
+        if (i > 0)
+        {
+            EXPECT_GE(approx[i - 1].second, approx[i].second);
+        }
+        total += approx[i].second;
+    }
+    EXPECT_GT(total, 0.999);
+
+    // A coarse threshold touches fewer vertices
+    EXPECT_LE(pr.personalized(10 * source, 1e-2).size(), approx.size());
+}
+
+/**
+ * Betweenness
+ */
+
+// Floyd-Warshall with shortest path counts; positive weights count every path once
+static std::vector<double> bruteForceBetweenness(const DiGraph &g, bool weighted)
+{
+    int n = g.V();
+    double inf = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<double>> d(n, std::vector<double>(n, inf)), sigma(n, std::vector<double>(n, 0));
+    for (int v = 0; v < n; v++)
+    {
+        for (const Edge &e : g.getVertices()[v].edges())
+        {
+            int w = g.indexOf(e.getTo());
+            d[v][w] = weighted ? e.getWeight() : 1;
+            sigma[v][w] = 1;
+        }
+    }
+    for (int k = 0; k < n; k++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                if (i == j || i == k || j == k)
+                    continue;
+                double alt = d[i][k] + d[k][j];
+                if (alt < d[i][j])
+                {
+                    d[i][j] = alt;
+                    sigma[i][j] = sigma[i][k] * sigma[k][j];
+                }
+                else if (alt == d[i][j] && alt != inf)
+                    sigma[i][j] += sigma[i][k] * sigma[k][j];
+            }
+        }
+    }
+
+    std::vector<double> bc(n, 0);
+    for (int s = 0; s < n; s++)
+        for (int t = 0; t < n; t++)
+            for (int v = 0; v < n; v++)
+                if (s != t && s != v && v != t && d[s][t] != inf && d[s][v] + d[v][t] == d[s][t])
+                    bc[v] += sigma[s][v] * sigma[v][t] / sigma[s][t];
+    return bc;
+}
+
+TEST(BetweennessTest, PathAndStar)
+{
+    Graph path(5);
+    path.insertEdge({{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+    Betweenness b(path);
+    EXPECT_TRUE(b.isExact());
+    EXPECT_EQ(b.errorBound(), 0);
+    EXPECT_EQ(b.centralities(), std::vector<double>({0, 3, 4, 3, 0}));
+    EXPECT_THROW(b.centrality(5), std::out_of_range);
+    EXPECT_THROW(b.errorBound(1), std::invalid_argument);
+
+    // Directed path only counts forward pairs
+    DiGraph dipath(5);
+    dipath.insertEdge({{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+    EXPECT_EQ(Betweenness(dipath).centrality(2), 4);
+
+    Graph star = {10, 20, 30, 40, 50};
+    star.insertEdge({{10, 20}, {10, 30}, {10, 40}, {10, 50}});
+    Betweenness c(star, false, 0, 0, true, 3);
+    EXPECT_EQ(c.centrality(10), 6);
+    EXPECT_EQ(c.centrality(40), 0);
+
+    EXPECT_TRUE(Betweenness(DiGraph()).centralities().empty());
+    path.insertEdge(0, 4, -1);
+    EXPECT_THROW(Betweenness(path, true), std::invalid_argument);
+}
+
+TEST(BetweennessTest, MatchesBruteForce)
+{
+    // Small integer weights create many ties between shortest paths
+    int n = 60;
+    DiGraph g(n);
+    unsigned int seed = 31;
+    for (int i = 0; i < 4 * n; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, n);
+        double weight = 1 + nextRandom(seed, 3);
+        if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+            g.insertEdge(v, w, weight);
+    }
+
+    for (bool weighted : {false, true})
+    {
+        std::vector<double> expected = bruteForceBetweenness(g, weighted);
+        Betweenness seq(g, weighted);
+        Betweenness par(g, weighted, 0, 0, true, 4);
+        for (int v = 0; v < n; v++)
+        {
+            EXPECT_NEAR(seq.centralities()[v], expected[v], 1e-9);
+            EXPECT_NEAR(par.centralities()[v], expected[v], 1e-9);
+        }
+    }
+
+    // Undirected scores are half of the symmetric directed ones
+    Graph u(g);
+    Betweenness undirected(u, true);
+    std::vector<double> symmetric = bruteForceBetweenness(u, true);
+    for (int v = 0; v < n; v++)
+        EXPECT_NEAR(undirected.centralities()[v], symmetric[v] / 2, 1e-9);
+}
+
+TEST(BetweennessTest, SampledWithinErrorBound)
+{
+    // Grid with long shortest paths, so exact scores are large
+    int side = 25, n = side * side;
+    Graph g(n);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+                g.insertEdge(v, v + 1);
+            if (r + 1 < side)
+                g.insertEdge(v, v + side);
+        }
+    }
+
+    Betweenness exact(g, false, 0, 0, true, 4);
+    Betweenness sampled(g, false, 200, 42, true, 4);
+    EXPECT_EQ(sampled.samples(), 200);
+    EXPECT_TRUE(!sampled.isExact());
+    double bound = sampled.errorBound(0.01);
+    EXPECT_GT(bound, 0);
+
+    double total = 0, estimated = 0;
+    for (int v = 0; v < n; v++)
+    {
+        EXPECT_LE(std::fabs(sampled.centralities()[v] - exact.centralities()[v]), bound);
+        total += exact.centralities()[v];
+        estimated += sampled.centralities()[v];
+    }
+    EXPECT_NEAR(estimated / total, 1, 0.1);
+
+    // Same seed, same sources
+    Betweenness again(g, false, 200, 42);
+    for (int v = 0; v < n; v++)
+        EXPECT_NEAR(again.centralities()[v], sampled.centralities()[v], 1e-9);
+}
+
+/**
+ * Triangle Count
+ */
+
+TEST(TriangleCountTest, SmallGraphs)
+{
+    TriangleCount empty((Graph()));
+    EXPECT_EQ(empty.count(), 0);
+    EXPECT_EQ(empty.globalClustering(), 0);
+    EXPECT_EQ(empty.averageClustering(), 0);
+    EXPECT_THROW(empty.count(0), std::out_of_range);
+
+    // K4 has four triangles, each vertex in three of them
+    Graph k4(4);
+    for (int v = 0; v < 4; v++)
+        for (int w = v + 1; w < 4; w++)
+            k4.insertEdge(v, w);
+    TriangleCount t(k4);
+    EXPECT_EQ(t.count(), 4);
+    EXPECT_EQ(t.counts(), std::vector<long long>({3, 3, 3, 3}));
+    EXPECT_EQ(t.localClustering(2), 1);
+    EXPECT_EQ(t.globalClustering(), 1);
+
+    // Triangle with a pendant vertex and a self-loop
+    Graph paw = {7, 8, 9, -1};
+    paw.insertEdge({{7, 8}, {8, 9}, {9, 7}, {9, -1}, {-1, -1}});
+    TriangleCount p(paw);
+    EXPECT_EQ(p.count(), 1);
+    EXPECT_EQ(p.count(9), 1);
+    EXPECT_EQ(p.count(-1), 0);
+    EXPECT_DOUBLE_EQ(p.localClustering(9), 1.0 / 3);
+    EXPECT_EQ(p.localClustering(-1), 0);
+    EXPECT_DOUBLE_EQ(p.averageClustering(), (1 + 1 + 1.0 / 3) / 4);
+    EXPECT_DOUBLE_EQ(p.globalClustering(), 3.0 / 5);
+}
+
+TEST(TriangleCountTest, MatchesBruteForce)
+{
+    // Dense random graph so neighbor arrays are long enough for block intersection
+    int n = 150;
+    Graph g(n);
+    std::vector<std::vector<char>> adj(n, std::vector<char>(n, 0));
+    unsigned int seed = 17;
+    for (int v = 0; v < n; v++)
+    {
+        for (int w = v + 1; w < n; w++)
+        {
+            if (nextRandom(seed, 100) < (v < 20 ? 60u : 12u))
+            {
+                g.insertEdge(v, w);
+                adj[v][w] = adj[w][v] = 1;
+            }
+        }
+    }
+
+    long long expected = 0;
+    std::vector<long long> expectedPerVertex(n, 0);
+    for (int a = 0; a < n; a++)
+        for (int b = a + 1; b < n; b++)
+            for (int c = b + 1; adj[a][b] && c < n; c++)
+                if (adj[a][c] && adj[b][c])
+                {
+                    expected++;
+                    expectedPerVertex[a]++;
+                    expectedPerVertex[b]++;
+                    expectedPerVertex[c]++;
+                }
+
+    TriangleCount seq(g);
+    TriangleCount par(g, true, 4);
+    EXPECT_EQ(seq.count(), expected);
+    EXPECT_EQ(seq.counts(), expectedPerVertex);
+    EXPECT_EQ(par.count(), expected);
+    EXPECT_EQ(par.counts(), expectedPerVertex);
+    EXPECT_DOUBLE_EQ(par.globalClustering(), seq.globalClustering());
+}
+
+/**
+ * Core Decomposition
+ */
+
+TEST(CoreDecompositionTest, SmallGraph)
+{
+    EXPECT_EQ(CoreDecomposition(Graph()).degeneracy(), 0);
+
+    // K4 on 0..3, a triangle 4-5-6 hanging off 3, a path 6-7-8 and isolated 9
+    Graph g(10);
+    for (int v = 0; v < 4; v++)
+        for (int w = v + 1; w < 4; w++)
+            g.insertEdge(v, w);
+    g.insertEdge({{3, 4}, {4, 5}, {5, 6}, {6, 4}, {6, 7}, {7, 8}, {8, 8}});
+    std::vector<int> expected = {3, 3, 3, 3, 2, 2, 2, 1, 1, 0};
+
+    for (bool useParallel : {false, true})
+    {
+        CoreDecomposition cd(g, useParallel, 3);
+        EXPECT_EQ(cd.coreNumbers(), expected);
+        EXPECT_EQ(cd.degeneracy(), 3);
+        EXPECT_EQ(cd.coreNumber(5), 2);
+        EXPECT_EQ(cd.core(2), std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+        EXPECT_EQ(cd.core(4), std::vector<int>());
+        EXPECT_THROW(cd.coreNumber(10), std::out_of_range);
+    }
+}
+
+TEST(CoreDecompositionTest, ParallelMatchesSequential)
+{
+    // Skewed random graph: a few hubs plus sparse random edges
+    int n = 5000;
+    Graph g(n);
+    unsigned int seed = 3;
+    for (int i = 0; i < 8 * n; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, i % 3 == 0 ? 50 : n);
+        if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+            g.insertEdge(v, w);
+    }
+
+    CoreDecomposition seq(g);
+    CoreDecomposition par(g, true, 4);
+    EXPECT_EQ(seq.coreNumbers(), par.coreNumbers());
+    EXPECT_EQ(seq.degeneracy(), par.degeneracy());
+
+    // Every vertex of the k-core has at least k neighbors inside it
+    int k = seq.degeneracy();
+    std::vector<int> members = seq.core(k);
+    std::set<int> inside(members.begin(), members.end());
+    ASSERT_TRUE(!members.empty());
+    for (int v : members)
+    {
+        int deg = 0;
+        for (const Edge &e : g.adj(v))
+            deg += inside.count(e.getTo());
+        EXPECT_GE(deg, k);
+    }
+}
+
+/**
+ * Louvain
+ */
+
+// Planted partition: dense groups of a given size, sparse edges between them
+static Graph plantedPartition(int groups, int size, unsigned int seed)
+{
+    int n = groups * size;
+    Graph g(n);
+    for (int v = 0; v < n; v++)
+    {
+        for (int w = v + 1; w < n; w++)
+        {
+            int roll = nextRandom(seed, 100);
+            if (v / size == w / size ? roll < 40 : roll < 1)
+                g.insertEdge(v, w);
+        }
+    }
+    return g;
+}
+
+TEST(LouvainTest, TwoCliques)
+{
+    EXPECT_EQ(Louvain(Graph()).levels(), 0);
+
+    // Two K5 joined by the edge 4-5
+    Graph g(10);
+    for (int base : {0, 5})
+        for (int v = base; v < base + 5; v++)
+            for (int w = v + 1; w < base + 5; w++)
+                g.insertEdge(v, w);
+    g.insertEdge(4, 5);
+
+    for (bool deterministic : {false, true})
+    {
+        Louvain louvain(g, 1.0, deterministic);
+        int last = louvain.levels() - 1;
+        ASSERT_GE(last, 0);
+        EXPECT_EQ(louvain.count(last), 2);
+        EXPECT_GT(louvain.modularity(last), 0.4);
+        for (int v = 0; v < 10; v++)
+            EXPECT_EQ(louvain.community(v), louvain.community(v < 5 ? 0 : 5));
+        EXPECT_NE(louvain.community(0), louvain.community(9));
+        EXPECT_THROW(louvain.community(10), std::out_of_range);
+        EXPECT_THROW(louvain.labels(last + 1), std::out_of_range);
+    }
+    EXPECT_THROW(Louvain(g, 0), std::invalid_argument);
+}
+
+TEST(LouvainTest, LevelsRefinePartition)
+{
+    Graph g = plantedPartition(8, 25, 7);
+    for (bool useParallel : {false, true})
+    {
+        Louvain louvain(g, 1.0, false, useParallel, 4);
+        for (int level = 0; level < louvain.levels(); level++)
+        {
+            const std::vector<int> &labels = louvain.labels(level);
+            std::set<int> used(labels.begin(), labels.end());
+            EXPECT_EQ(static_cast<int>(used.size()), louvain.count(level));
+            EXPECT_EQ(*used.rbegin(), louvain.count(level) - 1);
+            if (level == 0)
+                continue;
+
+            // Vertices together on one level stay together on the next
+            const std::vector<int> &prev = louvain.labels(level - 1);
+            std::map<int, int> merged;
+            for (size_t v = 0; v < labels.size(); v++)
+            {
+                auto it = merged.insert({prev[v], labels[v]}).first;
+                EXPECT_EQ(it->second, labels[v]);
+            }
+            EXPECT_GE(louvain.modularity(level), louvain.modularity(level - 1) - 1e-9);
+        }
+        EXPECT_EQ(louvain.count(louvain.levels() - 1), 8);
+        EXPECT_GT(louvain.modularity(louvain.levels() - 1), 0.6);
+    }
+}
+
+TEST(LouvainTest, DeterministicAcrossThreads)
+{
+    Graph g = plantedPartition(6, 30, 11);
+    Louvain one(g, 1.0, true, true, 1);
+    Louvain four(g, 1.0, true, true, 4);
+    ASSERT_EQ(one.levels(), four.levels());
+    for (int level = 0; level < one.levels(); level++)
+    {
+        EXPECT_EQ(one.labels(level), four.labels(level));
+        EXPECT_DOUBLE_EQ(one.modularity(level), four.modularity(level));
+    }
+    EXPECT_GT(one.modularity(one.levels() - 1), 0.5);
+}
+
+/**
+ * Label propagation
+ */
+
+TEST(LabelPropagationTest, TwoCliques)
+{
+    EXPECT_EQ(LabelPropagation(Graph()).count(), 0);
+
+    // Two K5 on ids 10..14 and 20..24 joined by the edge 14-20
+    Graph g({10, 11, 12, 13, 14, 20, 21, 22, 23, 24});
+    for (int base : {10, 20})
+        for (int v = base; v < base + 5; v++)
+            for (int w = v + 1; w < base + 5; w++)
+                g.insertEdge(v, w);
+    g.insertEdge(14, 20);
+
+    for (LabelPropagation::Mode mode : {LabelPropagation::Mode::Synchronous, LabelPropagation::Mode::Asynchronous})
+    {
+        for (bool useParallel : {false, true})
+        {
+            LabelPropagation lp(g, mode, 0, 50, 1, useParallel, 3);
+            EXPECT_TRUE(lp.converged());
+            EXPECT_EQ(lp.count(), 2);
+            for (int v : {11, 12, 13, 14})
+                EXPECT_EQ(lp.community(v), lp.community(10));
+            for (int v : {21, 22, 23, 24})
+                EXPECT_EQ(lp.community(v), lp.community(20));
+            EXPECT_NE(lp.community(10), lp.community(20));
+            EXPECT_EQ(lp.communities()[0], 0);
+            EXPECT_THROW(lp.community(15), std::out_of_range);
+        }
+    }
+    EXPECT_THROW(LabelPropagation(g, LabelPropagation::Mode::Synchronous, -1), std::invalid_argument);
+}
+
+TEST(LabelPropagationTest, DirectedListensToOutNeighbors)
+{
+    // Every vertex of the cycle 0 -> 1 -> 2 -> 0 points to the sink 3
+    // with a heavier edge, so all labels become the label of 3
+    DiGraph g(5);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 0}});
+    for (int v = 0; v < 3; v++)
+        g.insertEdge(v, 3, 2);
+
+    LabelPropagation lp(g, LabelPropagation::Mode::Synchronous);
+    EXPECT_EQ(lp.count(), 2);
+    for (int v = 0; v < 3; v++)
+        EXPECT_EQ(lp.community(v), lp.community(3));
+    EXPECT_NE(lp.community(4), lp.community(3));
+}
+
+TEST(LabelPropagationTest, PlantedPartition)
+{
+    Graph g = plantedPartition(8, 50, 5);
+    for (bool useParallel : {false, true})
+    {
+        LabelPropagation lp(g, LabelPropagation::Mode::Asynchronous, 0, 100, 9, useParallel, 4);
+        EXPECT_TRUE(lp.converged());
+        EXPECT_EQ(lp.count(), 8);
+
+        // Every group ends up in a single community
+        for (int v = 0; v < 400; v++)
+            EXPECT_EQ(lp.community(v), lp.community(v / 50 * 50));
+    }
+}
+
+/**
+ * Max flow
+ */
+
+static const MaxFlow::Algorithm FLOW_ALGORITHMS[] = {MaxFlow::Algorithm::PushRelabel, MaxFlow::Algorithm::Dinic};
+
+// Check capacity limits, conservation and the cut of a computed flow
+static void expectValidFlow(const DiGraph &g, const MaxFlow &mf, int source, int sink)
+{
+    std::map<int, double> balance;
+    for (const Node &node : g.getVertices())
+    {
+        for (const Edge &e : node.edges())
+        {
+            double f = mf.flow(e.getFrom(), e.getTo());
+            EXPECT_GE(f, -1e-9);
+            EXPECT_LE(f, e.getWeight() + 1e-9);
+            balance[e.getFrom()] -= f;
+            balance[e.getTo()] += f;
+        }
+    }
+    for (const Node &node : g.getVertices())
+    {
+        int v = node.getId();
+        if (v == source)
+            EXPECT_NEAR(balance[v], -mf.value(), 1e-9);
+        else if (v == sink)
+            EXPECT_NEAR(balance[v], mf.value(), 1e-9);
+        else
+            EXPECT_NEAR(balance[v], 0, 1e-9);
+    }
+
+    double cut = 0;
+    for (const Edge &e : mf.minCut())
+    {
+        EXPECT_TRUE(mf.inSourceSide(e.getFrom()));
+        EXPECT_FALSE(mf.inSourceSide(e.getTo()));
+        EXPECT_NEAR(mf.flow(e.getFrom(), e.getTo()), e.getWeight(), 1e-9);
+        cut += e.getWeight();
+    }
+    EXPECT_NEAR(cut, mf.value(), 1e-9);
+    EXPECT_TRUE(mf.inSourceSide(source));
+    EXPECT_FALSE(mf.inSourceSide(sink));
+}
+
+TEST(MaxFlowTest, TextbookNetwork)
+{
+    DiGraph g(6);
+    g.insertEdge(0, 1, 16);
+    g.insertEdge(0, 2, 13);
+    g.insertEdge(1, 3, 12);
+    g.insertEdge(2, 1, 4);
+    g.insertEdge(2, 4, 14);
+    g.insertEdge(3, 2, 9);
+    g.insertEdge(3, 5, 20);
+    g.insertEdge(4, 3, 7);
+    g.insertEdge(4, 5, 4);
+
+    for (MaxFlow::Algorithm algorithm : FLOW_ALGORITHMS)
+    {
+        MaxFlow mf(g, 0, 5, algorithm);
+        EXPECT_DOUBLE_EQ(mf.value(), 23);
+        expectValidFlow(g, mf, 0, 5);
+        for (int v : {0, 1, 2, 4})
+            EXPECT_TRUE(mf.inSourceSide(v));
+        EXPECT_EQ(mf.minCut().size(), 3u);
+
+        double out = 0;
+        for (const Edge &e : mf.flows())
+            if (e.getFrom() == 0)
+                out += e.getWeight();
+        EXPECT_DOUBLE_EQ(out, 23);
+        EXPECT_THROW(mf.flow(1, 0), std::out_of_range);
+    }
+
+    EXPECT_THROW(MaxFlow(g, 0, 0), std::invalid_argument);
+    EXPECT_THROW(MaxFlow(g, 0, 6), std::out_of_range);
+    g.insertEdge(5, 0, -1);
+    EXPECT_THROW(MaxFlow(g, 0, 5), std::invalid_argument);
+}
+
+TEST(MaxFlowTest, AlgorithmsAgree)
+{
+    // Layered random networks with dead ends, cycles and fractional capacities
+    unsigned int seed = 17;
+    for (int round = 0; round < 20; round++)
+    {
+        int n = 40 + round * 10;
+        DiGraph g(n);
+        for (int i = 0; i < 5 * n; i++)
+        {
+            int v = nextRandom(seed, n);
+            int w = nextRandom(seed, n);
+            double cap = (nextRandom(seed, 100)) / 4.0;
+            if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+                g.insertEdge(v, w, cap);
+        }
+
+        MaxFlow pr(g, 0, n - 1, MaxFlow::Algorithm::PushRelabel);
+        MaxFlow dinic(g, 0, n - 1, MaxFlow::Algorithm::Dinic);
+        EXPECT_NEAR(pr.value(), dinic.value(), 1e-9);
+        expectValidFlow(g, pr, 0, n - 1);
+        expectValidFlow(g, dinic, 0, n - 1);
+    }
+}
+
+/**
+ * Bipartite matching
+ */
+
+// Check that the matched edges exist, share no endpoint and agree with mate()
+static void expectValidMatching(const Graph &g, const BipartiteMatching &bm)
+{
+    std::set<int> covered;
+    for (const Edge &e : bm.edges())
+    {
+        EXPECT_TRUE(g.getVertices()[g.indexOf(e.getFrom())].hasEdgeTo(e.getTo()));
+        EXPECT_TRUE(covered.insert(e.getFrom()).second);
+        EXPECT_TRUE(covered.insert(e.getTo()).second);
+        EXPECT_EQ(bm.mate(e.getFrom()), e.getTo());
+        EXPECT_EQ(bm.mate(e.getTo()), e.getFrom());
+    }
+    EXPECT_EQ(static_cast<int>(bm.edges().size()), bm.size());
+    for (const Node &node : g.getVertices())
+        EXPECT_EQ(bm.isMatched(node.getId()), covered.count(node.getId()) == 1);
+}
+
+TEST(BipartiteMatchingTest, GreedyNeedsAugmenting)
+{
+    EXPECT_EQ(BipartiteMatching(Graph()).size(), 0);
+
+    // Greedy takes 0-3 and 2-4 and leaves 1 unmatched; 6 is isolated
+    Graph g(7);
+    g.insertEdge({{0, 3}, {0, 4}, {1, 3}, {2, 4}, {2, 5}});
+    for (bool greedyStart : {true, false})
+    {
+        BipartiteMatching bm(g, greedyStart);
+        EXPECT_EQ(bm.size(), 3);
+        EXPECT_EQ(bm.mate(1), 3);
+        EXPECT_EQ(bm.mate(0), 4);
+        EXPECT_EQ(bm.mate(2), 5);
+        EXPECT_FALSE(bm.isMatched(6));
+        EXPECT_THROW(bm.mate(6), std::logic_error);
+        EXPECT_THROW(bm.isMatched(7), std::out_of_range);
+        expectValidMatching(g, bm);
+    }
+
+    g.insertEdge(0, 1);
+    g.insertEdge(1, 4);
+    EXPECT_THROW(BipartiteMatching bm(g), std::invalid_argument);
+}
+
+TEST(BipartiteMatchingTest, MatchesMaxFlow)
+{
+    // Random bipartite graphs on left 0..n-1 and right n..2n-1; the matching
+    // size equals the unit-capacity flow from a super source to a super sink
+    unsigned int seed = 23;
+    for (int round = 0; round < 10; round++)
+    {
+        int n = 50 + 20 * round;
+        Graph g(2 * n);
+        DiGraph network(2 * n + 2);
+        for (int v = 0; v < n; v++)
+        {
+            network.insertEdge(2 * n, v);
+            network.insertEdge(n + v, 2 * n + 1);
+        }
+        for (int i = 0; i < 2 * n; i++)
+        {
+            int v = nextRandom(seed, n);
+            int w = n + nextRandom(seed, n);
+            if (!g.getVertices()[v].hasEdgeTo(w))
+            {
+                g.insertEdge(v, w);
+                network.insertEdge(v, w);
+            }
+        }
+
+        BipartiteMatching bm(g);
+        EXPECT_EQ(bm.size(), static_cast<int>(MaxFlow(network, 2 * n, 2 * n + 1).value() + 0.5));
+        EXPECT_EQ(bm.size(), BipartiteMatching(g, false).size());
+        expectValidMatching(g, bm);
+    }
+}
+
+/**
+ * Assignment
+ */
+
+// Smallest total over all injective maps from the shorter side
+static double bruteForceAssignment(const std::vector<std::vector<double>> &cost)
+{
+    int rows = cost.size(), cols = cost[0].size();
+    int n = std::max(rows, cols);
+    std::vector<int> perm(n);
+    for (int i = 0; i < n; i++)
+        perm[i] = i;
+    double best = std::numeric_limits<double>::infinity();
+    do
+    {
+        double sum = 0;
+        for (int i = 0; i < n; i++)
+        {
+            int r = rows >= cols ? perm[i] : i, c = rows >= cols ? i : perm[i];
+            if (r < rows && c < cols)
+                sum += cost[r][c];
+        }
+        best = std::min(best, sum);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+    return best;
+}
+
+TEST(AssignmentTest, SmallMatrix)
+{
+    Assignment a({{4, 1, 3}, {2, 0, 5}, {3, 2, 2}});
+    EXPECT_DOUBLE_EQ(a.cost(), 5);
+    EXPECT_EQ(a.column(0), 1);
+    EXPECT_EQ(a.column(1), 0);
+    EXPECT_EQ(a.column(2), 2);
+    EXPECT_EQ(a.row(1), 0);
+    EXPECT_THROW(a.column(3), std::out_of_range);
+
+    Assignment best({{4, 1, 3}, {2, 0, 5}, {3, 2, 2}}, true);
+    EXPECT_DOUBLE_EQ(best.cost(), 11);
+
+    EXPECT_DOUBLE_EQ(Assignment({}).cost(), 0);
+    EXPECT_THROW(Assignment({{1, 2}, {3}}), std::invalid_argument);
+}
+
+TEST(AssignmentTest, MatchesBruteForce)
+{
+    unsigned int seed = 29;
+    for (std::pair<int, int> shape : {std::make_pair(6, 6), std::make_pair(4, 7), std::make_pair(7, 3)})
+    {
+        for (int round = 0; round < 5; round++)
+        {
+            std::vector<std::vector<double>> cost(shape.first, std::vector<double>(shape.second));
+            for (std::vector<double> &line : cost)
+            {
+                for (double &c : line)
+                {
+                    c = static_cast<int>(nextRandom(seed, 200)) - 50;
+                }
+            }
+
+            Assignment a(cost);
+            EXPECT_DOUBLE_EQ(a.cost(), bruteForceAssignment(cost));
+            std::set<int> columns;
+            int assigned = 0;
+            for (int i = 0; i < shape.first; i++)
+            {
+                if (a.column(i) == -1)
+                    continue;
+                assigned++;
+                EXPECT_TRUE(columns.insert(a.column(i)).second);
+                EXPECT_EQ(a.row(a.column(i)), i);
+            }
+            EXPECT_EQ(assigned, std::min(shape.first, shape.second));
+        }
+    }
+}
+
+/**
+ * Global min cut
+ */
+
+// Smallest cut over all splits of a graph on vertices 0..n-1
+static double bruteForceMinCut(const Graph &g, int n)
+{
+    double best = std::numeric_limits<double>::infinity();
+    for (int mask = 1; mask < (1 << n) - 1; mask++)
+    {
+        double cut = 0;
+        for (int v = 0; v < n; v++)
+            for (const Edge &e : g.adj(v))
+                if ((mask >> v & 1) && !(mask >> e.getTo() & 1))
+                    cut += e.getWeight();
+        best = std::min(best, cut);
+    }
+    return best;
+}
+
+// Check that side() and cutEdges() describe a cut of the reported value
+static void expectConsistentCut(const Graph &g, const GlobalMinCut &mc)
+{
+    std::vector<int> side = mc.side();
+    EXPECT_FALSE(side.empty());
+    EXPECT_LT(side.size(), g.V());
+    double cut = 0;
+    for (const Edge &e : mc.cutEdges())
+    {
+        EXPECT_FALSE(mc.sameSide(e.getFrom(), e.getTo()));
+        cut += e.getWeight();
+    }
+    EXPECT_NEAR(cut, mc.value(), 1e-9);
+}
+
+TEST(GlobalMinCutTest, StoerWagnerExample)
+{
+    // Example graph of the Stoer-Wagner paper, minimum cut 4 around {2, 3, 6, 7}
+    Graph g({0, 1, 2, 3, 4, 5, 6, 7});
+    g.insertEdge(0, 1, 2);
+    g.insertEdge(0, 4, 3);
+    g.insertEdge(1, 2, 3);
+    g.insertEdge(1, 4, 2);
+    g.insertEdge(1, 5, 2);
+    g.insertEdge(2, 3, 4);
+    g.insertEdge(2, 6, 2);
+    g.insertEdge(3, 6, 2);
+    g.insertEdge(3, 7, 2);
+    g.insertEdge(4, 5, 3);
+    g.insertEdge(5, 6, 1);
+    g.insertEdge(6, 7, 3);
+
+    for (GlobalMinCut::Algorithm algorithm : {GlobalMinCut::Algorithm::StoerWagner, GlobalMinCut::Algorithm::KargerStein})
+    {
+        GlobalMinCut mc(g, algorithm, 0, 1);
+        EXPECT_DOUBLE_EQ(mc.value(), 4);
+        EXPECT_EQ(mc.side(), std::vector<int>({2, 3, 6, 7}));
+        EXPECT_TRUE(mc.sameSide(0, 5));
+        EXPECT_THROW(mc.sameSide(0, 8), std::out_of_range);
+        expectConsistentCut(g, mc);
+    }
+    EXPECT_EQ(GlobalMinCut(g, GlobalMinCut::Algorithm::KargerStein).trials(), 9);
+
+    // Disconnected graphs have an empty cut
+    Graph split(4);
+    split.insertEdge({{0, 1}, {2, 3}});
+    GlobalMinCut mc(split);
+    EXPECT_DOUBLE_EQ(mc.value(), 0);
+    EXPECT_EQ(mc.side(), std::vector<int>({2, 3}));
+
+    EXPECT_THROW(GlobalMinCut(Graph(1)), std::invalid_argument);
+}
+
+TEST(GlobalMinCutTest, MatchesBruteForce)
+{
+    unsigned int seed = 31;
+    for (int round = 0; round < 20; round++)
+    {
+        int n = 6 + round % 9;
+        Graph g(n);
+        for (int v = 1; v < n; v++)
+        {
+            int parent = nextRandom(seed, v);
+            g.insertEdge(v, parent, 1 + nextRandom(seed, 5));
+        }
+        for (int i = 0; i < 2 * n; i++)
+        {
+            int v = nextRandom(seed, n);
+            int w = nextRandom(seed, n);
+            double weight = nextRandom(seed, 8) / 2.0;
+            if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+                g.insertEdge(v, w, weight);
+        }
+
+        double expected = bruteForceMinCut(g, n);
+        GlobalMinCut sw(g);
+        EXPECT_DOUBLE_EQ(sw.value(), expected);
+        expectConsistentCut(g, sw);
+
+        GlobalMinCut ks(g, GlobalMinCut::Algorithm::KargerStein, 20, round, true, 4);
+        EXPECT_DOUBLE_EQ(ks.value(), expected);
+        expectConsistentCut(g, ks);
+    }
+}
+
+/**
+ * Biconnectivity
+ */
+
+TEST(BiconnectivityTest, BlocksAndBridges)
+{
+    // Triangle 0-1-2, bridge 2-3, square 3-4-5-6, bridge 6-7, isolated 8
+    Graph g(9);
+    g.insertEdge({{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 3}, {6, 7}, {5, 5}});
+    Biconnectivity bc(g);
+
+    EXPECT_EQ(bc.articulationPoints(), std::vector<int>({2, 3, 6}));
+    EXPECT_TRUE(bc.isArticulationPoint(3));
+    EXPECT_FALSE(bc.isArticulationPoint(4));
+    EXPECT_THROW(bc.isArticulationPoint(9), std::out_of_range);
+
+    std::set<std::pair<int, int>> bridges;
+    for (const Edge &e : bc.bridges())
+        bridges.insert({std::min(e.getFrom(), e.getTo()), std::max(e.getFrom(), e.getTo())});
+    std::set<std::pair<int, int>> expected = {{2, 3}, {6, 7}};
+    EXPECT_EQ(bridges, expected);
+
+    std::set<std::set<int>> blocks;
+    for (int b = 0; b < bc.blockCount(); b++)
+    {
+        std::vector<int> members = bc.block(b);
+        blocks.insert(std::set<int>(members.begin(), members.end()));
+    }
+    EXPECT_EQ(blocks, std::set<std::set<int>>({{0, 1, 2}, {2, 3}, {3, 4, 5, 6}, {6, 7}, {8}}));
+    EXPECT_THROW(bc.block(5), std::out_of_range);
+
+    // Five blocks and three articulation points, forming a path and a singleton
+    Graph tree = bc.blockCutTree();
+    EXPECT_EQ(tree.V(), 8u);
+    EXPECT_EQ(std::distance(tree.adj(5).begin(), tree.adj(5).end()), 2);
+    int edges = 0;
+    for (const Node &node : tree.getVertices())
+        edges += std::distance(node.edges().begin(), node.edges().end());
+    EXPECT_EQ(edges, 2 * 6);
+}
+
+TEST(BiconnectivityTest, DeepPathAndRemovalCheck)
+{
+    // A path of 200000 vertices would overflow a recursive search
+    int n = 200000;
+    Graph path(n);
+    for (int v = 0; v + 1 < n; v++)
+        path.insertEdge(v, v + 1);
+    Biconnectivity deep(path);
+    EXPECT_EQ(static_cast<int>(deep.articulationPoints().size()), n - 2);
+    EXPECT_EQ(static_cast<int>(deep.bridges().size()), n - 1);
+    EXPECT_EQ(deep.blockCount(), n - 1);
+
+    // On random sparse graphs a vertex is an articulation point exactly when
+    // removing it increases the number of components
+    unsigned int seed = 37;
+    for (int round = 0; round < 10; round++)
+    {
+        int size = 30;
+        Graph g(size);
+        for (int i = 0; i < 35; i++)
+        {
+            int v = nextRandom(seed, size);
+            int w = nextRandom(seed, size);
+            if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+                g.insertEdge(v, w);
+        }
+        Biconnectivity bc(g);
+        int before = ConnectedComponent(g).count();
+        for (int v = 0; v < size; v++)
+        {
+            Graph removed(g);
+            removed.eraseVertex(v);
+            EXPECT_EQ(bc.isArticulationPoint(v), ConnectedComponent(removed).count() > before);
+        }
+    }
+}
+
+/**
+ * Graph coloring
+ */
+
+static const GraphColoring::Ordering COLOR_ORDERINGS[] = {
+    GraphColoring::Ordering::Natural, GraphColoring::Ordering::LargestFirst, GraphColoring::Ordering::SmallestLast};
+
+// Check that adjacent vertices differ and that the classes cover the graph
+static void expectProperColoring(const Graph &g, const GraphColoring &gc)
+{
+    for (const Node &node : g.getVertices())
+        for (const Edge &e : node.edges())
+            if (e.getTo() != e.getFrom())
+            {
+                EXPECT_NE(gc.color(e.getFrom()), gc.color(e.getTo()));
+            }
+
+    size_t covered = 0;
+    for (const std::vector<int> &members : gc.colorClasses())
+    {
+        EXPECT_FALSE(members.empty());
+        covered += members.size();
+    }
+    EXPECT_EQ(covered, g.V());
+}
+
+TEST(GraphColoringTest, SmallGraphs)
+{
+    EXPECT_EQ(GraphColoring(Graph()).count(), 0);
+
+    // K5 plus a pendant vertex 5 and a self-loop at 5
+    Graph g(6);
+    for (int v = 0; v < 5; v++)
+        for (int w = v + 1; w < 5; w++)
+            g.insertEdge(v, w);
+    g.insertEdge({{4, 5}, {5, 5}});
+    for (GraphColoring::Ordering ordering : COLOR_ORDERINGS)
+    {
+        GraphColoring gc(g, ordering);
+        EXPECT_EQ(gc.count(), 5);
+        EXPECT_EQ(gc.rounds(), 1);
+        expectProperColoring(g, gc);
+    }
+    EXPECT_THROW(GraphColoring(g).color(6), std::out_of_range);
+
+    // Even cycle with chords to a hub: smallest-last needs only 3 colors
+    Graph wheel(9);
+    for (int v = 0; v < 8; v++)
+        wheel.insertEdge({{v, (v + 1) % 8}, {v, 8}});
+    GraphColoring gc(wheel);
+    EXPECT_EQ(gc.count(), 3);
+    expectProperColoring(wheel, gc);
+}
+
+TEST(GraphColoringTest, ParallelSpeculative)
+{
+    // Skewed random graph: hubs plus sparse random edges
+    int n = 4000;
+    Graph g(n);
+    unsigned int seed = 41;
+    for (int i = 0; i < 10 * n; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, i % 4 == 0 ? 40 : n);
+        if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+            g.insertEdge(v, w);
+    }
+    int degeneracy = CoreDecomposition(g).degeneracy();
+
+    for (GraphColoring::Ordering ordering : COLOR_ORDERINGS)
+    {
+        GraphColoring seq(g, ordering);
+        GraphColoring par(g, ordering, true, 4);
+        expectProperColoring(g, seq);
+        expectProperColoring(g, par);
+        EXPECT_GE(par.rounds(), 1);
+        if (ordering == GraphColoring::Ordering::SmallestLast)
+        {
+            EXPECT_LE(seq.count(), degeneracy + 1);
+        }
+
+        // One thread reproduces the sequential greedy coloring
+        GraphColoring single(g, ordering, true, 1);
+        EXPECT_EQ(single.colors(), seq.colors());
+        EXPECT_EQ(single.rounds(), 1);
+    }
+}
+
+/**
+ * Reachability index
+ */
+
+// Reachability between all pairs by breadth-first search from every vertex
+static std::map<int, std::set<int>> bruteForceReachability(const DiGraph &g)
+{
+    std::map<int, std::set<int>> reach;
+    for (const Node &node : g.getVertices())
+    {
+        std::set<int> &seen = reach[node.getId()];
+        std::vector<int> queue(1, node.getId());
+        seen.insert(node.getId());
+        for (size_t head = 0; head < queue.size(); head++)
+            for (const Edge &e : g.adj(queue[head]))
+                if (seen.insert(e.getTo()).second)
+                    queue.push_back(e.getTo());
+    }
+    return reach;
+}
+
+static void expectExactReachability(const DiGraph &g, const ReachabilityIndex &ri)
+{
+    std::map<int, std::set<int>> reach = bruteForceReachability(g);
+    for (const Node &u : g.getVertices())
+        for (const Node &v : g.getVertices())
+            EXPECT_EQ(ri.reaches(u.getId(), v.getId()), reach[u.getId()].count(v.getId()) == 1)
+                << u.getId() << " -> " << v.getId();
+}
+
+TEST(ReachabilityIndexTest, SmallGraphsAndArguments)
+{
+    EXPECT_EQ(ReachabilityIndex(DiGraph()).components(), 0);
+    EXPECT_THROW(ReachabilityIndex(DiGraph(), 0), std::invalid_argument);
+
+    // Cycle 1 -> 2 -> 3 -> 1 feeding a chain 3 -> 4 -> 5 and a lone vertex
+    DiGraph g;
+    for (int v : {1, 2, 3, 4, 5, 9})
+        g.insertVertex(v);
+    g.insertEdge({{1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 5}});
+    ReachabilityIndex ri(g);
+    EXPECT_EQ(ri.components(), 4);
+    EXPECT_EQ(ri.dimensions(), 3);
+    EXPECT_TRUE(ri.reaches(3, 2));
+    EXPECT_TRUE(ri.reaches(1, 5));
+    EXPECT_FALSE(ri.reaches(5, 1));
+    EXPECT_TRUE(ri.reaches(9, 9));
+    EXPECT_FALSE(ri.reaches(9, 1));
+    expectExactReachability(g, ri);
+    EXPECT_THROW(ri.reaches(1, 6), std::out_of_range);
+    EXPECT_THROW(ri.reaches(6, 1), std::out_of_range);
+}
+
+TEST(ReachabilityIndexTest, RandomGraphsMatchSearch)
+{
+    // Random DAG with edges from smaller to larger ids, then a cyclic graph
+    int n = 300;
+    DiGraph dag;
+    for (int v = 0; v < n; v++)
+        dag.insertVertex(v);
+    unsigned int seed = 46;
+    for (int i = 0; i < 3 * n; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = nextRandom(seed, n);
+        if (v < w && !dag.getVertices()[v].hasEdgeTo(w))
+            dag.insertEdge(v, w);
+    }
+    for (const DiGraph &g : {dag, randomRankGraph(200, 300, 7)})
+    {
+        ReachabilityIndex seq(g, 2, 5);
+        ReachabilityIndex par(g, 4, 5, true, 4);
+        expectExactReachability(g, seq);
+        expectExactReachability(g, par);
+    }
+}
+
+TEST(ReachabilityIndexTest, SaveAndLoad)
+{
+    DiGraph g = randomRankGraph(150, 250, 3);
+    ReachabilityIndex ri(g, 2);
+    std::stringstream stream;
+    ri.save(stream);
+    ReachabilityIndex loaded = ReachabilityIndex::load(stream);
+    EXPECT_EQ(loaded.components(), ri.components());
+    EXPECT_EQ(loaded.dimensions(), 2);
+    expectExactReachability(g, loaded);
+    EXPECT_THROW(loaded.reaches(1, 0), std::out_of_range);
+
+    // Truncated or foreign data is rejected
+    std::string bytes = stream.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+    EXPECT_THROW(ReachabilityIndex::load(truncated), std::invalid_argument);
+    std::stringstream foreign("not an index at all, just text");
+    EXPECT_THROW(ReachabilityIndex::load(foreign), std::invalid_argument);
+
+    // Header counts far beyond the data fail before anything is allocated;
+    // the counts V, n, E and k follow the magic and version
+    uint64_t huge[4] = {INT32_MAX, INT32_MAX, INT32_MAX, 1024};
+    std::string inflated = bytes;
+    inflated.replace(8, sizeof(huge), reinterpret_cast<const char *>(huge), sizeof(huge));
+    std::stringstream oversized(inflated);
+    EXPECT_THROW(ReachabilityIndex::load(oversized), std::invalid_argument);
+    huge[3] = uint64_t(1) << 40;
+    inflated.replace(8, sizeof(huge), reinterpret_cast<const char *>(huge), sizeof(huge));
+    std::stringstream tooManyDimensions(inflated);
+    EXPECT_THROW(ReachabilityIndex::load(tooManyDimensions), std::invalid_argument);
+    EXPECT_THROW(ReachabilityIndex(g, 1025), std::invalid_argument);
+}
+
+/**
+ * Transitive closure
+ */
+
+TEST(TransitiveClosureTest, SmallGraphs)
+{
+    EXPECT_EQ(TransitiveClosure(DiGraph()).components(), 0);
+
+    // Cycle 1 -> 2 -> 3 -> 1 feeding a chain 3 -> 4 -> 5 and a lone vertex
+    DiGraph g;
+    for (int v : {1, 2, 3, 4, 5, 9})
+        g.insertVertex(v);
+    g.insertEdge({{1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 5}});
+    TransitiveClosure tc(g);
+    EXPECT_EQ(tc.components(), 4);
+    EXPECT_TRUE(tc.reaches(2, 1));
+    EXPECT_TRUE(tc.reaches(1, 5));
+    EXPECT_FALSE(tc.reaches(5, 4));
+    EXPECT_TRUE(tc.reaches(9, 9));
+    EXPECT_FALSE(tc.reaches(9, 5));
+    std::vector<int> expected = {1, 2, 3, 4, 5};
+    EXPECT_EQ(tc.reachableFrom(2), expected);
+    expected = {5};
+    EXPECT_EQ(tc.reachableFrom(5), expected);
+    EXPECT_THROW(tc.reaches(1, 6), std::out_of_range);
+    EXPECT_THROW(tc.reachableFrom(0), std::out_of_range);
+
+    // Contiguous ids take the direct lookup path
+    DiGraph chain;
+    for (int v = 0; v < 130; v++)
+        chain.insertVertex(v);
+    for (int v = 0; v + 1 < 130; v++)
+        chain.insertEdge(v, v + 1);
+    TransitiveClosure ctc(chain);
+    EXPECT_TRUE(ctc.reaches(0, 129));
+    EXPECT_FALSE(ctc.reaches(129, 0));
+    EXPECT_EQ(ctc.reachableFrom(64).size(), 66u);
+    EXPECT_THROW(ctc.reaches(0, 130), std::out_of_range);
+}
+
+TEST(TransitiveClosureTest, RandomGraphsMatchSearch)
+{
+    for (unsigned int seed : {2u, 9u})
+    {
+        DiGraph g = randomRankGraph(220, 330, seed);
+        std::map<int, std::set<int>> reach = bruteForceReachability(g);
+        TransitiveClosure seq(g);
+        TransitiveClosure par(g, true, 4);
+        EXPECT_EQ(seq.components(), par.components());
+        for (const Node &u : g.getVertices())
+        {
+            std::vector<int> expected(reach[u.getId()].begin(), reach[u.getId()].end());
+            std::vector<int> got = seq.reachableFrom(u.getId());
+            std::sort(got.begin(), got.end());
+            EXPECT_EQ(got, expected);
+            for (const Node &v : g.getVertices())
+                EXPECT_EQ(par.reaches(u.getId(), v.getId()), reach[u.getId()].count(v.getId()) == 1);
+        }
+    }
+}
+
+/**
+ * Distance oracle
+ */
+
+// Distances from every vertex by Bellman-Ford relaxation
+static std::map<std::pair<int, int>, double> bruteForceDistances(const DiGraph &g, bool weighted)
+{
+    std::map<std::pair<int, int>, double> dist;
+    for (const Node &s : g.getVertices())
+    {
+        std::map<int, double> d;
+        d[s.getId()] = 0;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (const Node &v : g.getVertices())
+            {
+                if (!d.count(v.getId()))
+                    continue;
+                for (const Edge &e : g.adj(v.getId()))
+                {
+                    double alt = d[v.getId()] + (weighted ? e.getWeight() : 1);
+                    if (!d.count(e.getTo()) || alt < d[e.getTo()])
+                    {
+                        d[e.getTo()] = alt;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        for (const Node &t : g.getVertices())
+            dist[{s.getId(), t.getId()}] = d.count(t.getId()) ? d[t.getId()] : std::numeric_limits<double>::infinity();
+    }
+    return dist;
+}
+
+static void expectExactDistances(const DiGraph &g, const DistanceOracle &oracle, bool weighted)
+{
+    for (const std::pair<const std::pair<int, int>, double> &entry : bruteForceDistances(g, weighted))
+        EXPECT_DOUBLE_EQ(oracle.distance(entry.first.first, entry.first.second), entry.second)
+            << entry.first.first << " -> " << entry.first.second;
+}
+
+TEST(DistanceOracleTest, SmallGraphsAndArguments)
+{
+    EXPECT_EQ(DistanceOracle(DiGraph()).labelSize(), 0u);
+
+    // Cycle 1 -> 2 -> 3 -> 1 with a shortcut 1 -> 3 and a tail 3 -> 4
+    DiGraph g;
+    for (int v : {1, 2, 3, 4, 9})
+        g.insertVertex(v);
+    g.insertEdge(1, 2, 1);
+    g.insertEdge(2, 3, 1);
+    g.insertEdge(3, 1, 4);
+    g.insertEdge(1, 3, 5);
+    g.insertEdge(3, 4, 2);
+    DistanceOracle hops(g);
+    EXPECT_EQ(hops.distance(1, 3), 1);
+    EXPECT_EQ(hops.distance(3, 2), 2);
+    EXPECT_EQ(hops.distance(9, 9), 0);
+    EXPECT_EQ(hops.distance(4, 1), std::numeric_limits<double>::infinity());
+    DistanceOracle lengths(g, true);
+    EXPECT_EQ(lengths.distance(1, 3), 2);
+    EXPECT_EQ(lengths.distance(3, 2), 5);
+    expectExactDistances(g, hops, false);
+    expectExactDistances(g, lengths, true);
+    EXPECT_THROW(hops.distance(1, 5), std::out_of_range);
+
+    g.insertEdge(4, 9, -1);
+    EXPECT_THROW(DistanceOracle(g, true), std::invalid_argument);
+}
+
+TEST(DistanceOracleTest, RandomGraphsMatchSearch)
+{
+    DiGraph g = randomRankGraph(120, 360, 48);
+    DiGraph weighted;
+    for (const Node &v : g.getVertices())
+        weighted.insertVertex(v.getId());
+    unsigned int seed = 5;
+    for (const Node &v : g.getVertices())
+        for (const Edge &e : g.adj(v.getId()))
+        {
+            weighted.insertEdge(e.getFrom(), e.getTo(), nextRandom(seed, 10));
+        }
+    for (bool useParallel : {false, true})
+    {
+        expectExactDistances(g, DistanceOracle(g, false, useParallel, 4), false);
+        expectExactDistances(weighted, DistanceOracle(weighted, true, useParallel, 4), true);
+    }
+}
+
+TEST(DistanceOracleTest, SaveAndMap)
+{
+    DiGraph g = randomRankGraph(100, 250, 11);
+    DistanceOracle oracle(g);
+    std::string path = "distance-oracle-test.bin";
+    oracle.save(path);
+    DistanceOracle mapped = DistanceOracle::load(path);
+    EXPECT_EQ(mapped.labelSize(), oracle.labelSize());
+    expectExactDistances(g, mapped, false);
+    DistanceOracle copy(mapped);
+    mapped = DistanceOracle::load(path);
+    EXPECT_EQ(copy.distance(0, 10), oracle.distance(0, 10));
+
+    // Truncated, foreign or missing files are rejected
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a label image, only some text to fill the header";
+    }
+    EXPECT_THROW(DistanceOracle::load(path), std::invalid_argument);
+    std::remove(path.c_str());
+    EXPECT_THROW(DistanceOracle::load(path), std::invalid_argument);
+}
+
+/**
+ * Eccentricity
+ */
+
+// Eccentricity of every vertex by a BFS from each
+static std::map<int, int> bruteForceEccentricities(const DiGraph &g)
+{
+    std::map<int, int> ecc;
+    for (const Node &s : g.getVertices())
+    {
+        std::map<int, int> dist;
+        std::vector<int> queue(1, s.getId());
+        dist[s.getId()] = 0;
+        for (size_t head = 0; head < queue.size(); head++)
+            for (const Edge &e : g.adj(queue[head]))
+                if (dist.emplace(e.getTo(), dist[queue[head]] + 1).second)
+                    queue.push_back(e.getTo());
+        ecc[s.getId()] = dist[queue.back()];
+    }
+    return ecc;
+}
+
+static void expectExactEccentricities(const DiGraph &g, const Eccentricity &ecc)
+{
+    std::map<int, int> expected = bruteForceEccentricities(g);
+    int diameter = 0, radius = expected.empty() ? 0 : g.getVertices().size();
+    for (const std::pair<const int, int> &entry : expected)
+    {
+        EXPECT_EQ(ecc.eccentricity(entry.first), entry.second) << entry.first;
+        std::pair<int, int> bounds = ecc.bounds(entry.first);
+        EXPECT_LE(bounds.first, entry.second);
+        EXPECT_GE(bounds.second, entry.second);
+        diameter = std::max(diameter, entry.second);
+        radius = std::min(radius, entry.second);
+    }
+    EXPECT_TRUE(ecc.isExact());
+    EXPECT_EQ(ecc.diameter(), diameter);
+    EXPECT_EQ(ecc.radius(), radius);
+}
+
+TEST(EccentricityTest, SmallGraphs)
+{
+    Eccentricity empty((Graph()));
+    EXPECT_EQ(empty.diameter(), 0);
+    EXPECT_EQ(empty.searches(), 0);
+
+    // Path 0 - 1 - 2 - 3 - 4 with a pendant 5 at vertex 1
+    Graph path(6);
+    path.insertEdge({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {1, 5}});
+    Eccentricity ecc(path);
+    EXPECT_EQ(ecc.diameter(), 4);
+    EXPECT_EQ(ecc.radius(), 2);
+    EXPECT_EQ(ecc.eccentricity(2), 2);
+    EXPECT_EQ(ecc.eccentricity(5), 4);
+    expectExactEccentricities(path, ecc);
+    EXPECT_THROW(ecc.eccentricity(6), std::out_of_range);
+    EXPECT_THROW(ecc.bounds(-1), std::out_of_range);
+
+    // Directed cycle 1 -> 2 -> 3 -> 1 with a tail 3 -> 4
+    DiGraph cycle;
+    for (int v : {1, 2, 3, 4})
+        cycle.insertVertex(v);
+    cycle.insertEdge({{1, 2}, {2, 3}, {3, 1}, {3, 4}});
+    Eccentricity directed(cycle);
+    EXPECT_EQ(directed.eccentricity(1), 3);
+    EXPECT_EQ(directed.eccentricity(4), 0);
+    expectExactEccentricities(cycle, directed);
+}
+
+TEST(EccentricityTest, RandomGraphsMatchSearch)
+{
+    // Sparse undirected graph with several components and long paths
+    int n = 600;
+    Graph g(n);
+    unsigned int seed = 49;
+    for (int v = 1; v < n; v++)
+    {
+        int back = nextRandom(seed, std::min(v, 3));
+        if (v % 150 != 0)
+            g.insertEdge(v, v - 1 - back);
+    }
+    for (int i = 0; i < 40; i++)
+    {
+        int v = nextRandom(seed, n);
+        int w = (v + 1 + nextRandom(seed, 20)) % n;
+        if (v != w && !g.getVertices()[v].hasEdgeTo(w))
+            g.insertEdge(v, w);
+    }
+    Eccentricity seq(g);
+    expectExactEccentricities(g, seq);
+    EXPECT_LT(seq.searches(), n / 4);
+    expectExactEccentricities(g, Eccentricity(g, 0, 0, true, 4));
+
+    DiGraph d = randomRankGraph(200, 320, 13);
+    expectExactEccentricities(d, Eccentricity(d));
+    expectExactEccentricities(d, Eccentricity(d, 0, 0, true, 4));
+}
+
+TEST(EccentricityTest, SampledBounds)
+{
+    Graph g(500);
+    for (int v = 0; v + 1 < 500; v++)
+        g.insertEdge(v, v + 1);
+    g.insertEdge(0, 250);
+    Eccentricity exact(g);
+    Eccentricity sampled(g, 8, 3, true, 4);
+    EXPECT_FALSE(sampled.isExact());
+    EXPECT_LE(sampled.searches(), 9);
+    EXPECT_LE(sampled.diameter(), exact.diameter());
+    EXPECT_GE(sampled.radius(), exact.radius());
+
+    // The sweep from the farthest vertex finds the diameter of a path
+    EXPECT_EQ(sampled.diameter(), exact.diameter());
+    for (int v = 0; v < 500; v += 25)
+    {
+        std::pair<int, int> bounds = sampled.bounds(v);
+        EXPECT_LE(bounds.first, exact.eccentricity(v));
+        EXPECT_GE(bounds.second, exact.eccentricity(v));
+        EXPECT_EQ(sampled.eccentricity(v), exact.eccentricity(v));
+    }
+}
+
+/**
+ * Random walk
+ */
+
+TEST(RandomWalkTest, WalksAndArguments)
+{
+    EXPECT_TRUE(RandomWalk(DiGraph()).walks(3, 5).empty());
+    EXPECT_THROW(RandomWalk(DiGraph(), false, 0, 1), std::invalid_argument);
+
+    // Cycle 10 -> 20 -> 30 -> 10 and an isolated vertex 40
+    DiGraph g;
+    for (int v : {10, 20, 30, 40})
+        g.insertVertex(v);
+    g.insertEdge({{10, 20}, {20, 30}, {30, 10}});
+    RandomWalk rw(g);
+    std::vector<int> walks = rw.walks(2, 4);
+    ASSERT_EQ(walks.size(), 32u);
+    std::vector<int> expected = {0, 1, 2, 0};
+    EXPECT_EQ(std::vector<int>(walks.begin(), walks.begin() + 4), expected);
+    expected = {3, -1, -1, -1};
+    EXPECT_EQ(std::vector<int>(walks.begin() + 12, walks.begin() + 16), expected);
+    EXPECT_EQ(std::vector<int>(walks.begin() + 16, walks.begin() + 20), std::vector<int>(walks.begin(), walks.begin() + 4));
+    EXPECT_THROW(rw.walks(-1, 4), std::invalid_argument);
+    EXPECT_THROW(rw.walks(1, 0), std::invalid_argument);
+
+    g.insertEdge(30, 40, 0);
+    EXPECT_THROW(RandomWalk(g, true), std::invalid_argument);
+}
+
+TEST(RandomWalkTest, WeightedAndSecondOrderBias)
+{
+    // Vertex 0 steps to 1, 2 and 3 with weights 1, 2 and 7
+    DiGraph star;
+    for (int v = 0; v < 4; v++)
+        star.insertVertex(v);
+    star.insertEdge(0, 1, 1);
+    star.insertEdge(0, 2, 2);
+    star.insertEdge(0, 3, 7);
+    std::vector<int> walks = RandomWalk(star, true).walks(20000, 2, 7);
+    std::vector<double> share(4, 0);
+    for (size_t i = 0; i < walks.size(); i += 8)
+        share[walks[i + 1]] += 1.0 / 20000;
+    EXPECT_NEAR(share[1], 0.1, 0.015);
+    EXPECT_NEAR(share[2], 0.2, 0.015);
+    EXPECT_NEAR(share[3], 0.7, 0.015);
+
+    // Triangle 0 - 1 - 2 with a pendant 3 at vertex 1. After 0 -> 1 the
+    // walk returns to 0, moves to 2 (adjacent to 0) or leaves to 3 with
+    // biases 1 / p = 2, 1 and 1 / q = 0.5
+    Graph g(4);
+    g.insertEdge({{0, 1}, {1, 2}, {0, 2}, {1, 3}});
+    walks = RandomWalk(g, false, 0.5, 2).walks(40000, 3, 11, true, 4);
+    std::vector<double> next(4, 0);
+    double total = 0;
+    for (size_t i = 0; i < walks.size(); i += 3)
+        if (walks[i] == 0 && walks[i + 1] == 1)
+        {
+            next[walks[i + 2]]++;
+            total++;
+        }
+    EXPECT_NEAR(next[0] / total, 2 / 3.5, 0.02);
+    EXPECT_NEAR(next[2] / total, 1 / 3.5, 0.02);
+    EXPECT_NEAR(next[3] / total, 0.5 / 3.5, 0.02);
+
+    // With p = q = 4 the biases are 0.25, 1 and 0.25
+    walks = RandomWalk(g, false, 4, 4).walks(40000, 3, 13, true, 4);
+    std::fill(next.begin(), next.end(), 0);
+    total = 0;
+    for (size_t i = 0; i < walks.size(); i += 3)
+    {
+        if (walks[i] == 0 && walks[i + 1] == 1)
+        {
+            next[walks[i + 2]]++;
+            total++;
+        }
+    }
+    EXPECT_NEAR(next[0] / total, 1 / 6.0, 0.02);
+    EXPECT_NEAR(next[2] / total, 4 / 6.0, 0.02);
+    EXPECT_NEAR(next[3] / total, 1 / 6.0, 0.02);
+}
+
+TEST(RandomWalkTest, ThreadsAndFileOutput)
+{
+    DiGraph g = randomRankGraph(300, 900, 50);
+    RandomWalk rw(g, false, 2, 0.5);
+    std::vector<int> seq = rw.walks(3, 12, 9);
+    EXPECT_EQ(rw.walks(3, 12, 9, true, 4), seq);
+    EXPECT_NE(rw.walks(3, 12, 10), seq);
+
+    std::string path = "random-walk-test.txt";
+    rw.writeWalks(path, 3, 12, 9, true, 4);
+    std::ifstream in(path);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(in, line))
+    {
+        std::istringstream tokens(line);
+        int id, k = 0;
+        while (tokens >> id)
+        {
+            EXPECT_EQ(id, g.getVertices()[seq[lines * 12 + k]].getId());
+            k++;
+        }
+        EXPECT_TRUE(k == 12 || seq[lines * 12 + k] == -1);
+        lines++;
+    }
+    EXPECT_EQ(lines, 900u);
+    std::remove(path.c_str());
+}
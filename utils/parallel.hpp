@@ -0,0 +1,149 @@
+/**parallel.hpp
+ *
+ * Minimal std::thread helpers used by the parallel variants of the
+ * graph routines. Work is handed out in dynamically scheduled chunks
+ * so that skewed degree distributions do not stall a single thread.
+ */
+
+#ifndef PARALLEL_FOR
+#define PARALLEL_FOR
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Per-thread accumulator padded to its own cache line
+struct PaddedSum
+{
+    double value;
+    char pad[64 - sizeof(double)];
+};
+
+// Resolve a requested thread count; values below 1 select all hardware threads
+inline int resolveThreads(int numThreads)
+{
+    if (numThreads > 0)
+        return numThreads;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+/*!
+ * @function parallelRun
+ * @abstract Invoke fn(threadId) once on each of numThreads threads and
+ *           wait for all of them. The calling thread runs threadId 0.
+ * @param numThreads Number of threads, below 1 selects all hardware threads
+ * @param fn Callable taking the thread id in [0, numThreads)
+ */
+template <typename Func>
+void parallelRun(int numThreads, Func fn)
+{
+    numThreads = resolveThreads(numThreads);
+    if (numThreads == 1)
+    {
+        fn(0);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back([&fn, t]()
+                             { fn(t); });
+    fn(0);
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+/*!
+ * @function parallelFor
+ * @abstract Invoke fn(i, threadId) for every i in [begin, end). Chunks of
+ *           grain indices are claimed from a shared atomic counter.
+ * @param begin First index
+ * @param end One past the last index
+ * @param fn Callable taking the index and the thread id
+ * @param numThreads Number of threads, below 1 selects all hardware threads
+ * @param grain Number of consecutive indices claimed at a time
+ */
+template <typename Func>
+void parallelFor(size_t begin, size_t end, Func fn, int numThreads = 0, size_t grain = 1024)
+{
+    if (begin >= end)
+        return;
+    grain = std::max<size_t>(grain, 1);
+    numThreads = resolveThreads(numThreads);
+
+    // Do not spawn threads that would have nothing to do
+    size_t chunks = (end - begin + grain - 1) / grain;
+    if (chunks < static_cast<size_t>(numThreads))
+        numThreads = static_cast<int>(chunks);
+
+    std::atomic<size_t> next(begin);
+    parallelRun(numThreads, [&](int t)
+                {
+                    while (true)
+                    {
+                        size_t lo = next.fetch_add(grain);
+                        if (lo >= end)
+                            break;
+                        size_t hi = std::min(end, lo + grain);
+                        for (size_t i = lo; i < hi; i++)
+                            fn(i, t);
+                    } });
+}
+
+// Concatenate per-thread buffers into out and clear them for reuse
+template <typename T>
+void gather(std::vector<std::vector<T>> &local, std::vector<T> &out)
+{
+    out.clear();
+    for (std::vector<T> &buf : local)
+    {
+        out.insert(out.end(), buf.begin(), buf.end());
+        buf.clear();
+    }
+}
+
+/*!
+ * @function parallelSort
+ * @abstract Sort [first, last) by sorting one slice per thread and
+ *           merging the slices pairwise in parallel rounds. Not stable.
+ * @param first Iterator to the first element
+ * @param last Iterator one past the last element
+ * @param comp Strict weak ordering
+ * @param numThreads Number of threads, below 1 selects all hardware threads
+ * @param cutoff Ranges shorter than this are sorted by std::sort directly
+ */
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, Compare comp, int numThreads = 0, size_t cutoff = 1 << 16)
+{
+    size_t n = last - first;
+    numThreads = resolveThreads(numThreads);
+    if (numThreads == 1 || n < cutoff)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds(numThreads + 1);
+    for (int k = 0; k <= numThreads; k++)
+        bounds[k] = n * k / numThreads;
+    parallelRun(numThreads, [&](int t)
+                { std::sort(first + bounds[t], first + bounds[t + 1], comp); });
+
+    for (size_t width = 1; width < static_cast<size_t>(numThreads); width *= 2)
+    {
+        size_t pairs = (numThreads + 2 * width - 1) / (2 * width);
+        parallelFor(0, pairs, [&](size_t i, int)
+                    {
+                        size_t lo = 2 * width * i;
+                        size_t mid = std::min<size_t>(lo + width, numThreads);
+                        size_t hi = std::min<size_t>(lo + 2 * width, numThreads);
+                        std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi], comp); },
+                    numThreads, 1);
+    }
+}
+
+#endif /*PARALLEL_FOR*/
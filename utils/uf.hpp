@@ -8,6 +8,7 @@
 #define UnionFind
 
 #include <algorithm>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 #include <unordered_map>
@@ -59,6 +60,14 @@ private:
     // Connectivity query based on id
     bool isIdConnected(int p, int q) { return connections[rootFromId(p)] == connections[rootFromId(q)]; }
 
+    // Find root id without path compression
+    int peekRootFromId(int id) const
+    {
+        while (id != connections[id])
+            id = connections[id];
+        return id;
+    }
+
 public:
     UF() : toId(std::unordered_map<T, int>()),
            connections(std::vector<int>()),
@@ -155,6 +164,18 @@ public:
 
         return isIdConnected(toId.at(p), toId.at(q));
     }
+
+    // Connectivity query without path compression, safe to run from
+    // several threads as long as none of them connects or inserts
+    bool peekConnected(const T &p, const T &q) const
+    {
+        if (toId.find(p) == toId.end())
+            throw std::out_of_range("First operand not found in connectivity query");
+        if (toId.find(q) == toId.end())
+            throw std::out_of_range("Second operand not found connectivity query");
+
+        return peekRootFromId(toId.at(p)) == peekRootFromId(toId.at(q));
+    }
 };
 
 #endif /*UnionFind*/
\ No newline at end of file